@@ -39,10 +39,13 @@ function loadTests({
       describe(suiteName, () => {
         for (const [exampleName, requireExample] of Object.entries(examples)) {
           it(exampleName, async function () {
-            if (exampleName === "threadsafe-function") {
-              // The ported Node.js suite marshals thousands of values across
-              // threads; every other example keeps the default timeout so a
-              // genuine deadlock still fails fast.
+            if (
+              exampleName === "threadsafe-function" ||
+              exampleName === "stream-channel"
+            ) {
+              // These marshal thousands of values across threads; every other
+              // example keeps the default timeout so a genuine deadlock still
+              // fails fast.
               this.timeout(30_000);
             }
             const test = requireExample();
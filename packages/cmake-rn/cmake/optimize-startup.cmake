@@ -0,0 +1,45 @@
+
+# Links every target smaller and quicker for the dynamic linker to load
+# (`cmake-rn --optimize-startup`): fewer exported symbols to bind, less code
+# to map and fewer, packed, relocations to apply.
+
+# Hides everything but the Node-API registration symbols, which NAPI_MODULE
+# and NAPI_MODULE_INIT declare with default visibility (NAPI_MODULE_EXPORT),
+# and any other symbol an addon declares with default visibility explicitly.
+set(CMAKE_C_VISIBILITY_PRESET hidden)
+set(CMAKE_CXX_VISIBILITY_PRESET hidden)
+set(CMAKE_VISIBILITY_INLINES_HIDDEN ON)
+
+# A section per function and variable, for the linker to drop those unused
+add_compile_options(-ffunction-sections -fdata-sections)
+
+if(ANDROID)
+    add_link_options(
+        LINKER:--gc-sections
+        # Folds functions compiled to identical code, unless their address is
+        # taken (relying on the address-significance tables clang emits)
+        LINKER:--icf=safe
+        # Makes relocated data read-only once loaded. Android's linker binds
+        # every symbol at load time anyway, so "now" costs nothing.
+        LINKER:-z,relro
+        LINKER:-z,now
+    )
+    # RELR packs relative relocations as bitmaps from API level 28 (behind
+    # Android's own tags until 30), and Android's packing compresses the rest
+    # from API level 23.
+    if(ANDROID_PLATFORM_LEVEL GREATER_EQUAL 30)
+        add_link_options(LINKER:--pack-dyn-relocs=android+relr)
+    elseif(ANDROID_PLATFORM_LEVEL GREATER_EQUAL 28)
+        add_link_options(
+            LINKER:--pack-dyn-relocs=android+relr
+            LINKER:--use-android-relr-tags
+        )
+    elseif(ANDROID_PLATFORM_LEVEL GREATER_EQUAL 23)
+        add_link_options(LINKER:--pack-dyn-relocs=android)
+    endif()
+elseif(APPLE)
+    # ld64 folds identical literals and makes relocated data read-only
+    # (__DATA_CONST) on its own, and chained fixups follow from the
+    # deployment target.
+    add_link_options(LINKER:-dead_strip)
+endif()
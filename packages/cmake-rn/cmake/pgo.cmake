@@ -0,0 +1,24 @@
+
+# Builds every target either instrumented, for a training run to record a
+# profile (`cmake-rn --pgo generate`), or optimised using that profile
+# (`cmake-rn --pgo use`).
+
+if(CMAKE_RN_PGO STREQUAL "generate")
+    add_compile_options(-fprofile-generate)
+    add_link_options(-fprofile-generate)
+    # Lets an addon expose a way to write its profile (by calling
+    # __llvm_profile_write_file) from an app that never exits cleanly.
+    add_compile_definitions(CMAKE_RN_PGO_GENERATE)
+elseif(CMAKE_RN_PGO STREQUAL "use")
+    if(NOT EXISTS "${CMAKE_RN_PGO_PROFILE}")
+        message(FATAL_ERROR "No merged profile found at ${CMAKE_RN_PGO_PROFILE}")
+    endif()
+    add_compile_options(
+        "-fprofile-use=${CMAKE_RN_PGO_PROFILE}"
+        # Code the training run never reached has no profile, as expected
+        -Wno-profile-instr-unprofiled
+        -Wno-profile-instr-missing
+    )
+else()
+    message(FATAL_ERROR "Unexpected CMAKE_RN_PGO: '${CMAKE_RN_PGO}'")
+endif()
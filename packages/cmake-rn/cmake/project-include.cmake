@@ -0,0 +1,18 @@
+
+# Included after every project() call of a build configured by cmake-rn (via
+# CMAKE_PROJECT_INCLUDE), to apply the options changing how every target of
+# the project is compiled and linked. Passed this way rather than through
+# CMAKE_<LANG>_FLAGS, which would replace the flags a toolchain file
+# initialises (such as the NDK's).
+
+# Only the top-level project needs the options, as directory options and
+# variables are inherited by subdirectories declaring projects of their own.
+include_guard(GLOBAL)
+
+if(DEFINED CMAKE_RN_PGO)
+    include("${CMAKE_CURRENT_LIST_DIR}/pgo.cmake")
+endif()
+
+if(CMAKE_RN_OPTIMIZE_STARTUP)
+    include("${CMAKE_CURRENT_LIST_DIR}/optimize-startup.cmake")
+endif()
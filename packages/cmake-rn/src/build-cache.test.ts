@@ -0,0 +1,129 @@
+import assert from "node:assert/strict";
+import fs from "node:fs";
+import os from "node:os";
+import path from "node:path";
+import { describe, it, type TestContext } from "node:test";
+
+import {
+  getCacheKey,
+  hashFiles,
+  listSourceFiles,
+  restoreBuildOutputs,
+  storeBuildOutputs,
+} from "./build-cache.js";
+
+function createTempDirectory(context: TestContext) {
+  const tempPath = fs.mkdtempSync(path.join(os.tmpdir(), "build-cache-test-"));
+  context.after(() => fs.rmSync(tempPath, { recursive: true, force: true }));
+  return tempPath;
+}
+
+function writeFiles(rootPath: string, files: Record<string, string>) {
+  for (const [file, content] of Object.entries(files)) {
+    const filePath = path.join(rootPath, file);
+    fs.mkdirSync(path.dirname(filePath), { recursive: true });
+    fs.writeFileSync(filePath, content);
+  }
+}
+
+describe("listSourceFiles", () => {
+  it("leaves out the build directory, prebuilds and hidden directories", (
+    context,
+  ) => {
+    const sourcePath = createTempDirectory(context);
+    writeFiles(sourcePath, {
+      "CMakeLists.txt": "",
+      "src/addon.c": "",
+      "build/aarch64-linux-android-Release/addon.so": "",
+      "out/addon.android.node/arm64-v8a/libaddon.so": "",
+      ".cache/file": "",
+      "node_modules/dependency/index.js": "",
+    });
+
+    assert.deepEqual(
+      listSourceFiles(sourcePath, [path.join(sourcePath, "build")]),
+      ["CMakeLists.txt", "src/addon.c"],
+    );
+  });
+});
+
+describe("hashFiles", () => {
+  it("changes with the contents and paths of files", (context) => {
+    const rootPath = createTempDirectory(context);
+    writeFiles(rootPath, { "a.c": "a", "b.c": "b" });
+    const hash = hashFiles(rootPath, ["a.c", "b.c"]);
+
+    assert.equal(hashFiles(rootPath, ["b.c", "a.c"]), hash);
+    assert.notEqual(hashFiles(rootPath, ["a.c"]), hash);
+    writeFiles(rootPath, { "b.c": "changed" });
+    assert.notEqual(hashFiles(rootPath, ["a.c", "b.c"]), hash);
+  });
+});
+
+describe("getCacheKey", () => {
+  it("is independent of the order of keys", () => {
+    assert.equal(
+      getCacheKey({ triplet: "x", options: { strip: true, target: ["a"] } }),
+      getCacheKey({ options: { target: ["a"], strip: true }, triplet: "x" }),
+    );
+    assert.notEqual(
+      getCacheKey({ triplet: "x", options: { strip: true } }),
+      getCacheKey({ triplet: "x", options: { strip: false } }),
+    );
+  });
+});
+
+describe("storeBuildOutputs and restoreBuildOutputs", () => {
+  it("restores stored outputs into a fresh build directory", async (
+    context,
+  ) => {
+    const tempPath = createTempDirectory(context);
+    const buildPath = path.join(tempPath, "build");
+    const entryPath = path.join(tempPath, "cache", "entry");
+    writeFiles(buildPath, {
+      "triplet/.cmake/api/v1/reply/index-1.json": "{}",
+      "triplet/addon.framework/Versions/A/addon": "binary",
+      "triplet/intermediate.o": "",
+    });
+    fs.symlinkSync(
+      "Versions/A/addon",
+      path.join(buildPath, "triplet/addon.framework/addon"),
+    );
+
+    await storeBuildOutputs(entryPath, buildPath, [
+      "triplet/.cmake/api/v1/reply",
+      "triplet/addon.framework",
+    ]);
+    fs.rmSync(buildPath, { recursive: true });
+    assert(await restoreBuildOutputs(entryPath, buildPath));
+
+    assert(fs.existsSync(path.join(buildPath, "triplet/.cmake/api/v1/reply")));
+    assert.equal(
+      fs.readlinkSync(path.join(buildPath, "triplet/addon.framework/addon")),
+      "Versions/A/addon",
+    );
+    assert(!fs.existsSync(path.join(buildPath, "triplet/intermediate.o")));
+  });
+
+  it("replaces stale outputs", async (context) => {
+    const tempPath = createTempDirectory(context);
+    const buildPath = path.join(tempPath, "build");
+    const entryPath = path.join(tempPath, "entry");
+    writeFiles(buildPath, { "reply/index-1.json": "{}" });
+    await storeBuildOutputs(entryPath, buildPath, ["reply"]);
+    writeFiles(buildPath, { "reply/index-2.json": "{}" });
+
+    assert(await restoreBuildOutputs(entryPath, buildPath));
+    assert.deepEqual(fs.readdirSync(path.join(buildPath, "reply")), [
+      "index-1.json",
+    ]);
+  });
+
+  it("restores nothing without an entry", async (context) => {
+    const tempPath = createTempDirectory(context);
+    assert.equal(
+      await restoreBuildOutputs(path.join(tempPath, "missing"), tempPath),
+      false,
+    );
+  });
+});
@@ -0,0 +1,210 @@
+import assert from "node:assert/strict";
+import cp from "node:child_process";
+import crypto from "node:crypto";
+import fs from "node:fs";
+import path from "node:path";
+
+import * as z from "zod";
+
+/**
+ * Bump this when the layout of an entry or what its key covers changes, to
+ * stop restoring entries stored by older versions.
+ */
+const CACHE_FORMAT_VERSION = 1;
+
+const MANIFEST_FILE_NAME = "manifest.json";
+const OUTPUTS_DIRECTORY_NAME = "outputs";
+
+const Manifest = z.object({ outputs: z.array(z.string()) });
+
+/**
+ * The replies of the CMake File API, which postBuild reads the targets of a
+ * triplet's build and the paths of their artifacts from.
+ */
+export const FILE_API_REPLY_PATH = ".cmake/api/v1/reply";
+
+// Prebuilds emitted by an earlier run, which commonly live among the sources
+const PREBUILD_PATTERN = /\.(android\.node|apple\.node|xcframework)(\/|$)/;
+
+function isInside(parentPath: string, childPath: string) {
+  const relativePath = path.relative(parentPath, childPath);
+  return (
+    relativePath === "" ||
+    (!relativePath.startsWith("..") && !path.isAbsolute(relativePath))
+  );
+}
+
+function walkFiles(directoryPath: string, relativePath = ""): string[] {
+  return fs
+    .readdirSync(path.join(directoryPath, relativePath), {
+      withFileTypes: true,
+    })
+    .flatMap((entry) => {
+      const entryPath = path.posix.join(relativePath, entry.name);
+      if (entry.isDirectory()) {
+        return entry.name === "node_modules" || entry.name.startsWith(".")
+          ? []
+          : walkFiles(directoryPath, entryPath);
+      } else {
+        return entry.isFile() ? [entryPath] : [];
+      }
+    });
+}
+
+/**
+ * List the files of a source directory that a build may read, relative to it.
+ *
+ * Within a Git repository, that's every file that isn't ignored, which keeps
+ * build directories and other generated files out. Elsewhere, every file
+ * outside of `node_modules` and hidden directories.
+ * @param excludePaths Absolute paths of directories to leave out, such as the build directory.
+ */
+export function listSourceFiles(
+  sourcePath: string,
+  excludePaths: string[],
+): string[] {
+  const result = cp.spawnSync(
+    "git",
+    ["ls-files", "-z", "--cached", "--others", "--exclude-standard"],
+    { cwd: sourcePath, encoding: "utf8" },
+  );
+  const files =
+    result.status === 0
+      ? result.stdout.split("\0").filter((file) => file !== "")
+      : walkFiles(sourcePath);
+  return files
+    .filter((file) => {
+      const filePath = path.join(sourcePath, file);
+      return (
+        !PREBUILD_PATTERN.test(file) &&
+        !excludePaths.some((excludePath) => isInside(excludePath, filePath)) &&
+        // Deleted files are still listed by Git until the deletion is staged
+        fs.existsSync(filePath)
+      );
+    })
+    .sort();
+}
+
+/**
+ * Hash the paths and contents of files.
+ * @param relativePaths Paths of files relative to `rootPath`.
+ */
+export function hashFiles(rootPath: string, relativePaths: string[]): string {
+  const hash = crypto.createHash("sha256");
+  for (const relativePath of [...relativePaths].sort()) {
+    hash.update(relativePath.split(path.sep).join(path.posix.sep));
+    hash.update("\0");
+    hash.update(fs.readFileSync(path.join(rootPath, relativePath)));
+    hash.update("\0");
+  }
+  return hash.digest("hex");
+}
+
+function toStableJson(value: unknown): string {
+  if (Array.isArray(value)) {
+    return `[${value.map(toStableJson).join(",")}]`;
+  } else if (value !== null && typeof value === "object") {
+    const entries = Object.entries(value)
+      .filter(([, entryValue]) => entryValue !== undefined)
+      .sort(([a], [b]) => (a < b ? -1 : a > b ? 1 : 0));
+    return `{${entries
+      .map(
+        ([key, entryValue]) =>
+          `${JSON.stringify(key)}:${toStableJson(entryValue)}`,
+      )
+      .join(",")}}`;
+  } else {
+    return JSON.stringify(value) ?? "null";
+  }
+}
+
+/**
+ * Derive the key of a cache entry from everything determining what building
+ * a triplet outputs. Independent of the order of object keys.
+ */
+export function getCacheKey(parts: Record<string, unknown>): string {
+  return crypto
+    .createHash("sha256")
+    .update(toStableJson({ version: CACHE_FORMAT_VERSION, ...parts }))
+    .digest("hex");
+}
+
+export function getCmakeVersion(): string {
+  return cp.execFileSync("cmake", ["--version"], { encoding: "utf8" }).trim();
+}
+
+/**
+ * Copy outputs of a build into a cache entry.
+ *
+ * The entry is assembled next to its final location and renamed into place,
+ * so concurrent runs storing the same entry never restore a partial one.
+ * @param outputs Paths of files or directories, relative to `buildPath`.
+ */
+export async function storeBuildOutputs(
+  entryPath: string,
+  buildPath: string,
+  outputs: string[],
+) {
+  const stagingPath = `${entryPath}.${process.pid}.tmp`;
+  await fs.promises.rm(stagingPath, { recursive: true, force: true });
+  await fs.promises.mkdir(stagingPath, { recursive: true });
+  for (const output of outputs) {
+    const outputPath = path.resolve(buildPath, output);
+    assert(
+      isInside(buildPath, outputPath),
+      `Expected output ${output} to be inside the build directory`,
+    );
+    await fs.promises.cp(
+      outputPath,
+      path.join(stagingPath, OUTPUTS_DIRECTORY_NAME, output),
+      { recursive: true, verbatimSymlinks: true },
+    );
+  }
+  await fs.promises.writeFile(
+    path.join(stagingPath, MANIFEST_FILE_NAME),
+    JSON.stringify({ outputs } satisfies z.infer<typeof Manifest>, null, 2),
+  );
+  try {
+    await fs.promises.rename(stagingPath, entryPath);
+  } catch (error) {
+    await fs.promises.rm(stagingPath, { recursive: true, force: true });
+    // Another run stored the same entry in the meantime
+    if (!fs.existsSync(path.join(entryPath, MANIFEST_FILE_NAME))) {
+      throw error;
+    }
+  }
+}
+
+/**
+ * Copy the outputs stored in a cache entry back into a build directory,
+ * replacing any already there.
+ * @returns False if there is no such entry.
+ */
+export async function restoreBuildOutputs(
+  entryPath: string,
+  buildPath: string,
+): Promise<boolean> {
+  const manifestPath = path.join(entryPath, MANIFEST_FILE_NAME);
+  if (!fs.existsSync(manifestPath)) {
+    return false;
+  }
+  const { outputs } = Manifest.parse(
+    JSON.parse(await fs.promises.readFile(manifestPath, "utf8")),
+  );
+  for (const output of outputs) {
+    const outputPath = path.resolve(buildPath, output);
+    assert(
+      isInside(buildPath, outputPath),
+      `Expected output ${output} to be inside the build directory`,
+    );
+    // Replacing rather than merging, as a stale reply of the File API left
+    // behind would otherwise be read as the current one.
+    await fs.promises.rm(outputPath, { recursive: true, force: true });
+    await fs.promises.cp(
+      path.join(entryPath, OUTPUTS_DIRECTORY_NAME, output),
+      outputPath,
+      { recursive: true, verbatimSymlinks: true },
+    );
+  }
+  return true;
+}
@@ -23,7 +23,23 @@ import {
 } from "./platforms.js";
 import { Platform } from "./platforms/types.js";
 import { getCcachePath } from "./ccache.js";
+import { PGO_MODES, findProfiles, getPlatformProfilePath } from "./pgo.js";
+import {
+  getCacheKey,
+  getCmakeVersion,
+  hashFiles,
+  listSourceFiles,
+  restoreBuildOutputs,
+  storeBuildOutputs,
+} from "./build-cache.js";
 import { createOutputPathResolver, expandTemplate } from "./output-path.js";
+import { weakNodeApiPath } from "weak-node-api";
+import {
+  formatStartupReport,
+  readStartupReport,
+  writeStartupReport,
+  type StartupReport,
+} from "./startup.js";
 
 const verboseOption = new Option(
   "--verbose",
@@ -119,6 +135,21 @@ const noWeakNodeApiLinkageOption = new Option(
   "Don't pass the path of the weak-node-api library from react-native-node-api",
 );
 
+const weakNodeApiStaticOption = new Option(
+  "--weak-node-api-static",
+  "Link weak-node-api's Node-API trampolines into each addon instead of calling into its shared library (needs `find_package(weak-node-api)`; pair with `-D CMAKE_INTERPROCEDURAL_OPTIMIZATION=ON` to inline them)",
+).default(false);
+
+const pgoOption = new Option(
+  "--pgo <mode>",
+  "Build for profile-guided optimization: 'generate' builds instrumented binaries, recording profiles when run, and 'use' optimizes binaries using the profiles found in --pgo-profile",
+).choices(PGO_MODES);
+
+const pgoProfileOption = new Option(
+  "--pgo-profile <path>",
+  "Specify the directory of the profiles (.profraw or .profdata files) recorded by training runs of a '--pgo generate' build, in a subdirectory per platform (e.g. 'android' and 'apple')",
+).default("{source}/pgo");
+
 const cmakeJsOption = new Option(
   "--cmake-js",
   "Define CMAKE_JS_* variables used for compatibility with cmake-js",
@@ -129,6 +160,21 @@ const ccachePathOption = new Option(
   "Specify the path to the ccache executable",
 ).default(getCcachePath());
 
+const optimizeStartupOption = new Option(
+  "--optimize-startup",
+  "Link binaries which are smaller and quicker to load: drop unused code, fold identical code, hide every symbol but the Node-API registration ones and pack relocations (where supported by the platform)",
+).default(false);
+
+const startupReportOption = new Option(
+  "--startup-report",
+  "Report the size, exported symbols and relocations of the binaries built, next to those of the previous reported build (e.g. one without --optimize-startup)",
+).default(false);
+
+const buildCacheOption = new Option(
+  "--build-cache <path>",
+  "Specify a directory to cache the outputs of building triplets in, keyed on the sources, toolchain and options. Triplets found in it are restored instead of configured and built again",
+).env("CMAKE_RN_BUILD_CACHE");
+
 const concurrencyOption = new Option(
   "--concurrency <limit>",
   "Limit the number of concurrent tasks",
@@ -159,8 +205,14 @@ let program = new Command("cmake-rn")
   .addOption(stripOption)
   .addOption(noAutoLinkOption)
   .addOption(noWeakNodeApiLinkageOption)
+  .addOption(weakNodeApiStaticOption)
+  .addOption(pgoOption)
+  .addOption(pgoProfileOption)
+  .addOption(optimizeStartupOption)
+  .addOption(startupReportOption)
   .addOption(cmakeJsOption)
   .addOption(ccachePathOption)
+  .addOption(buildCacheOption)
   .addOption(concurrencyOption);
 
 for (const platform of platforms) {
@@ -181,6 +233,10 @@ program = program.action(
     // Note: {targetSourceDir} is deliberately left unexpanded here, as it is
     // only known per target, once the CMake File API has been read.
     baseOptions.out = expandTemplate(baseOptions.out, baseOptions);
+    baseOptions.pgoProfile = path.resolve(
+      process.cwd(),
+      expandTemplate(baseOptions.pgoProfile, baseOptions),
+    );
     const {
       verbose,
       clean,
@@ -188,6 +244,10 @@ program = program.action(
       out,
       build: buildPath,
       ccachePath,
+      pgo,
+      pgoProfile,
+      buildCache,
+      startupReport,
     } = baseOptions;
 
     assertFixable(
@@ -278,68 +338,121 @@ program = program.action(
       };
     });
 
+    // Every platform collects and merges the profiles of its own toolchain
+    const platformProfilePaths = [
+      ...new Set(tripletContexts.map(({ platform }) => platform.id)),
+    ].map((platformId) => getPlatformProfilePath(pgoProfile, platformId));
+    if (pgo === "generate") {
+      console.log(
+        `🧪 Building instrumented binaries, collect their profiles into ${platformProfilePaths.map((profilePath) => chalk.dim(profilePath)).join(", ")}`,
+      );
+    } else if (pgo === "use") {
+      for (const profilePath of platformProfilePaths) {
+        assertFixable(
+          findProfiles(profilePath).length > 0,
+          `No profiles found in ${chalk.dim(profilePath)}`,
+          {
+            instructions: `Build with --pgo generate, run a training workload using the instrumented binaries of the platform and copy the .profraw files it writes into the directory (or specify its parent using --pgo-profile)`,
+          },
+        );
+      }
+      console.log(
+        `📈 Optimizing using profiles in ${platformProfilePaths.map((profilePath) => chalk.dim(profilePath)).join(", ")}`,
+      );
+    }
+
+    // Restore the triplets found in the build cache, leaving the rest to build
+    const cacheEntryPaths = buildCache
+      ? await getCacheEntryPaths(buildCache, tripletContexts, baseOptions)
+      : new Map<string, string>();
+    const restoredTriplets = new Set<string>();
+    for (const [triplet, entryPath] of cacheEntryPaths) {
+      if (await restoreBuildOutputs(entryPath, buildPath)) {
+        restoredTriplets.add(triplet);
+      }
+    }
+    if (restoredTriplets.size > 0) {
+      console.log(
+        `♻️ Restored from the build cache: ${chalk.dim([...restoredTriplets].join(", "))}`,
+      );
+    }
+    const builtTripletContexts = tripletContexts.filter(
+      ({ triplet }) => !restoredTriplets.has(triplet),
+    );
+
     // Configure every triplet project
     const tripletsSummary = chalk.dim(
-      `(${getTripletsSummary(tripletContexts)})`,
+      `(${getTripletsSummary(builtTripletContexts)})`,
     );
 
     // Perform configure steps for each platform in sequence
-    await oraPromise(
-      Promise.all(
-        platforms.map(async (platform) => {
-          const relevantTriplets = tripletContexts.filter(({ triplet }) =>
-            platformHasTriplet(platform, triplet),
-          );
-          if (relevantTriplets.length > 0) {
-            platform.assertValidTriplets(
-              relevantTriplets.map(({ triplet }) => triplet),
-            );
-            await platform.configure(
-              relevantTriplets,
-              baseOptions,
-              (command, args, cwd) =>
-                limit(() =>
-                  spawn(command, args, {
-                    outputMode: verbose ? "inherit" : "buffered",
-                    outputPrefix: verbose
-                      ? chalk.dim(`[${platform.name}] `)
-                      : undefined,
-                    cwd,
-                  }),
-                ),
+    if (builtTripletContexts.length > 0) {
+      await oraPromise(
+        Promise.all(
+          platforms.map(async (platform) => {
+            const relevantTriplets = builtTripletContexts.filter(
+              ({ triplet }) => platformHasTriplet(platform, triplet),
             );
-          }
-        }),
-      ),
-      {
-        text: `Configuring projects ${tripletsSummary}`,
-        isSilent: baseOptions.verbose,
-        successText: `Configured projects ${tripletsSummary}`,
-        failText: ({ message }) => `Failed to configure projects: ${message}`,
-      },
-    );
+            if (relevantTriplets.length > 0) {
+              platform.assertValidTriplets(
+                relevantTriplets.map(({ triplet }) => triplet),
+              );
+              await platform.configure(
+                relevantTriplets,
+                baseOptions,
+                (command, args, cwd) =>
+                  limit(() =>
+                    spawn(command, args, {
+                      outputMode: verbose ? "inherit" : "buffered",
+                      outputPrefix: verbose
+                        ? chalk.dim(`[${platform.name}] `)
+                        : undefined,
+                      cwd,
+                    }),
+                  ),
+              );
+            }
+          }),
+        ),
+        {
+          text: `Configuring projects ${tripletsSummary}`,
+          isSilent: baseOptions.verbose,
+          successText: `Configured projects ${tripletsSummary}`,
+          failText: ({ message }) =>
+            `Failed to configure projects: ${message}`,
+        },
+      );
 
-    // Build every triplet project
-    await oraPromise(
-      Promise.all(
-        tripletContexts.map(async ({ platform, ...context }) => {
-          // TODO: Consider if this is still important 😬
-          // // Delete any stale build artifacts before building
-          // // This is important, since we might rename the output files
-          // await fs.promises.rm(context.outputPath, {
-          //   recursive: true,
-          //   force: true,
-          // });
-          await platform.build(context, baseOptions);
-        }),
-      ),
-      {
-        text: "Building projects",
-        isSilent: baseOptions.verbose,
-        successText: "Built projects",
-        failText: ({ message }) => `Failed to build projects: ${message}`,
-      },
-    );
+      // Build every triplet project
+      await oraPromise(
+        Promise.all(
+          builtTripletContexts.map(async ({ platform, ...context }) => {
+            // TODO: Consider if this is still important 😬
+            // // Delete any stale build artifacts before building
+            // // This is important, since we might rename the output files
+            // await fs.promises.rm(context.outputPath, {
+            //   recursive: true,
+            //   force: true,
+            // });
+            await platform.build(context, baseOptions);
+            const entryPath = cacheEntryPaths.get(context.triplet);
+            if (entryPath) {
+              await storeBuildOutputs(
+                entryPath,
+                buildPath,
+                await platform.getBuildOutputs(context.triplet, baseOptions),
+              );
+            }
+          }),
+        ),
+        {
+          text: "Building projects",
+          isSilent: baseOptions.verbose,
+          successText: "Built projects",
+          failText: ({ message }) => `Failed to build projects: ${message}`,
+        },
+      );
+    }
 
     // Perform post-build steps for each platform in sequence
     for (const platform of platforms) {
@@ -355,9 +468,105 @@ program = program.action(
         baseOptions,
       );
     }
+
+    if (startupReport) {
+      const reportPath = path.join(buildPath, "startup-report.json");
+      const previousReport = readStartupReport(reportPath);
+      const report: StartupReport = {};
+      for (const { triplet, platform } of tripletContexts) {
+        const stats = await platform.readBinaryStats(triplet, baseOptions);
+        for (const [target, targetStats] of Object.entries(stats)) {
+          report[`${triplet} ${target}`] = targetStats;
+        }
+      }
+      console.log(formatStartupReport(previousReport, report));
+      writeStartupReport(reportPath, { ...previousReport, ...report });
+    }
   }),
 );
 
+/**
+ * Options which don't change the outputs of building a triplet, and so are
+ * left out of its build cache key.
+ */
+const UNCACHED_OPTIONS = [
+  "verbose",
+  "source",
+  "build",
+  "out",
+  "clean",
+  "ccachePath",
+  "buildCache",
+  "startupReport",
+  "pgoProfile",
+  "concurrency",
+  ...platforms.map(({ id }) => id),
+];
+
+const packageJsonPaths = [
+  path.resolve(import.meta.dirname, "..", "package.json"),
+  path.join(weakNodeApiPath, "package.json"),
+];
+
+/**
+ * Derive the entry of every triplet in the build cache from its sources,
+ * toolchain and options.
+ *
+ * Sources outside of the source directory (e.g. added via add_subdirectory
+ * with a relative path) are not covered, other than weak-node-api and Node-API
+ * headers, which are covered by the versions of the packages providing them.
+ */
+async function getCacheEntryPaths(
+  buildCache: string,
+  tripletContexts: { triplet: string; platform: Platform }[],
+  options: Parameters<Platform["build"]>[1],
+) {
+  const { source, build, pgo, pgoProfile } = options;
+  const commonParts = {
+    sources: hashFiles(source, listSourceFiles(source, [build])),
+    cmake: getCmakeVersion(),
+    packages: packageJsonPaths.map((packageJsonPath) =>
+      fs.readFileSync(packageJsonPath, "utf-8"),
+    ),
+    options: Object.fromEntries(
+      Object.entries(options).filter(
+        ([name]) => !UNCACHED_OPTIONS.includes(name),
+      ),
+    ),
+  };
+  const toolchainIds = new Map<Platform, string>();
+  // The platform's profiles steer the optimization of its triplets
+  const profileHashes = new Map<Platform, string | undefined>();
+  const entryPaths = new Map<string, string>();
+  for (const { triplet, platform } of tripletContexts) {
+    if (!toolchainIds.has(platform)) {
+      toolchainIds.set(platform, await platform.getToolchainId(options));
+    }
+    if (!profileHashes.has(platform)) {
+      const profilePath = getPlatformProfilePath(pgoProfile, platform.id);
+      profileHashes.set(
+        platform,
+        pgo === "use"
+          ? hashFiles(
+              profilePath,
+              findProfiles(profilePath).map((profile) =>
+                path.relative(profilePath, profile),
+              ),
+            )
+          : undefined,
+      );
+    }
+    const key = getCacheKey({
+      ...commonParts,
+      triplet,
+      toolchain: toolchainIds.get(platform),
+      profiles: profileHashes.get(platform),
+    });
+    entryPaths.set(triplet, path.resolve(buildCache, key));
+  }
+  return entryPaths;
+}
+
 function getTripletsSummary(
   tripletContexts: { triplet: string; platform: Platform }[],
 ) {
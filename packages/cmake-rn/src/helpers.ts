@@ -1,5 +1,17 @@
 import path from "node:path";
 
+/**
+ * Included after every project() call (via CMAKE_PROJECT_INCLUDE), applying
+ * the options that change how every target is compiled and linked, such as
+ * --pgo and --optimize-startup.
+ */
+export const projectIncludePath = path.resolve(
+  import.meta.dirname,
+  "..",
+  "cmake",
+  "project-include.cmake",
+);
+
 /**
  * The name of the emitted prebuild is derived from the artifact on disk (i.e.
  * the target's OUTPUT_NAME) rather than the CMake target name.
@@ -0,0 +1,64 @@
+import assert from "node:assert/strict";
+import fs from "node:fs";
+import os from "node:os";
+import path from "node:path";
+import { describe, it } from "node:test";
+
+import {
+  findProfiles,
+  getPgoVariables,
+  getPlatformProfilePath,
+} from "./pgo.js";
+import { projectIncludePath } from "./helpers.js";
+
+describe("findProfiles", () => {
+  it("finds raw and merged profiles", (context) => {
+    const profilePath = fs.mkdtempSync(path.join(os.tmpdir(), "pgo-test-"));
+    context.after(() => fs.rmSync(profilePath, { recursive: true }));
+    for (const name of ["b.profraw", "a.profdata", "notes.txt"]) {
+      fs.writeFileSync(path.join(profilePath, name), "");
+    }
+    fs.mkdirSync(path.join(profilePath, "nested.profraw"));
+
+    assert.deepEqual(findProfiles(profilePath), [
+      path.join(profilePath, "a.profdata"),
+      path.join(profilePath, "b.profraw"),
+    ]);
+  });
+
+  it("finds nothing in a missing directory", () => {
+    assert.deepEqual(
+      findProfiles(path.join(os.tmpdir(), "pgo-test-missing")),
+      [],
+    );
+  });
+});
+
+describe("getPlatformProfilePath", () => {
+  it("keeps each platform's profiles apart", () => {
+    const android = getPlatformProfilePath("/source/pgo", "android");
+    const apple = getPlatformProfilePath("/source/pgo", "apple");
+    assert.equal(android, path.join("/source/pgo", "android"));
+    assert.equal(apple, path.join("/source/pgo", "apple"));
+  });
+});
+
+describe("getPgoVariables", () => {
+  it("includes cmake-rn's script into the project", () => {
+    const variables = getPgoVariables("generate");
+    assert.equal(variables.CMAKE_PROJECT_INCLUDE, projectIncludePath);
+    assert.equal(variables.CMAKE_RN_PGO, "generate");
+    assert.equal(variables.CMAKE_RN_PGO_PROFILE, undefined);
+    assert(fs.existsSync(projectIncludePath));
+  });
+
+  it("passes the merged profile when using it", () => {
+    const variables = getPgoVariables("use", "/build/android.profdata");
+    assert.equal(variables.CMAKE_RN_PGO, "use");
+    assert.equal(variables.CMAKE_RN_PGO_PROFILE, "/build/android.profdata");
+  });
+
+  it("requires a merged profile to use", () => {
+    assert.throws(() => getPgoVariables("use"), /Expected a merged profile/);
+  });
+});
@@ -0,0 +1,86 @@
+import path from "node:path";
+import fs from "node:fs";
+
+import type { Spawn } from "./platforms/types.js";
+import { toCmakePath } from "./weak-node-api.js";
+import { projectIncludePath } from "./helpers.js";
+
+export const PGO_MODES = ["generate", "use"] as const;
+export type PgoMode = (typeof PGO_MODES)[number];
+
+/**
+ * Find the profiles recorded by training runs of an instrumented build
+ * (.profraw files) and any merged already (.profdata files) in a directory.
+ */
+export function findProfiles(profilePath: string): string[] {
+  if (!fs.existsSync(profilePath)) {
+    return [];
+  }
+  return fs
+    .readdirSync(profilePath, { withFileTypes: true })
+    .filter(
+      (entry) =>
+        entry.isFile() &&
+        (entry.name.endsWith(".profraw") || entry.name.endsWith(".profdata")),
+    )
+    .map((entry) => path.join(profilePath, entry.name))
+    .sort();
+}
+
+/**
+ * The directory holding a platform's profiles within the profile directory.
+ *
+ * Raw profiles are specific to the LLVM version that recorded them, so the
+ * training runs of each platform's instrumented binaries are collected, and
+ * merged, apart.
+ */
+export function getPlatformProfilePath(
+  profilePath: string,
+  platformId: string,
+): string {
+  return path.join(profilePath, platformId);
+}
+
+/**
+ * Merge the profiles found in a directory into the single, indexed profile
+ * the compiler reads.
+ *
+ * The format of a raw profile is specific to the version of LLVM that
+ * instrumented the build, so every platform merges using the llvm-profdata
+ * of its own toolchain.
+ * @param llvmProfdata The command (and any leading arguments) running llvm-profdata.
+ */
+export async function mergeProfiles(
+  profilePath: string,
+  outputPath: string,
+  llvmProfdata: [string, ...string[]],
+  spawn: Spawn,
+) {
+  const profiles = findProfiles(profilePath);
+  if (profiles.length === 0) {
+    throw new Error(`Found no profiles to merge in ${profilePath}`);
+  }
+  await fs.promises.mkdir(path.dirname(outputPath), { recursive: true });
+  const [command, ...args] = llvmProfdata;
+  await spawn(command, [...args, "merge", "-o", outputPath, ...profiles]);
+}
+
+/**
+ * CMake cache variables making a build instrumented ("generate") or optimised
+ * using a profile merged by {@link mergeProfiles} ("use").
+ */
+export function getPgoVariables(
+  mode: PgoMode,
+  profileDataPath?: string,
+): Record<string, string> {
+  if (mode === "use" && !profileDataPath) {
+    throw new Error("Expected a merged profile to build using");
+  }
+  return {
+    CMAKE_PROJECT_INCLUDE: toCmakePath(projectIncludePath),
+    CMAKE_RN_PGO: mode,
+    ...(mode === "use" && profileDataPath
+      ? { CMAKE_RN_PGO_PROFILE: toCmakePath(profileDataPath) }
+      : {}),
+  };
+}
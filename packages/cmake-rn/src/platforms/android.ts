@@ -1,6 +1,8 @@
 import assert from "node:assert/strict";
+import cp from "node:child_process";
 import fs from "node:fs";
 import path from "node:path";
+import { promisify } from "node:util";
 
 import {
   Option,
@@ -19,6 +21,15 @@ import {
   getCmakeJSVariables,
   getWeakNodeApiVariables,
 } from "../weak-node-api.js";
+import {
+  getPgoVariables,
+  getPlatformProfilePath,
+  mergeProfiles,
+} from "../pgo.js";
+import { FILE_API_REPLY_PATH } from "../build-cache.js";
+import { getOptimizeStartupVariables, parseReadelfStats } from "../startup.js";
+
+const execFile = promisify(cp.execFile);
 
 // This should match https://github.com/react-native-community/template/blob/main/template/android/build.gradle#L7
 const DEFAULT_NDK_VERSION = "27.1.12297006";
@@ -91,6 +102,23 @@ function getNdkLlvmBinPath(ndkPath: string) {
   return path.join(prebuiltPath, platforms[0], "bin");
 }
 
+async function readSharedLibraryTargets(
+  buildPath: string,
+  configuration: string,
+  target: string[],
+) {
+  const targets = await cmakeFileApi.readCurrentTargetsDeep(
+    buildPath,
+    configuration,
+    "2.0",
+  );
+  return targets.filter(
+    ({ type, name }) =>
+      type === "SHARED_LIBRARY" &&
+      (target.length === 0 || target.includes(name)),
+  );
+}
+
 const DEFAULT_ANDROID_STL = "c++_shared";
 
 /**
@@ -183,13 +211,28 @@ export const platform: Platform<Triplet[], AndroidOpts> = {
       define,
       build,
       weakNodeApiLinkage,
+      weakNodeApiStatic,
       cmakeJs,
       ccachePath,
+      pgo,
+      pgoProfile,
+      optimizeStartup,
     },
+    spawn,
   ) {
     const ndkPath = getNdkPath(ndkVersion);
     const toolchainPath = getNdkToolchainPath(ndkPath);
 
+    const profileDataPath = path.join(build, "android.profdata");
+    if (pgo === "use") {
+      await mergeProfiles(
+        getPlatformProfilePath(pgoProfile, "android"),
+        profileDataPath,
+        [path.join(getNdkLlvmBinPath(ndkPath), "llvm-profdata")],
+        spawn,
+      );
+    }
+
     const commonDefinitions = buildCommonDefinitions({
       configuration,
       ndkPath,
@@ -220,8 +263,16 @@ export const platform: Platform<Triplet[], AndroidOpts> = {
           "--toolchain",
           toolchainPath,
           ...toDefineArguments([
-            ...(weakNodeApiLinkage ? [getWeakNodeApiVariables(triplet)] : []),
+            ...(weakNodeApiLinkage
+              ? [
+                  getWeakNodeApiVariables(triplet, {
+                    linkStatic: weakNodeApiStatic,
+                  }),
+                ]
+              : []),
             ...(cmakeJs ? [getCmakeJSVariables(triplet)] : []),
+            ...(pgo ? [getPgoVariables(pgo, profileDataPath)] : []),
+            ...(optimizeStartup ? [getOptimizeStartupVariables()] : []),
             ...commonDefinitions,
             {
               // "CPACK_SYSTEM_NAME": `Android-${architecture}`,
@@ -244,6 +295,62 @@ export const platform: Platform<Triplet[], AndroidOpts> = {
     const { ANDROID_HOME } = process.env;
     return typeof ANDROID_HOME === "string" && fs.existsSync(ANDROID_HOME);
   },
+  getToolchainId({ ndkVersion }) {
+    // Records the revision of the NDK, which its directory name may not
+    return fs.readFileSync(
+      path.join(getNdkPath(ndkVersion), "source.properties"),
+      "utf-8",
+    );
+  },
+  async getBuildOutputs(triplet, { build, configuration, target }) {
+    const buildPath = getBuildPath(build, triplet, configuration);
+    const sharedLibraries = await readSharedLibraryTargets(
+      buildPath,
+      configuration,
+      target,
+    );
+    const outputs = sharedLibraries.flatMap(({ artifacts = [] }) =>
+      artifacts.map(({ path: artifactPath }) => artifactPath),
+    );
+    return [FILE_API_REPLY_PATH, ...outputs].map((output) =>
+      path.relative(build, path.join(buildPath, output)),
+    );
+  },
+  async readBinaryStats(
+    triplet,
+    { build, configuration, target, ndkVersion },
+  ) {
+    const buildPath = getBuildPath(build, triplet, configuration);
+    const readelfPath = path.join(
+      getNdkLlvmBinPath(getNdkPath(ndkVersion)),
+      "llvm-readelf",
+    );
+    const sharedLibraries = await readSharedLibraryTargets(
+      buildPath,
+      configuration,
+      target,
+    );
+    return Object.fromEntries(
+      await Promise.all(
+        sharedLibraries.map(async ({ name, artifacts }) => {
+          assert(
+            artifacts && artifacts.length === 1,
+            "Expected exactly one artifact",
+          );
+          const libraryPath = path.join(buildPath, artifacts[0].path);
+          const [{ size }, { stdout }] = await Promise.all([
+            fs.promises.stat(libraryPath),
+            execFile(
+              readelfPath,
+              ["--wide", "--dyn-syms", "--relocations", libraryPath],
+              { encoding: "utf-8", maxBuffer: 256 * 1024 * 1024 },
+            ),
+          ]);
+          return [name, { size, ...parseReadelfStats(stdout) }] as const;
+        }),
+      ),
+    );
+  },
   async postBuild(
     resolveOutputPath,
     triplets,
@@ -264,15 +371,10 @@ export const platform: Platform<Triplet[], AndroidOpts> = {
     for (const { triplet, spawn } of triplets) {
       const buildPath = getBuildPath(build, triplet, configuration);
       assert(fs.existsSync(buildPath), `Expected a directory at ${buildPath}`);
-      const targets = await cmakeFileApi.readCurrentTargetsDeep(
+      const sharedLibraries = await readSharedLibraryTargets(
         buildPath,
         configuration,
-        "2.0",
-      );
-      const sharedLibraries = targets.filter(
-        ({ type, name }) =>
-          type === "SHARED_LIBRARY" &&
-          (target.length === 0 || target.includes(name)),
+        target,
       );
       await Promise.all(
         sharedLibraries.map(async (sharedLibrary) => {
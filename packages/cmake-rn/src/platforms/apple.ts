@@ -24,6 +24,17 @@ import {
   getCmakeJSVariables,
   getWeakNodeApiVariables,
 } from "../weak-node-api.js";
+import {
+  getPgoVariables,
+  getPlatformProfilePath,
+  mergeProfiles,
+} from "../pgo.js";
+import { FILE_API_REPLY_PATH } from "../build-cache.js";
+import {
+  getOptimizeStartupVariables,
+  parseDyldInfoFixupCount,
+  parseNmExportCount,
+} from "../startup.js";
 
 import * as z from "zod";
 
@@ -176,6 +187,20 @@ function getBuildPath(baseBuildPath: string, triplet: Triplet) {
   return path.join(baseBuildPath, triplet.replace(/;/g, "_"));
 }
 
+/**
+ * The framework createAppleFramework wraps a free dynamic library into.
+ *
+ * It's named after the artifact file, keeping any "lib" prefix, so this is
+ * derived the same way rather than from the (prefix-stripped) name of the
+ * prebuild.
+ */
+function getLibraryFrameworkPath(libraryPath: string) {
+  return path.join(
+    path.dirname(libraryPath),
+    `${path.basename(libraryPath, path.extname(libraryPath))}.framework`,
+  );
+}
+
 async function readCmakeSharedLibraryTargets(
   buildPath: string,
   configuration: string,
@@ -292,8 +317,30 @@ export const platform: Platform<Triplet[], AppleOpts> = {
   },
   async configure(
     triplets,
-    { source, build, define, weakNodeApiLinkage, cmakeJs, ccachePath },
+    {
+      source,
+      build,
+      define,
+      weakNodeApiLinkage,
+      weakNodeApiStatic,
+      cmakeJs,
+      ccachePath,
+      pgo,
+      pgoProfile,
+      optimizeStartup,
+    },
+    spawn,
   ) {
+    const profileDataPath = path.join(build, "apple.profdata");
+    if (pgo === "use") {
+      await mergeProfiles(
+        getPlatformProfilePath(pgoProfile, "apple"),
+        profileDataPath,
+        ["xcrun", "llvm-profdata"],
+        spawn,
+      );
+    }
+
     // When using ccache, we're creating symlinks for the clang and clang++ binaries to the ccache binary
     // This is needed for ccache to understand it's being invoked as clang and clang++ respectively.
     const buildBinPath = path.join(build, "bin");
@@ -343,8 +390,14 @@ export const platform: Platform<Triplet[], AppleOpts> = {
           "Xcode",
           ...toDefineArguments([
             ...define,
-            weakNodeApiLinkage ? getWeakNodeApiVariables("apple") : {},
+            weakNodeApiLinkage
+              ? getWeakNodeApiVariables("apple", {
+                  linkStatic: weakNodeApiStatic,
+                })
+              : {},
             cmakeJs ? getCmakeJSVariables("apple") : {},
+            pgo ? getPgoVariables(pgo, profileDataPath) : {},
+            optimizeStartup ? getOptimizeStartupVariables() : {},
             compilerDefinitions,
             {
               CMAKE_SYSTEM_NAME: CMAKE_SYSTEM_NAMES[triplet],
@@ -468,6 +521,64 @@ export const platform: Platform<Triplet[], AppleOpts> = {
   isSupportedByHost: function (): boolean | Promise<boolean> {
     return process.platform === "darwin";
   },
+  getToolchainId() {
+    return cp.execFileSync("xcodebuild", ["-version"], { encoding: "utf-8" });
+  },
+  async getBuildOutputs(triplet, { build, configuration, target }) {
+    const buildPath = getBuildPath(build, triplet);
+    const sharedLibraries = await readCmakeSharedLibraryTargets(
+      buildPath,
+      configuration,
+      target,
+    );
+    const outputs = sharedLibraries.flatMap(({ artifacts = [] }) =>
+      artifacts.flatMap(({ path: artifactPath }) => {
+        const frameworkIndex = artifactPath.indexOf(".framework/");
+        return frameworkIndex >= 0
+          ? [artifactPath.slice(0, frameworkIndex + ".framework".length)]
+          : [artifactPath, getLibraryFrameworkPath(artifactPath)];
+      }),
+    );
+    return [FILE_API_REPLY_PATH, ...outputs].map((output) =>
+      path.relative(build, path.join(buildPath, output)),
+    );
+  },
+  async readBinaryStats(triplet, { build, configuration, target }) {
+    const buildPath = getBuildPath(build, triplet);
+    const sharedLibraries = await readCmakeSharedLibraryTargets(
+      buildPath,
+      configuration,
+      target,
+    );
+    const options = {
+      encoding: "utf-8",
+      maxBuffer: 256 * 1024 * 1024,
+    } as const;
+    return Object.fromEntries(
+      await Promise.all(
+        sharedLibraries.map(async ({ name, artifacts }) => {
+          assert(
+            artifacts && artifacts.length === 1,
+            "Expected exactly one artifact",
+          );
+          const binaryPath = path.join(buildPath, artifacts[0].path);
+          const [{ size }, exports, fixups] = await Promise.all([
+            fs.promises.stat(binaryPath),
+            execFile("xcrun", ["nm", "-gU", binaryPath], options),
+            execFile("xcrun", ["dyld_info", "-fixups", binaryPath], options),
+          ]);
+          return [
+            name,
+            {
+              size,
+              exportedSymbols: parseNmExportCount(exports.stdout),
+              relocations: parseDyldInfoFixupCount(fixups.stdout),
+            },
+          ] as const;
+        }),
+      ),
+    );
+  },
   async postBuild(
     resolveOutputPath,
     triplets,
@@ -519,17 +630,7 @@ export const platform: Platform<Triplet[], AppleOpts> = {
           if (artifact.path.includes(".framework/")) {
             frameworkPath = path.dirname(artifactPath);
           } else {
-            // createAppleFramework names the framework after the artifact file,
-            // keeping any "lib" prefix, so this is derived the same way rather
-            // than from the (prefix-stripped) name of the prebuild.
-            frameworkPath = path.join(
-              buildPath,
-              path.dirname(artifact.path),
-              `${path.basename(
-                artifact.path,
-                path.extname(artifact.path),
-              )}.framework`,
-            );
+            frameworkPath = getLibraryFrameworkPath(artifactPath);
             assert(
               fs.existsSync(frameworkPath),
               `Expected to find a framework at: ${frameworkPath}`,
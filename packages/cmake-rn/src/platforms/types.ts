@@ -1,6 +1,7 @@
 import * as cli from "@react-native-node-api/cli-utils";
 
 import type { program } from "../cli.js";
+import type { BinaryStats } from "../startup.js";
 
 type InferOptionValues<Command extends cli.Command> = ReturnType<
   Command["opts"]
@@ -89,6 +90,28 @@ export type Platform<
     context: TripletContext<Triplet>,
     options: BaseOpts & Opts,
   ): Promise<void>;
+  /**
+   * Identify the toolchain building this platform's triplets, for the build
+   * cache to tell apart the outputs of different toolchains.
+   */
+  getToolchainId(options: BaseOpts & Opts): string | Promise<string>;
+  /**
+   * Paths of everything `postBuild` reads from a built triplet, relative to
+   * the `--build` directory, for the build cache to store and later restore
+   * instead of building the triplet again.
+   */
+  getBuildOutputs(
+    triplet: Triplet,
+    options: BaseOpts & Opts,
+  ): Promise<string[]>;
+  /**
+   * Measure the binaries built for a triplet, keyed by target name, for
+   * --startup-report.
+   */
+  readBinaryStats(
+    triplet: Triplet,
+    options: BaseOpts & Opts,
+  ): Promise<Record<string, BinaryStats>>;
   /**
    * Called to combine multiple triplets into a single prebuilt artefact.
    */
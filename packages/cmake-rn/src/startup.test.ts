@@ -0,0 +1,98 @@
+import assert from "node:assert/strict";
+import { describe, it } from "node:test";
+import { stripVTControlCharacters } from "node:util";
+
+import {
+  formatStartupReport,
+  parseDyldInfoFixupCount,
+  parseNmExportCount,
+  parseReadelfStats,
+} from "./startup.js";
+
+describe("parseReadelfStats", () => {
+  it("counts defined dynamic symbols and decoded relocations", () => {
+    const output = `
+Relocation section '.rela.dyn' at offset 0x4f8 contains 2 entries:
+    Offset             Info             Type               Symbol's Value  Symbol's Name + Addend
+0000000000003d80  0000000000000403 R_AARCH64_RELATIVE                        1634
+0000000000003fd8  0000000300000401 R_AARCH64_GLOB_DAT     0000000000000000 napi_create_double + 0
+
+Relocation section '.relr.dyn' at offset 0x528 contains 1 entries:
+    Offset             Info             Type               Symbol's Value  Symbol's Name
+0000000000003d88  0000000000000403 R_AARCH64_RELATIVE
+
+Symbol table '.dynsym' contains 4 entries:
+   Num:    Value          Size Type    Bind   Vis       Ndx Name
+     0: 0000000000000000     0 NOTYPE  LOCAL  DEFAULT   UND
+     1: 0000000000000000     0 FUNC    GLOBAL DEFAULT   UND napi_create_double
+     2: 0000000000001634    64 FUNC    GLOBAL DEFAULT    12 napi_register_module_v1
+     3: 0000000000001674     8 FUNC    GLOBAL DEFAULT    12 node_api_module_get_api_version_v1
+`;
+    assert.deepEqual(parseReadelfStats(output), {
+      exportedSymbols: 2,
+      relocations: 3,
+    });
+  });
+});
+
+describe("parseNmExportCount", () => {
+  it("counts the exports of every architecture", () => {
+    const output = `
+/build/addon.framework/addon (for architecture arm64):
+0000000000003f54 T _napi_register_module_v1
+0000000000003f90 T _node_api_module_get_api_version_v1
+
+/build/addon.framework/addon (for architecture x86_64):
+0000000000003e20 T _napi_register_module_v1
+`;
+    assert.equal(parseNmExportCount(output), 3);
+  });
+});
+
+describe("parseDyldInfoFixupCount", () => {
+  it("counts the fixups listed", () => {
+    const output = `
+/build/addon.framework/addon [arm64]:
+    -fixups:
+        segment         section          address                 type   target
+        __DATA_CONST    __got            0x00004000              bind   libSystem.B.dylib/_free
+        __DATA          __data           0x00008000              rebase 0x00003F54
+`;
+    assert.equal(parseDyldInfoFixupCount(output), 2);
+  });
+});
+
+describe("formatStartupReport", () => {
+  it("compares against an earlier report", () => {
+    const output = stripVTControlCharacters(
+      formatStartupReport(
+        {
+          "aarch64-linux-android addon": {
+            size: 4096,
+            exportedSymbols: 40,
+            relocations: 100,
+          },
+        },
+        {
+          "aarch64-linux-android addon": {
+            size: 2048,
+            exportedSymbols: 2,
+            relocations: 100,
+          },
+          "x86_64-linux-android addon": {
+            size: 1024,
+            exportedSymbols: 2,
+            relocations: 10,
+          },
+        },
+      ),
+    );
+    const [header, android, x86] = output.split("\n");
+    assert.match(header, /^Binary\s+Size\s+Exported symbols\s+Relocations$/);
+    assert.match(
+      android,
+      /^aarch64-linux-android addon\s+4\.0 KiB → 2\.0 KiB \(-50\.0%\)\s+40 → 2 \(-95\.0%\)\s+100$/,
+    );
+    assert.match(x86, /^x86_64-linux-android addon\s+1\.0 KiB\s+2\s+10$/);
+  });
+});
@@ -0,0 +1,146 @@
+import fs from "node:fs";
+import { stripVTControlCharacters } from "node:util";
+
+import { chalk } from "@react-native-node-api/cli-utils";
+
+import { projectIncludePath } from "./helpers.js";
+import { toCmakePath } from "./weak-node-api.js";
+
+/**
+ * CMake cache variables linking every target smaller and quicker to load
+ * (see cmake/optimize-startup.cmake).
+ */
+export function getOptimizeStartupVariables(): Record<string, string> {
+  return {
+    CMAKE_PROJECT_INCLUDE: toCmakePath(projectIncludePath),
+    CMAKE_RN_OPTIMIZE_STARTUP: "ON",
+  };
+}
+
+/**
+ * What loading a binary costs the dynamic linker.
+ */
+export type BinaryStats = {
+  /** Size of the file in bytes */
+  size: number;
+  /** Symbols the binary exports, each one a candidate for symbol lookups */
+  exportedSymbols: number;
+  /** Relocations (or, on Apple platforms, fixups) applied when loading */
+  relocations: number;
+};
+
+/**
+ * Stats per binary, keyed by triplet and target name.
+ */
+export type StartupReport = Record<string, BinaryStats>;
+
+/**
+ * Count the defined dynamic symbols and relocations listed by
+ * `llvm-readelf --wide --dyn-syms --relocations`, decoding packed relocations.
+ */
+export function parseReadelfStats(
+  output: string,
+): Omit<BinaryStats, "size"> {
+  let exportedSymbols = 0;
+  let relocations = 0;
+  for (const line of output.split("\n")) {
+    if (/^\s*\d+: [0-9a-f]+\s/.test(line)) {
+      // Symbol table entries: "Num: Value Size Type Bind Vis Ndx Name"
+      const [, , , , binding, , index] = line.trim().split(/\s+/);
+      if (index !== "UND" && binding !== "LOCAL") {
+        exportedSymbols++;
+      }
+    } else if (/^\s*[0-9a-f]+\s.*\bR_[A-Z0-9_]+/.test(line)) {
+      relocations++;
+    }
+  }
+  return { exportedSymbols, relocations };
+}
+
+/**
+ * Count the symbols listed by `nm -gU` (of every architecture, for a
+ * universal binary).
+ */
+export function parseNmExportCount(output: string): number {
+  const lines = output.split("\n");
+  return lines.filter((line) => /^[0-9a-f]+ [A-Z] /.test(line)).length;
+}
+
+/**
+ * Count the fixups listed by `dyld_info -fixups` (of every architecture, for
+ * a universal binary).
+ */
+export function parseDyldInfoFixupCount(output: string): number {
+  const lines = output.split("\n");
+  const fixupPattern = /^\s+__\w+\s+__\w+\s+0x[0-9A-Fa-f]+\s/;
+  return lines.filter((line) => fixupPattern.test(line)).length;
+}
+
+export function readStartupReport(reportPath: string): StartupReport {
+  return fs.existsSync(reportPath)
+    ? (JSON.parse(fs.readFileSync(reportPath, "utf-8")) as StartupReport)
+    : {};
+}
+
+export function writeStartupReport(reportPath: string, report: StartupReport) {
+  fs.writeFileSync(reportPath, JSON.stringify(report, null, 2), "utf-8");
+}
+
+function formatSize(size: number) {
+  return size < 1024 * 1024
+    ? `${(size / 1024).toFixed(1)} KiB`
+    : `${(size / 1024 / 1024).toFixed(2)} MiB`;
+}
+
+function formatChange(
+  current: number,
+  previous: number | undefined,
+  format: (value: number) => string = String,
+) {
+  if (previous === undefined || previous === current) {
+    return format(current);
+  }
+  const change = ((current - previous) / previous) * 100;
+  const formattedChange = `${change > 0 ? "+" : ""}${change.toFixed(1)}%`;
+  const color = change < 0 ? chalk.green : chalk.red;
+  return `${format(previous)} → ${format(current)} ${color(`(${formattedChange})`)}`;
+}
+
+/**
+ * Tabulate the stats of the binaries just built, next to those recorded for
+ * the same binaries by an earlier run, such as one without
+ * --optimize-startup.
+ */
+export function formatStartupReport(
+  previous: StartupReport,
+  current: StartupReport,
+): string {
+  const rows = Object.entries(current)
+    .sort(([a], [b]) => a.localeCompare(b))
+    .map(([binary, stats]) => [
+      binary,
+      formatChange(stats.size, previous[binary]?.size, formatSize),
+      formatChange(stats.exportedSymbols, previous[binary]?.exportedSymbols),
+      formatChange(stats.relocations, previous[binary]?.relocations),
+    ]);
+  const header = ["Binary", "Size", "Exported symbols", "Relocations"];
+  // The width of colored cells is measured without their escape codes
+  const widths = header.map((title, column) =>
+    Math.max(
+      title.length,
+      ...rows.map((row) => stripVTControlCharacters(row[column]).length),
+    ),
+  );
+  return [header.map((title) => chalk.bold(title)), ...rows]
+    .map((row) =>
+      row
+        .map(
+          (cell, column) =>
+            cell +
+            " ".repeat(widths[column] - stripVTControlCharacters(cell).length),
+        )
+        .join("  ")
+        .trimEnd(),
+    )
+    .join("\n");
+}
@@ -56,6 +56,7 @@ function getNodeApiIncludePaths() {
 
 export function getWeakNodeApiVariables(
   triplet: SupportedTriplet | "apple",
+  { linkStatic = false }: { linkStatic?: boolean } = {},
 ): Record<string, string> {
   return {
     // Enable use of `find_package(weak-node-api REQUIRED CONFIG)`
@@ -64,6 +65,8 @@ export function getWeakNodeApiVariables(
     WEAK_NODE_API_CONFIG: weakNodeApiCmakePath,
     WEAK_NODE_API_INC: getNodeApiIncludePaths().join(";"),
     WEAK_NODE_API_LIB: getWeakNodeApiPath(triplet),
+    // Make the weak-node-api target link the static variant
+    ...(linkStatic ? { WEAK_NODE_API_STATIC: "ON" } : {}),
   };
 }
 
@@ -6,6 +6,7 @@ import { readPackageSync } from "read-pkg";
 
 import {
   Command,
+  InvalidArgumentError,
   Option,
   prettyPath,
   wrapAction,
@@ -17,6 +18,9 @@ import {
   type GypToCmakeListsOptions,
 } from "./transformer.js";
 
+// Matches CMake's default for UNITY_BUILD_BATCH_SIZE
+const DEFAULT_UNITY_BUILD_BATCH_SIZE = 8;
+
 export type TransformOptions = Omit<GypToCmakeListsOptions, "gyp"> & {
   disallowUnknownProperties: boolean;
 };
@@ -72,6 +76,24 @@ export function transformBindingGypsRecursively(
   }
 }
 
+const unityBuildOption = new Option(
+  "--unity-build [batch-size]",
+  "Compile the sources of each target in batches, each as a single translation unit",
+)
+  .argParser((value) => {
+    const result = Number(value);
+    if (!Number.isSafeInteger(result) || result < 1) {
+      throw new InvalidArgumentError("Expected a positive integer.");
+    }
+    return result;
+  })
+  .preset(DEFAULT_UNITY_BUILD_BATCH_SIZE);
+
+const precompileHeadersOption = new Option(
+  "--precompile-headers <header...>",
+  "Headers to precompile for the C++ sources of every target, such as '<node_api.h>' (quoted, for the shell) or headers of heavy dependencies",
+).default([] as string[]);
+
 const projectNameOption = new Option(
   "--project-name <name>",
   "Project name to use in CMakeLists.txt",
@@ -95,6 +117,8 @@ export const program = new Command("gyp-to-cmake")
     "Use namespaced targets, to allow multiple targets with the same name to be referenced from a single parent project",
     false,
   )
+  .addOption(unityBuildOption)
+  .addOption(precompileHeadersOption)
   .addOption(projectNameOption)
   .argument(
     "[path]",
@@ -113,6 +137,8 @@ export const program = new Command("gyp-to-cmake")
           appleFramework,
           projectName,
           namespacedTargets,
+          unityBuild,
+          precompileHeaders,
         },
       ) => {
         const options: Omit<TransformOptions, "projectName"> = {
@@ -124,6 +150,8 @@ export const program = new Command("gyp-to-cmake")
           weakNodeApi,
           appleFramework,
           namespacedTargets,
+          unityBuildBatchSize: typeof unityBuild === "number" ? unityBuild : 0,
+          precompileHeaders,
         };
         const stat = fs.statSync(targetPath);
         if (stat.isFile()) {
@@ -231,4 +231,99 @@ describe("bindingGypToCmakeLists", () => {
       );
     });
   });
+
+  describe("compile batching", () => {
+    const gyp = {
+      targets: [{ target_name: "addon", sources: ["a.cc", "b.cc"] }],
+    };
+
+    it("should emit neither by default", () => {
+      const output = bindingGypToCmakeLists({
+        projectName: "some-project",
+        gyp,
+      });
+
+      assert(output.includes("cmake_minimum_required(VERSION 3.15...3.31)"));
+      assert(!output.includes("UNITY_BUILD"));
+      assert(!output.includes("target_precompile_headers"));
+    });
+
+    it("should batch sources into unity builds", () => {
+      const output = bindingGypToCmakeLists({
+        projectName: "some-project",
+        gyp,
+        unityBuildBatchSize: 16,
+      });
+
+      assert(
+        output.includes(
+          [
+            "set_target_properties(addon PROPERTIES",
+            "  UNITY_BUILD ON",
+            "  UNITY_BUILD_BATCH_SIZE 16",
+            " )",
+          ].join("\n"),
+        ),
+        `Expected unity build properties:\n${output}`,
+      );
+    });
+
+    it("should precompile headers", () => {
+      const output = bindingGypToCmakeLists({
+        projectName: "some-project",
+        gyp,
+        namespacedTargets: true,
+        precompileHeaders: ["<node_api.h>", "third_party\\big header.h"],
+      });
+
+      assert(
+        output.includes(
+          "target_precompile_headers(some-project-addon PRIVATE $<$<COMPILE_LANGUAGE:CXX>:<node_api.h$<ANGLE-R>> $<$<COMPILE_LANGUAGE:CXX>:${CMAKE_CURRENT_SOURCE_DIR}/third_party/big\\ header.h>)",
+        ),
+        `Expected precompiled headers:\n${output}`,
+      );
+    });
+
+    it("should precompile headers for C++ sources only", () => {
+      const output = bindingGypToCmakeLists({
+        projectName: "some-project",
+        gyp: {
+          targets: [
+            {
+              target_name: "mixed",
+              sources: ["binding.cc", "vendor/sqlite3.c"],
+            },
+          ],
+        },
+        precompileHeaders: ["<napi.h>"],
+      });
+
+      assert(
+        output.includes("add_library(mixed SHARED binding.cc vendor/sqlite3.c"),
+      );
+      assert(
+        output.includes(
+          "target_precompile_headers(mixed PRIVATE $<$<COMPILE_LANGUAGE:CXX>:<napi.h$<ANGLE-R>>)",
+        ),
+        `Expected C++-only precompiled headers:\n${output}`,
+      );
+    });
+
+    it("should require a CMake version supporting them", () => {
+      for (const options of [
+        { unityBuildBatchSize: 8 },
+        { precompileHeaders: ["<node_api.h>"] },
+      ]) {
+        const output = bindingGypToCmakeLists({
+          projectName: "some-project",
+          gyp,
+          ...options,
+        });
+        assert(
+          output.includes("cmake_minimum_required(VERSION 3.16...3.31)"),
+          `Expected CMake 3.16:\n${output}`,
+        );
+      }
+    });
+  });
 });
@@ -5,6 +5,10 @@ import type { GypBinding } from "./gyp.js";
 
 const DEFAULT_NAPI_VERSION = 8;
 
+// UNITY_BUILD and target_precompile_headers were introduced in CMake 3.16
+const MINIMUM_CMAKE_VERSION = "3.15";
+const MINIMUM_CMAKE_VERSION_COMPILE_BATCHING = "3.16";
+
 export type GypToCmakeListsOptions = {
   gyp: GypBinding;
   projectName: string;
@@ -17,6 +21,16 @@ export type GypToCmakeListsOptions = {
   weakNodeApi?: boolean;
   appleFramework?: boolean;
   namespacedTargets?: boolean;
+  /**
+   * Compile the sources of each target in batches of this many, each batch
+   * as a single translation unit (CMake's UNITY_BUILD). Skipped if zero.
+   */
+  unityBuildBatchSize?: number;
+  /**
+   * Headers to precompile for each target, such as `<node_api.h>` or heavy
+   * third-party headers included by most of its sources.
+   */
+  precompileHeaders?: string[];
 };
 
 function isCmdExpansion(value: string) {
@@ -28,6 +42,21 @@ function escapeSpaces(source: string) {
   return source.replace(/ /g, "\\ ");
 }
 
+/**
+ * Limits a precompiled header to the C++ sources of a target, as gyp targets
+ * often mix in C sources, which cannot include a C++ header.
+ * A `>` would end the generator expression, hence `$<ANGLE-R>`, and CMake
+ * leaves relative paths in one as they are, rather than resolving them
+ * against the source directory.
+ */
+function forCxxOnly(header: string) {
+  const resolved =
+    header.startsWith("<") || header.startsWith("$") || path.isAbsolute(header)
+      ? header
+      : "${CMAKE_CURRENT_SOURCE_DIR}/" + header;
+  return `$<$<COMPILE_LANGUAGE:CXX>:${resolved.replaceAll(">", "$<ANGLE-R>")}>`;
+}
+
 /**
  * Escapes any input to match a CFBundleIdentifier
  * See https://developer.apple.com/documentation/bundleresources/information-property-list/cfbundleidentifier
@@ -52,6 +81,8 @@ export function bindingGypToCmakeLists({
   appleFramework = true,
   compileFeatures = [],
   namespacedTargets = false,
+  unityBuildBatchSize = 0,
+  precompileHeaders = [],
 }: GypToCmakeListsOptions): string {
   function mapExpansion(value: string): string[] {
     if (!isCmdExpansion(value)) {
@@ -77,8 +108,13 @@ export function bindingGypToCmakeLists({
     }
   }
 
+  const minimumCmakeVersion =
+    unityBuildBatchSize > 0 || precompileHeaders.length > 0
+      ? MINIMUM_CMAKE_VERSION_COMPILE_BATCHING
+      : MINIMUM_CMAKE_VERSION;
+
   const lines: string[] = [
-    "cmake_minimum_required(VERSION 3.15...3.31)",
+    `cmake_minimum_required(VERSION ${minimumCmakeVersion}...3.31)`,
     //"cmake_policy(SET CMP0091 NEW)",
     //"cmake_policy(SET CMP0042 NEW)",
     `project(${projectName})`,
@@ -222,6 +258,25 @@ export function bindingGypToCmakeLists({
       );
     }
 
+    if (unityBuildBatchSize > 0) {
+      lines.push(
+        ...setTargetPropertiesLines({
+          UNITY_BUILD: "ON",
+          UNITY_BUILD_BATCH_SIZE: String(unityBuildBatchSize),
+        }),
+      );
+    }
+
+    if (precompileHeaders.length > 0) {
+      lines.push(
+        `target_precompile_headers(${actualTargetName} PRIVATE ${precompileHeaders
+          .map(transformPath)
+          .map(escapeSpaces)
+          .map(forCxxOnly)
+          .join(" ")})`,
+      );
+    }
+
     // `set_target_properties(${actualTargetName} PROPERTIES CXX_STANDARD 11 CXX_STANDARD_REQUIRED YES CXX_EXTENSIONS NO)`,
   }
 
@@ -3,12 +3,11 @@
 #include <ReactCommon/CxxTurboModuleUtils.h>
 
 #include <CxxNodeApiHostModule.hpp>
-#include <WeakNodeApiInjector.hpp>
 
 // Called when the library is loaded
 jint JNI_OnLoad(JavaVM *vm, void *reserved) {
-  callstack::react_native_node_api::injectIntoWeakNodeApi();
-  // Register the C++ TurboModule
+  // Register the C++ TurboModule; weak-node-api is injected as the first
+  // addon loads (see ensureInjectedIntoWeakNodeApi)
   facebook::react::registerCxxModuleToGlobalModuleMap(
       callstack::react_native_node_api::CxxNodeApiHostModule::kModuleName,
       [](std::shared_ptr<facebook::react::CallInvoker> jsInvoker) {
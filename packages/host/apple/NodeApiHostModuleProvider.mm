@@ -1,5 +1,4 @@
 #import "CxxNodeApiHostModule.hpp"
-#import "WeakNodeApiInjector.hpp"
 
 #import <ReactCommon/CxxTurboModuleUtils.h>
 @interface NodeApiHostPackage : NSObject
@@ -8,8 +7,9 @@
 
 @implementation NodeApiHostPackage
 + (void)load {
-  callstack::react_native_node_api::injectIntoWeakNodeApi();
-
+  // weak-node-api is injected as the first addon loads (see
+  // ensureInjectedIntoWeakNodeApi), keeping the injection off the app's
+  // startup path
   facebook::react::registerCxxModuleToGlobalModuleMap(
       callstack::react_native_node_api::CxxNodeApiHostModule::kModuleName,
       [](std::shared_ptr<facebook::react::CallInvoker> jsInvoker) {
@@ -0,0 +1,105 @@
+#include "AddonBundles.hpp"
+#include "Logger.hpp"
+
+#include <weak_node_api_bundle.h>
+
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include <dlfcn.h>
+
+namespace callstack::react_native_node_api {
+
+namespace {
+
+struct Bundles {
+  std::mutex mutex;
+  // Added, but not yet opened.
+  std::vector<std::string> unopened;
+  std::unordered_map<std::string, AddonBundles::Addon> addons;
+
+  static Bundles &instance() {
+    // Leaked, like the other host singletons.
+    static auto *bundles = new Bundles();
+    return *bundles;
+  }
+
+  // Opens the bundle at `path` and indexes its addons.
+  void open(const std::string &path) {
+    void *handle = dlopen(path.c_str(), RTLD_NOW | RTLD_LOCAL);
+    if (handle == nullptr) {
+      log_warning("NapiHost: failed to open the addon bundle '%s': %s",
+                  path.c_str(), dlerror());
+      return;
+    }
+    const auto *entry = static_cast<const node_api_bundle_entry *>(
+        dlsym(handle, NODE_API_BUNDLE_SYMBOL));
+    if (entry == nullptr) {
+      log_warning("NapiHost: '%s' is not an addon bundle: it exports no %s",
+                  path.c_str(), NODE_API_BUNDLE_SYMBOL);
+      dlclose(handle);
+      return;
+    }
+    for (; entry->name != nullptr; entry++) {
+      auto [it, inserted] = addons.try_emplace(
+          entry->name, AddonBundles::Addon{.init = entry->init});
+      if (!inserted) {
+        log_warning("NapiHost: ignoring '%s' in '%s', as an earlier bundle "
+                    "links it",
+                    entry->name, path.c_str());
+      }
+    }
+    log_debug("Opened the addon bundle '%s'", path.c_str());
+  }
+};
+
+} // namespace
+
+void AddonBundles::add(const std::string &path) {
+  Bundles &bundles = Bundles::instance();
+  std::lock_guard lock(bundles.mutex);
+  bundles.unopened.push_back(path);
+}
+
+std::optional<AddonBundles::Addon> AddonBundles::find(const std::string &name) {
+  Bundles &bundles = Bundles::instance();
+  std::lock_guard lock(bundles.mutex);
+  for (;;) {
+    auto it = bundles.addons.find(name);
+    if (it != bundles.addons.end()) {
+      return it->second;
+    }
+    if (bundles.unopened.empty()) {
+      return std::nullopt;
+    }
+    // Bundles are opened in the order they were added, and only until one
+    // links the addon.
+    const std::string path = std::move(bundles.unopened.front());
+    bundles.unopened.erase(bundles.unopened.begin());
+    bundles.open(path);
+  }
+}
+
+napi_status AddonBundles::load(napi_env env, const Addon &addon,
+                               napi_value *result) {
+  napi_value exports = nullptr;
+  napi_status status = napi_create_object(env, &exports);
+  if (status != napi_ok) {
+    return status;
+  }
+  napi_value returned = addon.init(env, exports);
+  bool pending = false;
+  status = napi_is_exception_pending(env, &pending);
+  if (status != napi_ok) {
+    return status;
+  }
+  if (pending) {
+    return napi_pending_exception;
+  }
+  // As in Node, an init returning nothing exports the object it was given.
+  *result = returned != nullptr ? returned : exports;
+  return napi_ok;
+}
+
+} // namespace callstack::react_native_node_api
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <node_api.h>
+
+#include <optional>
+#include <string>
+
+namespace callstack::react_native_node_api {
+
+/// Loads addons from bundle libraries: shared libraries linking several
+/// addons, built by add_node_api_bundle (weak-node-api's
+/// node-api-bundle.cmake), which an app with many addons uses to pay for one
+/// dlopen, symbol lookup and relocation pass instead of one per addon.
+///
+/// A bundle is opened the first time an addon is looked up, after which every
+/// addon it links resolves from its table without touching the dynamic
+/// loader again. Bundles are never closed.
+class AddonBundles {
+public:
+  /// Makes the addons linked into the bundle at `path` loadable by name.
+  /// `path` is as passed to dlopen: "lib<name>.so" on Android and
+  /// "@rpath/<name>.framework/<name>" on Apple platforms, as for addons.
+  /// Call at startup, before the first addon loads.
+  static void add(const std::string &path);
+
+  struct Addon {
+    napi_addon_register_func init = nullptr;
+  };
+
+  /// The addon required as `name`, if an added bundle links it.
+  static std::optional<Addon> find(const std::string &name);
+
+  /// Initializes `addon` in `env`, as hermes_napi_load_module does for an
+  /// addon in its own library, except that Hermes offers no way to apply the
+  /// Node-API version the addon declares (its bundle table entry's
+  /// get_api_version), so it is not read: `env` keeps Hermes' default.
+  /// Requires an open handle scope on `env`; on failure, returns a non-`ok`
+  /// status, with an exception pending if the addon threw.
+  static napi_status load(napi_env env, const Addon &addon,
+                          napi_value *result);
+};
+
+} // namespace callstack::react_native_node_api
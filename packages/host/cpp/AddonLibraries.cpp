@@ -0,0 +1,160 @@
+#include "AddonLibraries.hpp"
+#include "EventLog.hpp"
+#include "Logger.hpp"
+
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include <dlfcn.h>
+
+namespace callstack::react_native_node_api {
+
+namespace {
+
+// A load of the library into a runtime.
+struct User {
+  const void *runtime = nullptr;
+  std::weak_ptr<HostContext> context;
+  // Set once the embedder signalled the runtime's destruction.
+  bool destroyed = false;
+};
+
+struct Library {
+  std::string owner;
+  // One entry per load.
+  std::vector<User> users;
+  // References opened for the loads, one each, which the host closes.
+  size_t adopted = 0;
+};
+
+struct Libraries {
+  std::atomic<bool> unloadEnabled{false};
+  std::mutex mutex;
+  // Keyed by path, as passed to hermes_napi_load_module.
+  std::unordered_map<std::string, Library> byPath;
+
+  static Libraries &instance() {
+    // Leaked, like the other host singletons.
+    static auto *libraries = new Libraries();
+    return *libraries;
+  }
+};
+
+// Set while open() loads a library on this thread, to the registration it
+// captured, if any.
+thread_local bool capturing = false;
+thread_local napi_module *captured = nullptr;
+
+// Closes every reference the host adopted for the library, returning
+// whether the system unmapped it.
+bool unload(const std::string &path, const Library &library) {
+  void *handle = dlopen(path.c_str(), RTLD_NOW | RTLD_NOLOAD);
+  if (handle == nullptr) {
+    // Already gone: something else closed Hermes' references.
+    return true;
+  }
+  dlclose(handle);
+  for (size_t i = 0; i < library.adopted; i++) {
+    if (dlclose(handle) != 0) {
+      log_warning("NapiHost: failed to close '%s': %s", path.c_str(),
+                  dlerror());
+      break;
+    }
+  }
+  return !AddonLibraries::isLoaded(path);
+}
+
+} // namespace
+
+void AddonLibraries::setUnloadEnabled(bool enabled) {
+  Libraries::instance().unloadEnabled.store(enabled,
+                                            std::memory_order_relaxed);
+}
+
+bool AddonLibraries::unloadEnabled() {
+  return Libraries::instance().unloadEnabled.load(std::memory_order_relaxed);
+}
+
+bool AddonLibraries::isLoaded(const std::string &path) {
+  void *handle = dlopen(path.c_str(), RTLD_NOW | RTLD_NOLOAD);
+  if (handle == nullptr) {
+    return false;
+  }
+  dlclose(handle);
+  return true;
+}
+
+AddonLibraries::Opened AddonLibraries::open(const std::string &path) {
+  capturing = true;
+  captured = nullptr;
+  void *handle = dlopen(path.c_str(), RTLD_NOW | RTLD_LOCAL);
+  capturing = false;
+  Opened opened{.handle = handle};
+  if (handle != nullptr && captured != nullptr &&
+      dlsym(handle, "napi_register_module_v1") == nullptr) {
+    opened.registered = captured;
+  }
+  captured = nullptr;
+  return opened;
+}
+
+bool AddonLibraries::captureRegistration(napi_module *module) {
+  if (!capturing) {
+    return false;
+  }
+  captured = module;
+  return true;
+}
+
+void AddonLibraries::adopt(const std::shared_ptr<HostContext> &context,
+                           const void *runtime, const std::string &owner,
+                           const std::string &path) {
+  if (!unloadEnabled()) {
+    return;
+  }
+  Libraries &libraries = Libraries::instance();
+  std::lock_guard lock(libraries.mutex);
+  Library &library = libraries.byPath[path];
+  library.owner = owner;
+  library.users.push_back(User{.runtime = runtime, .context = context});
+  library.adopted++;
+}
+
+size_t AddonLibraries::runtimeDestroyed(const void *runtime) {
+  Libraries &libraries = Libraries::instance();
+  std::lock_guard lock(libraries.mutex);
+  size_t unloaded = 0;
+  for (auto it = libraries.byPath.begin(); it != libraries.byPath.end();) {
+    auto &[path, library] = *it;
+    for (User &user : library.users) {
+      if (user.runtime == runtime) {
+        user.destroyed = true;
+      }
+    }
+    // Loads into runtimes signalled earlier, whose context outlived the
+    // signal, are retried too.
+    std::erase_if(library.users, [](const User &user) {
+      return user.destroyed && user.context.expired();
+    });
+    if (!library.users.empty()) {
+      ++it;
+      continue;
+    }
+    const bool unmapped = unload(path, library);
+    recordEvent(EventId::AddonUnloaded, internEventString(library.owner),
+                unmapped ? 1 : 0);
+    if (unmapped) {
+      log_debug("[%s] Unloaded '%s'", library.owner.c_str(), path.c_str());
+    } else {
+      log_debug("[%s] Closed '%s', which the system keeps loaded",
+                library.owner.c_str(), path.c_str());
+    }
+    unloaded++;
+    it = libraries.byPath.erase(it);
+  }
+  return unloaded;
+}
+
+} // namespace callstack::react_native_node_api
@@ -0,0 +1,81 @@
+#pragma once
+
+#include "HermesNapiHost.hpp"
+
+#include <memory>
+#include <string>
+
+namespace callstack::react_native_node_api {
+
+/// Unmaps the shared libraries of addons once no runtime uses them, for apps
+/// loading large addons (ML models, codecs) in a single flow. Opt-in, as
+/// Node never unloads addons and an addon keeping process-wide state (a
+/// thread, an atexit handler, a pointer held by another library) crashes
+/// when its code is unmapped under it.
+///
+/// hermes_napi_load_module opens an addon's library for each env and never
+/// closes it. The host adopts those references: a library is closed once
+/// every runtime it was loaded into is destroyed, i.e. once the embedder has
+/// signalled each runtime's destruction (see runtimeDestroyed) and its
+/// HostContext is gone too, so no work or dispatch posted through its envs
+/// remains (see HostContext::retainUntilTeardown).
+///
+/// Neither the env cleanup hooks releasing a context nor anything else the
+/// host observes marks the end of a runtime: Hermes still runs addon code
+/// (object, external and thread-safe function finalizers) after those hooks,
+/// as it destroys the runtime. Only the embedder, which destroys the
+/// runtime, knows when that is over.
+/// Whether the system then unmaps the library is up to its loader: Apple
+/// platforms keep images with Objective-C or Swift metadata loaded.
+class AddonLibraries {
+public:
+  /// Enables unloading; call at startup, before the first addon loads.
+  /// Libraries adopted while disabled are never closed.
+  static void setUnloadEnabled(bool enabled);
+  static bool unloadEnabled();
+
+  struct Opened {
+    /// Null if the library could not be opened.
+    void *handle = nullptr;
+    /// The addon the library's static initializers registered through
+    /// napi_module_register as it loaded, if it exports no
+    /// napi_register_module_v1 (which Hermes would prefer).
+    napi_module *registered = nullptr;
+  };
+
+  /// Opens the library at `path`, running its static initializers, for the
+  /// dlopen to be timed apart from the addon's init. Registrations made as it
+  /// loads are captured (see captureRegistration) rather than reaching
+  /// Hermes, whose own dlopen of the library, now a mere reference, would
+  /// miss them: the caller initializes a registered addon itself, and leaves
+  /// any other to hermes_napi_load_module before closing `handle`.
+  static Opened open(const std::string &path);
+
+  /// Called by the host's napi_module_register: takes `module` if an open()
+  /// on this thread is loading the library registering it, and returns
+  /// whether it did.
+  static bool captureRegistration(napi_module *module);
+
+  /// Records that `owner`'s library at `path` was opened, by
+  /// hermes_napi_load_module or by open(), for an env of `runtime` (the
+  /// jsi::Runtime the addon was loaded into) served by `context`, and that
+  /// the reference is the host's to close. A no-op unless unloading is
+  /// enabled.
+  static void adopt(const std::shared_ptr<HostContext> &context,
+                    const void *runtime, const std::string &owner,
+                    const std::string &path);
+
+  /// Whether the library at `path` is loaded, without loading it.
+  static bool isLoaded(const std::string &path);
+
+  /// Signals that `runtime` has been destroyed: call it once the
+  /// jsi::Runtime's destructor has returned (e.g. once the React Native
+  /// instance owning it is torn down, after a reload or when leaving a flow
+  /// using large addons). Closes every adopted library that no runtime still
+  /// uses, returning how many were closed. A runtime whose HostContext is
+  /// still alive (with work in flight) keeps its libraries open until a later
+  /// call finds the context gone.
+  static size_t runtimeDestroyed(const void *runtime);
+};
+
+} // namespace callstack::react_native_node_api
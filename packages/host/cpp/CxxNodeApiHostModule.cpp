@@ -1,12 +1,21 @@
 #include "CxxNodeApiHostModule.hpp"
+#include "AddonBundles.hpp"
+#include "AddonLibraries.hpp"
+#include "EventLog.hpp"
+#include "ExternalMemory.hpp"
 #include "Logger.hpp"
+#include "PropertyKeyCache.hpp"
+#include "WeakNodeApiInjector.hpp"
 
 #include <jsi/hermes-interfaces.h>
 
 #include <cassert>
+#include <chrono>
 #include <cstdio>
 #include <string>
 
+#include <dlfcn.h>
+
 using namespace facebook;
 
 namespace callstack::react_native_node_api {
@@ -40,6 +49,10 @@ std::string takePendingExceptionMessage(napi_env env) {
   return message;
 }
 
+double toMilliseconds(std::chrono::nanoseconds duration) {
+  return std::chrono::duration<double, std::milli>(duration).count();
+}
+
 } // namespace
 
 CxxNodeApiHostModule::CxxNodeApiHostModule(
@@ -47,6 +60,12 @@ CxxNodeApiHostModule::CxxNodeApiHostModule(
     : TurboModule(CxxNodeApiHostModule::kModuleName, jsInvoker) {
   methodMap_["requireNodeAddon"] =
       MethodMetadata{1, &CxxNodeApiHostModule::requireNodeAddon};
+  methodMap_["getNodeAddonStats"] =
+      MethodMetadata{0, &CxxNodeApiHostModule::getNodeAddonStats};
+  methodMap_["getNodeAddonMemory"] =
+      MethodMetadata{0, &CxxNodeApiHostModule::getNodeAddonMemory};
+  methodMap_["getNodeAddonLoadTimings"] =
+      MethodMetadata{0, &CxxNodeApiHostModule::getNodeAddonLoadTimings};
 
   callInvoker_ = std::move(jsInvoker);
 
@@ -71,6 +90,10 @@ CxxNodeApiHostModule::CxxNodeApiHostModule(
   // The one caller that could still see the difference —
   // napi_cancel_async_work — receives the verdict through this dispatcher's
   // return value (see HostContext::cancelWork).
+  //
+  // The context is released with this module and the envs it serves (see
+  // HostContext::retainUntilTeardown), leaving only the host structs Hermes
+  // may still read during teardown.
   hostContext_ = HostContext::create(
       [weakInvoker = std::weak_ptr(callInvoker_)](std::function<void()> &&fn) {
         auto invoker = weakInvoker.lock();
@@ -82,7 +105,6 @@ CxxNodeApiHostModule::CxxNodeApiHostModule(
         invoker->invokeAsync(std::move(fn));
         return true;
       });
-  HostContext::retainForProcessLifetime(hostContext_);
 }
 
 jsi::Value
@@ -100,15 +122,27 @@ CxxNodeApiHostModule::requireNodeAddon(jsi::Runtime &rt,
 jsi::Value
 CxxNodeApiHostModule::requireNodeAddon(jsi::Runtime &rt,
                                        const jsi::String libraryName) {
+  using Clock = std::chrono::steady_clock;
+  const auto start = Clock::now();
   const std::string libraryNameStr = libraryName.utf8(rt);
 
   auto [it, inserted] = nodeAddons_.emplace(libraryNameStr, NodeAddon());
   NodeAddon &addon = it->second;
 
   // Check if this module has been loaded already, if not then load it...
+  AddonLoadTiming timing{
+      .libraryName = libraryNameStr,
+      .start = start - createdAt_,
+  };
   if (inserted) {
     try {
-      loadNodeAddon(rt, addon, libraryNameStr);
+      const auto injectStart = Clock::now();
+      if (ensureInjectedIntoWeakNodeApi()) {
+        timing.inject = Clock::now() - injectStart;
+        log_info("NapiHost: injected weak-node-api in %.2f ms",
+                 toMilliseconds(timing.inject));
+      }
+      loadNodeAddon(rt, addon, libraryNameStr, timing);
     } catch (...) {
       // Leave no half-initialized entry behind, so a later require of the same
       // addon retries the load instead of reading a missing global.
@@ -118,11 +152,116 @@ CxxNodeApiHostModule::requireNodeAddon(jsi::Runtime &rt,
   }
 
   // Look the exports up (using JSI) and return it...
-  return rt.global().getProperty(rt, addon.generatedName.c_str());
+  const auto lookupStart = Clock::now();
+  jsi::Value exports = rt.global().getProperty(rt, addon.generatedName.c_str());
+  const auto end = Clock::now();
+  if (inserted) {
+    timing.bridge += end - lookupStart;
+    timing.total = end - start;
+    log_info("NapiHost: loaded '%s' in %.2f ms (env %.2f ms, bundle lookup "
+             "%.2f ms, dlopen %.2f ms, init %.2f ms, bridge %.2f ms%s)",
+             libraryNameStr.c_str(), toMilliseconds(timing.total),
+             toMilliseconds(timing.env), toMilliseconds(timing.bundleLookup),
+             toMilliseconds(timing.libraryOpen), toMilliseconds(timing.init),
+             toMilliseconds(timing.bridge),
+             timing.bundled    ? ", bundled"
+             : timing.resident ? ", resident"
+                               : "");
+    loadTimingIndex_[libraryNameStr] = loadTimings_.size();
+    loadTimings_.push_back(std::move(timing));
+  } else if (auto found = loadTimingIndex_.find(libraryNameStr);
+             found != loadTimingIndex_.end()) {
+    AddonLoadTiming &loaded = loadTimings_[found->second];
+    loaded.cacheHits++;
+    loaded.cacheHitTime += end - start;
+  }
+  return exports;
+}
+
+jsi::Value
+CxxNodeApiHostModule::getNodeAddonStats(jsi::Runtime &rt,
+                                        react::TurboModule &turboModule,
+                                        const jsi::Value args[], size_t count) {
+  auto &thisModule = static_cast<CxxNodeApiHostModule &>(turboModule);
+  return thisModule.getNodeAddonStats(rt);
+}
+
+jsi::Object CxxNodeApiHostModule::getNodeAddonStats(jsi::Runtime &rt) {
+  const auto milliseconds = toMilliseconds;
+  jsi::Object stats(rt);
+  for (const HostContext::AddonUsage &usage : hostContext_->usage()) {
+    jsi::Object addon(rt);
+    addon.setProperty(rt, "executions", static_cast<double>(usage.executions));
+    addon.setProperty(rt, "executeWallMs",
+                      milliseconds(usage.executeWallTime));
+    addon.setProperty(rt, "executeCpuMs", milliseconds(usage.executeCpuTime));
+    addon.setProperty(rt, "completions",
+                      static_cast<double>(usage.completions));
+    addon.setProperty(rt, "completeMs", milliseconds(usage.completeTime));
+    addon.setProperty(rt, "taskDispatches",
+                      static_cast<double>(usage.taskDispatches));
+    addon.setProperty(rt, "taskMs", milliseconds(usage.taskTime));
+    stats.setProperty(rt, usage.owner.c_str(), std::move(addon));
+  }
+  return stats;
+}
+
+jsi::Value
+CxxNodeApiHostModule::getNodeAddonMemory(jsi::Runtime &rt,
+                                         react::TurboModule &turboModule,
+                                         const jsi::Value args[],
+                                         size_t count) {
+  auto &thisModule = static_cast<CxxNodeApiHostModule &>(turboModule);
+  return thisModule.getNodeAddonMemory(rt);
+}
+
+jsi::Value CxxNodeApiHostModule::getNodeAddonLoadTimings(
+    jsi::Runtime &rt, react::TurboModule &turboModule,
+    const jsi::Value args[], size_t count) {
+  auto &thisModule = static_cast<CxxNodeApiHostModule &>(turboModule);
+  return thisModule.getNodeAddonLoadTimings(rt);
+}
+
+jsi::Array CxxNodeApiHostModule::getNodeAddonLoadTimings(jsi::Runtime &rt) {
+  jsi::Array timings(rt, loadTimings_.size());
+  for (size_t i = 0; i < loadTimings_.size(); i++) {
+    const AddonLoadTiming &timing = loadTimings_[i];
+    jsi::Object entry(rt);
+    entry.setProperty(rt, "libraryName",
+                      jsi::String::createFromUtf8(rt, timing.libraryName));
+    entry.setProperty(rt, "startMs", toMilliseconds(timing.start));
+    entry.setProperty(rt, "totalMs", toMilliseconds(timing.total));
+    entry.setProperty(rt, "injectMs", toMilliseconds(timing.inject));
+    entry.setProperty(rt, "envMs", toMilliseconds(timing.env));
+    entry.setProperty(rt, "bundleLookupMs",
+                      toMilliseconds(timing.bundleLookup));
+    entry.setProperty(rt, "libraryOpenMs", toMilliseconds(timing.libraryOpen));
+    entry.setProperty(rt, "initMs", toMilliseconds(timing.init));
+    entry.setProperty(rt, "bridgeMs", toMilliseconds(timing.bridge));
+    entry.setProperty(rt, "bundled", timing.bundled);
+    entry.setProperty(rt, "resident", timing.resident);
+    entry.setProperty(rt, "cacheHits", static_cast<double>(timing.cacheHits));
+    entry.setProperty(rt, "cacheHitMs", toMilliseconds(timing.cacheHitTime));
+    timings.setValueAtIndex(rt, i, std::move(entry));
+  }
+  return timings;
+}
+
+jsi::Object CxxNodeApiHostModule::getNodeAddonMemory(jsi::Runtime &rt) {
+  jsi::Object memory(rt);
+  for (const ExternalMemory::AddonMemory &addon : ExternalMemory::snapshot()) {
+    jsi::Object entry(rt);
+    entry.setProperty(rt, "externalBytes", static_cast<double>(addon.current));
+    entry.setProperty(rt, "peakExternalBytes",
+                      static_cast<double>(addon.peak));
+    memory.setProperty(rt, addon.owner.c_str(), std::move(entry));
+  }
+  return memory;
 }
 
 void CxxNodeApiHostModule::loadNodeAddon(jsi::Runtime &rt, NodeAddon &addon,
-                                         const std::string &libraryName) {
+                                         const std::string &libraryName,
+                                         AddonLoadTiming &timing) {
 #if defined(__APPLE__)
   const std::string libraryPath =
       "@rpath/" + libraryName + ".framework/" + libraryName;
@@ -134,6 +273,9 @@ void CxxNodeApiHostModule::loadNodeAddon(jsi::Runtime &rt, NodeAddon &addon,
 
   log_debug("[%s] Loading addon by '%s'", libraryName.c_str(),
             libraryPath.c_str());
+  // log_debug is compiled out of release builds; the event log is not.
+  const int64_t addonId = internEventString(libraryName);
+  recordEvent(EventId::AddonLoadBegin, addonId);
 
   // Create this addon's Node-API environment. Hermes binds an env to its
   // low-level VM runtime, which we reach through the (unstable) IHermes JSI
@@ -149,10 +291,16 @@ void CxxNodeApiHostModule::loadNodeAddon(jsi::Runtime &rt, NodeAddon &addon,
               "create a Node-API environment");
     abort();
   }
+  using Clock = std::chrono::steady_clock;
+  auto phaseStart = Clock::now();
   addon.env = hermes_napi_create_env(hermes->getVMRuntimeUnsafe(),
-                                     hostContext_->host());
+                                     hostContext_->host(libraryName));
   assert(addon.env != nullptr);
   napi_env env = addon.env;
+  timing.env = Clock::now() - phaseStart;
+  recordEvent(EventId::AddonEnvCreated, addonId);
+  ExternalMemory::registerEnv(env, libraryName);
+  hostContext_->retainUntilTeardown(env);
 
   // A name to reference the exports object by from JSI. Instead of using
   // random numbers to avoid name clashes, we use the address of the env, which
@@ -169,14 +317,52 @@ void CxxNodeApiHostModule::loadNodeAddon(jsi::Runtime &rt, NodeAddon &addon,
   assert(status == napi_ok);
 
   napi_value exports = nullptr;
-  status = hermes_napi_load_module(env, libraryPath.c_str(), &exports);
+  phaseStart = Clock::now();
+  const auto bundled = AddonBundles::find(libraryName);
+  timing.bundleLookup = Clock::now() - phaseStart;
+  timing.bundled = bundled.has_value();
+  timing.resident = !bundled && AddonLibraries::isLoaded(libraryPath);
+  AddonLibraries::Opened library;
+  if (!bundled) {
+    // Opened ahead of hermes_napi_load_module, whose own dlopen then only
+    // takes a reference, so the static initializers are timed apart from
+    // the init. A failure is left for it to report.
+    phaseStart = Clock::now();
+    library = AddonLibraries::open(libraryPath);
+    timing.libraryOpen = Clock::now() - phaseStart;
+  }
+  phaseStart = Clock::now();
+  if (bundled) {
+    status = AddonBundles::load(env, *bundled, &exports);
+  } else if (library.registered != nullptr) {
+    // Hermes never saw the registration, so initialize it as a bundled
+    // addon is; the reference opened above is the load's.
+    status = AddonBundles::load(
+        env, AddonBundles::Addon{.init = library.registered->nm_register_func},
+        &exports);
+  } else {
+    status = hermes_napi_load_module(env, libraryPath.c_str(), &exports);
+  }
+  timing.init = Clock::now() - phaseStart;
+  if (library.handle != nullptr &&
+      (library.registered == nullptr || status != napi_ok)) {
+    // Hermes holds a reference of its own if its load went through, and a
+    // failed load keeps none.
+    dlclose(library.handle);
+  }
+  recordEvent(EventId::AddonModuleLoaded, addonId, status);
   if (status == napi_ok) {
+    if (!bundled) {
+      AddonLibraries::adopt(hostContext_, &rt, libraryName, libraryPath);
+    }
+    phaseStart = Clock::now();
     napi_value global = nullptr;
     status = napi_get_global(env, &global);
     assert(status == napi_ok);
-    status = napi_set_named_property(env, global, addon.generatedName.c_str(),
-                                     exports);
+    status = PropertyKeyCache::setNamedProperty(
+        env, global, addon.generatedName.c_str(), exports);
     assert(status == napi_ok);
+    timing.bridge = Clock::now() - phaseStart;
   }
 
   const bool failed = status != napi_ok;
@@ -190,6 +376,7 @@ void CxxNodeApiHostModule::loadNodeAddon(jsi::Runtime &rt, NodeAddon &addon,
   const napi_status closeStatus = napi_close_handle_scope(env, scope);
   assert(closeStatus == napi_ok);
   (void)closeStatus;
+  recordEvent(EventId::AddonLoadEnd, addonId, status);
 
   if (failed) {
     throw jsi::JSError(rt, "Failed to load '" + libraryName + "' addon from '" +
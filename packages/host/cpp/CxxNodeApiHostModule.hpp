@@ -6,9 +6,11 @@
 
 #include "HermesNapiHost.hpp"
 
+#include <chrono>
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 namespace callstack::react_native_node_api {
 
@@ -25,6 +27,30 @@ public:
   facebook::jsi::Value requireNodeAddon(facebook::jsi::Runtime &rt,
                                         const facebook::jsi::String path);
 
+  static facebook::jsi::Value
+  getNodeAddonStats(facebook::jsi::Runtime &rt,
+                    facebook::react::TurboModule &turboModule,
+                    const facebook::jsi::Value args[], size_t count);
+  /// The time each loaded addon's callbacks spent on the worker pool and the
+  /// JS thread, keyed by library name (see HostContext::usage).
+  facebook::jsi::Object getNodeAddonStats(facebook::jsi::Runtime &rt);
+
+  static facebook::jsi::Value
+  getNodeAddonMemory(facebook::jsi::Runtime &rt,
+                     facebook::react::TurboModule &turboModule,
+                     const facebook::jsi::Value args[], size_t count);
+  /// The external memory each addon reported, keyed by library name (see
+  /// ExternalMemory).
+  facebook::jsi::Object getNodeAddonMemory(facebook::jsi::Runtime &rt);
+
+  static facebook::jsi::Value
+  getNodeAddonLoadTimings(facebook::jsi::Runtime &rt,
+                          facebook::react::TurboModule &turboModule,
+                          const facebook::jsi::Value args[], size_t count);
+  /// Where the time of each addon load in this runtime went, in load order
+  /// (see AddonLoadTiming).
+  facebook::jsi::Array getNodeAddonLoadTimings(facebook::jsi::Runtime &rt);
+
 protected:
   struct NodeAddon {
     // The name the addon's exports object is stored under on the JavaScript
@@ -40,13 +66,51 @@ protected:
     napi_env env = nullptr;
   };
   std::unordered_map<std::string, NodeAddon> nodeAddons_;
+
+  /// The phases of loading an addon, timed on the monotonic clock.
+  struct AddonLoadTiming {
+    std::string libraryName;
+    /// When the load started, since this module was created.
+    std::chrono::nanoseconds start{};
+    std::chrono::nanoseconds total{};
+    /// Loading weak-node-api and injecting the host into it, if this was the
+    /// first load in the process (see ensureInjectedIntoWeakNodeApi).
+    std::chrono::nanoseconds inject{};
+    /// Creating the addon's env.
+    std::chrono::nanoseconds env{};
+    /// Looking the addon up in addon bundles, which opens them if this load
+    /// was the first lookup since they were added (see AddonBundles).
+    std::chrono::nanoseconds bundleLookup{};
+    /// Opening the addon's own library: the dlopen, including the library's
+    /// static initializers (see AddonLibraries::open).
+    std::chrono::nanoseconds libraryOpen{};
+    /// Initializing the addon: its init function, called with the exports.
+    std::chrono::nanoseconds init{};
+    /// Handing the exports over to JSI.
+    std::chrono::nanoseconds bridge{};
+    bool bundled = false;
+    /// Whether the library was already loaded, e.g. by an earlier runtime,
+    /// sparing the dlopen most of its work.
+    bool resident = false;
+    /// Later requires served from nodeAddons_, and the time they took.
+    uint32_t cacheHits = 0;
+    std::chrono::nanoseconds cacheHitTime{};
+  };
+  std::vector<AddonLoadTiming> loadTimings_;
+  /// Index into loadTimings_ by library name.
+  std::unordered_map<std::string, size_t> loadTimingIndex_;
+  std::chrono::steady_clock::time_point createdAt_ =
+      std::chrono::steady_clock::now();
+
   std::shared_ptr<facebook::react::CallInvoker> callInvoker_;
   // The hermes_napi_host integration passed to every env this module creates.
-  // Also retained process-wide, as the envs outlive this module on teardown.
+  // Also retained by each of those envs, which outlive this module on
+  // teardown (see HostContext::retainUntilTeardown).
   std::shared_ptr<HostContext> hostContext_;
 
   void loadNodeAddon(facebook::jsi::Runtime &rt, NodeAddon &addon,
-                     const std::string &libraryName);
+                     const std::string &libraryName,
+                     AddonLoadTiming &timing);
 };
 
 } // namespace callstack::react_native_node_api
@@ -0,0 +1,408 @@
+#include "EventLog.hpp"
+#include "Logger.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <new>
+#include <unordered_map>
+
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#if defined(__linux__)
+#include <sys/syscall.h>
+#endif
+
+namespace callstack::react_native_node_api {
+
+namespace {
+
+// Records are written to the file as they are laid out in memory.
+static_assert(std::endian::native == std::endian::little);
+
+constexpr char kMagic[8] = {'R', 'N', 'N', 'A', 'P', 'I', 'E', 'V'};
+constexpr char kFlightRecorderMagic[8] = {'R', 'N', 'N', 'A',
+                                          'P', 'I', 'F', 'R'};
+constexpr uint16_t kFormatVersion = 1;
+
+struct FileHeader {
+  char magic[8];
+  uint16_t version;
+  uint16_t recordSize;
+  uint32_t recordCount;
+  uint32_t stringCount;
+  uint32_t reserved;
+  /// system_clock minus steady_clock when written, in nanoseconds, to turn
+  /// record timestamps into wall-clock times.
+  int64_t realtimeOffset;
+};
+static_assert(sizeof(FileHeader) == 32);
+
+// A seqlock per slot: `sequence` is odd while a writer fills the slot, and
+// 2 * (position + 1) once the record at `position` is complete. The payload
+// is made of relaxed atomics so that a reader racing a writer is merely
+// retried, never undefined behavior.
+struct Slot {
+  std::atomic<uint64_t> sequence{0};
+  std::array<std::atomic<uint64_t>, sizeof(EventRecord) / 8> words{};
+};
+static_assert(sizeof(Slot) == 40);
+
+// The ring lives in memory until the flight recorder starts, and in the
+// recorder's mapped file from then on, where a process killed mid-write
+// leaves the slot's sequence odd and the decoder skips it.
+struct Ring {
+  std::atomic<uint64_t> nextPosition{0};
+  std::array<Slot, kEventLogCapacity> slots;
+};
+static_assert(std::atomic<uint64_t>::is_always_lock_free);
+
+// The start of the flight recorder's file, followed by the Ring and then
+// the strings area. Every offset is from the start of the file.
+struct FlightRecorderHeader {
+  char magic[8];
+  uint16_t version;
+  uint16_t recordSize;
+  uint32_t capacity;
+  /// As in FileHeader, taken when the recorder started.
+  int64_t realtimeOffset;
+  uint32_t pid;
+  uint32_t ringOffset;
+  uint32_t stringsOffset;
+  uint32_t stringsCapacity;
+  /// Bytes of the strings area in use, published after each string.
+  std::atomic<uint32_t> stringsUsed;
+  uint32_t reserved[5];
+};
+static_assert(sizeof(FlightRecorderHeader) == 64);
+
+constexpr size_t kFlightRecorderStringsCapacity = 16 * 1024;
+constexpr size_t kFlightRecorderRingOffset = sizeof(FlightRecorderHeader);
+constexpr size_t kFlightRecorderStringsOffset =
+    kFlightRecorderRingOffset + sizeof(Ring);
+constexpr size_t kFlightRecorderSize =
+    kFlightRecorderStringsOffset + kFlightRecorderStringsCapacity;
+
+struct EventLog {
+  Ring memoryRing;
+  std::atomic<Ring *> ring{&memoryRing};
+
+  std::mutex stringsMutex;
+  std::vector<std::string> strings;
+  std::unordered_map<std::string, int64_t> stringIds;
+  // Set while the flight recorder runs, guarded by stringsMutex.
+  FlightRecorderHeader *recorder = nullptr;
+  // Once a string does not fit the recorder's strings area, later ones are
+  // not written either, as strings are identified by their position.
+  bool recorderStringsFull = false;
+
+  static EventLog &instance() {
+    // Leaked: events may be recorded during static destruction.
+    static auto *log = new EventLog();
+    return *log;
+  }
+};
+
+uint64_t nowNanoseconds() {
+  return static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::steady_clock::now().time_since_epoch())
+          .count());
+}
+
+int64_t realtimeOffset() {
+  const auto realtime = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::system_clock::now().time_since_epoch());
+  return realtime.count() - static_cast<int64_t>(nowNanoseconds());
+}
+
+uint32_t currentThreadId() {
+  thread_local const uint32_t id = [] {
+#if defined(__APPLE__)
+    uint64_t tid = 0;
+    pthread_threadid_np(nullptr, &tid);
+    return static_cast<uint32_t>(tid);
+#elif defined(__linux__)
+    return static_cast<uint32_t>(syscall(SYS_gettid));
+#else
+    return 0u;
+#endif
+  }();
+  return id;
+}
+
+std::vector<EventRecord> readRing(const Ring &ring) {
+  const uint64_t end = ring.nextPosition.load(std::memory_order_acquire);
+  const uint64_t start = end > kEventLogCapacity ? end - kEventLogCapacity : 0;
+  std::vector<EventRecord> records;
+  records.reserve(end - start);
+  for (uint64_t position = start; position < end; position++) {
+    const Slot &slot = ring.slots[position % kEventLogCapacity];
+    const uint64_t before = slot.sequence.load(std::memory_order_acquire);
+    if (before != 2 * (position + 1)) {
+      // Still being written, or already overwritten by a later lap.
+      continue;
+    }
+    uint64_t words[sizeof(EventRecord) / 8];
+    for (size_t i = 0; i < std::size(words); i++) {
+      words[i] = slot.words[i].load(std::memory_order_relaxed);
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (slot.sequence.load(std::memory_order_relaxed) != before) {
+      continue;
+    }
+    EventRecord &record = records.emplace_back();
+    memcpy(&record, words, sizeof(record));
+  }
+  return records;
+}
+
+// Appends `text` to the recorder's strings area. Called with stringsMutex
+// held.
+void appendRecorderString(EventLog &log, const std::string &text) {
+  if (log.recorder == nullptr || log.recorderStringsFull) {
+    return;
+  }
+  FlightRecorderHeader &header = *log.recorder;
+  const uint32_t used = header.stringsUsed.load(std::memory_order_relaxed);
+  const auto length = static_cast<uint32_t>(text.size());
+  if (header.stringsCapacity - used < sizeof(length) + length) {
+    log.recorderStringsFull = true;
+    return;
+  }
+  auto *at = reinterpret_cast<uint8_t *>(log.recorder) + header.stringsOffset +
+             used;
+  memcpy(at, &length, sizeof(length));
+  memcpy(at + sizeof(length), text.data(), length);
+  header.stringsUsed.store(used + sizeof(length) + length,
+                           std::memory_order_release);
+}
+
+} // namespace
+
+void recordEvent(EventId id, int64_t arg0, int64_t arg1) {
+  EventRecord record;
+  record.timestamp = nowNanoseconds();
+  record.id = id;
+  record.thread = currentThreadId();
+  record.args[0] = arg0;
+  record.args[1] = arg1;
+  uint64_t words[sizeof(EventRecord) / 8];
+  memcpy(words, &record, sizeof(record));
+
+  Ring &ring = *EventLog::instance().ring.load(std::memory_order_acquire);
+  const uint64_t position =
+      ring.nextPosition.fetch_add(1, std::memory_order_relaxed);
+  Slot &slot = ring.slots[position % kEventLogCapacity];
+  slot.sequence.store(2 * position + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  for (size_t i = 0; i < std::size(words); i++) {
+    slot.words[i].store(words[i], std::memory_order_relaxed);
+  }
+  slot.sequence.store(2 * (position + 1), std::memory_order_release);
+}
+
+int64_t internEventString(std::string_view text) {
+  EventLog &log = EventLog::instance();
+  std::lock_guard lock(log.stringsMutex);
+  auto [it, inserted] = log.stringIds.emplace(
+      std::string(text), static_cast<int64_t>(log.strings.size()));
+  if (inserted) {
+    log.strings.emplace_back(text);
+    appendRecorderString(log, log.strings.back());
+  }
+  return it->second;
+}
+
+void recordFatalEvent(FatalKind kind, std::string_view message) {
+  // Enough to identify the error without exhausting the flight recorder's
+  // strings area with a long stack.
+  constexpr size_t kMaxMessageLength = 256;
+  recordEvent(EventId::Fatal,
+              internEventString(message.substr(0, kMaxMessageLength)),
+              static_cast<int64_t>(kind));
+}
+
+std::vector<EventRecord> snapshotEvents() {
+  return readRing(*EventLog::instance().ring.load(std::memory_order_acquire));
+}
+
+std::vector<uint8_t> serializeEventLog() {
+  const std::vector<EventRecord> records = snapshotEvents();
+  std::vector<std::string> strings;
+  {
+    EventLog &log = EventLog::instance();
+    std::lock_guard lock(log.stringsMutex);
+    strings = log.strings;
+  }
+
+  FileHeader header{};
+  memcpy(header.magic, kMagic, sizeof(kMagic));
+  header.version = kFormatVersion;
+  header.recordSize = sizeof(EventRecord);
+  header.recordCount = static_cast<uint32_t>(records.size());
+  header.stringCount = static_cast<uint32_t>(strings.size());
+  header.realtimeOffset = realtimeOffset();
+
+  std::vector<uint8_t> bytes(sizeof(header) +
+                             records.size() * sizeof(EventRecord));
+  memcpy(bytes.data(), &header, sizeof(header));
+  if (!records.empty()) {
+    memcpy(bytes.data() + sizeof(header), records.data(),
+           records.size() * sizeof(EventRecord));
+  }
+  // Strings follow as a 32-bit length and that many UTF-8 bytes each, in
+  // order of their ids.
+  for (const std::string &text : strings) {
+    const auto length = static_cast<uint32_t>(text.size());
+    const auto *lengthBytes = reinterpret_cast<const uint8_t *>(&length);
+    bytes.insert(bytes.end(), lengthBytes, lengthBytes + sizeof(length));
+    bytes.insert(bytes.end(), text.begin(), text.end());
+  }
+  return bytes;
+}
+
+bool writeEventLog(const std::string &path) {
+  const std::vector<uint8_t> bytes = serializeEventLog();
+  FILE *file = fopen(path.c_str(), "wb");
+  if (file == nullptr) {
+    return false;
+  }
+  const bool written =
+      fwrite(bytes.data(), 1, bytes.size(), file) == bytes.size();
+  return fclose(file) == 0 && written;
+}
+
+bool startFlightRecorder(const std::string &path) {
+  EventLog &log = EventLog::instance();
+  std::lock_guard lock(log.stringsMutex);
+  if (log.recorder != nullptr) {
+    log_warning("NapiHost: the flight recorder is already running");
+    return false;
+  }
+
+  // Keep the previous run's recording for the app to collect.
+  const std::string previousPath = path + ".previous";
+  if (rename(path.c_str(), previousPath.c_str()) != 0 && errno != ENOENT) {
+    log_warning("NapiHost: failed to keep the previous flight recording: %s",
+                strerror(errno));
+  }
+
+  const int fd = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC,
+                      S_IRUSR | S_IWUSR);
+  if (fd < 0) {
+    log_warning("NapiHost: failed to create the flight recorder file: %s",
+                strerror(errno));
+    return false;
+  }
+  void *mapping = MAP_FAILED;
+  if (ftruncate(fd, kFlightRecorderSize) == 0) {
+    mapping = mmap(nullptr, kFlightRecorderSize, PROT_READ | PROT_WRITE,
+                   MAP_SHARED, fd, 0);
+  }
+  const int mapError = errno;
+  // The mapping keeps the file referenced.
+  close(fd);
+  if (mapping == MAP_FAILED) {
+    log_warning("NapiHost: failed to map the flight recorder file: %s",
+                strerror(mapError));
+    unlink(path.c_str());
+    return false;
+  }
+
+  auto *header = new (mapping) FlightRecorderHeader{};
+  memcpy(header->magic, kFlightRecorderMagic, sizeof(kFlightRecorderMagic));
+  header->version = kFormatVersion;
+  header->recordSize = sizeof(EventRecord);
+  header->capacity = kEventLogCapacity;
+  header->realtimeOffset = realtimeOffset();
+  header->pid = static_cast<uint32_t>(getpid());
+  header->ringOffset = kFlightRecorderRingOffset;
+  header->stringsOffset = kFlightRecorderStringsOffset;
+  header->stringsCapacity = kFlightRecorderStringsCapacity;
+
+  // Carry over what was recorded before the recorder started, slot for
+  // slot. Records made by other threads while this copies may be lost.
+  auto *ring = new (static_cast<uint8_t *>(mapping) + header->ringOffset)
+      Ring();
+  const Ring &memoryRing = log.memoryRing;
+  for (size_t i = 0; i < kEventLogCapacity; i++) {
+    const Slot &from = memoryRing.slots[i];
+    Slot &to = ring->slots[i];
+    for (size_t word = 0; word < from.words.size(); word++) {
+      to.words[word].store(from.words[word].load(std::memory_order_relaxed),
+                           std::memory_order_relaxed);
+    }
+    to.sequence.store(from.sequence.load(std::memory_order_acquire),
+                      std::memory_order_relaxed);
+  }
+  ring->nextPosition.store(
+      memoryRing.nextPosition.load(std::memory_order_acquire),
+      std::memory_order_relaxed);
+
+  log.recorder = header;
+  for (const std::string &text : log.strings) {
+    appendRecorderString(log, text);
+  }
+  log.ring.store(ring, std::memory_order_release);
+  return true;
+}
+
+std::optional<FlightRecording> readFlightRecording(const std::string &path) {
+  FILE *file = fopen(path.c_str(), "rb");
+  if (file == nullptr) {
+    return std::nullopt;
+  }
+  std::vector<uint8_t> bytes(kFlightRecorderSize);
+  const size_t read = fread(bytes.data(), 1, bytes.size(), file);
+  fclose(file);
+  if (read != bytes.size()) {
+    return std::nullopt;
+  }
+  // Copied out of the file, where the recording process is done writing.
+  const auto *header =
+      reinterpret_cast<const FlightRecorderHeader *>(bytes.data());
+  if (memcmp(header->magic, kFlightRecorderMagic,
+             sizeof(kFlightRecorderMagic)) != 0 ||
+      header->version != kFormatVersion ||
+      header->recordSize != sizeof(EventRecord) ||
+      header->capacity != kEventLogCapacity ||
+      header->ringOffset != kFlightRecorderRingOffset ||
+      header->stringsOffset != kFlightRecorderStringsOffset ||
+      header->stringsCapacity != kFlightRecorderStringsCapacity) {
+    return std::nullopt;
+  }
+
+  FlightRecording recording;
+  recording.pid = header->pid;
+  recording.realtimeOffset = header->realtimeOffset;
+  recording.records = readRing(
+      *reinterpret_cast<const Ring *>(bytes.data() + header->ringOffset));
+  const uint8_t *strings = bytes.data() + header->stringsOffset;
+  const uint32_t used = std::min<uint32_t>(
+      header->stringsUsed.load(std::memory_order_relaxed),
+      header->stringsCapacity);
+  for (uint32_t at = 0; at + sizeof(uint32_t) <= used;) {
+    uint32_t length = 0;
+    memcpy(&length, strings + at, sizeof(length));
+    at += sizeof(length);
+    if (length > used - at) {
+      break;
+    }
+    recording.strings.emplace_back(reinterpret_cast<const char *>(strings + at),
+                                   length);
+    at += length;
+  }
+  return recording;
+}
+
+} // namespace callstack::react_native_node_api
@@ -0,0 +1,138 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace callstack::react_native_node_api {
+
+/// What an event log record marks. The numeric values are part of the file
+/// format read by `react-native-node-api decode-events` (see
+/// src/node/event-log.ts): append new ids, never renumber.
+enum class EventId : uint16_t {
+  /// injectIntoWeakNodeApi started, as the first addon loads.
+  InjectBegin = 1,
+  /// weak-node-api was loaded; its injection follows.
+  WeakNodeApiLoaded = 2,
+  InjectEnd = 3,
+  /// loadNodeAddon started. arg0: the addon's name (an event string).
+  AddonLoadBegin = 4,
+  /// The addon's env was created. arg0: the addon's name.
+  AddonEnvCreated = 5,
+  /// The addon's library was opened and initialized. arg0: the addon's name,
+  /// arg1: the napi_status.
+  AddonModuleLoaded = 6,
+  /// loadNodeAddon finished. arg0: the addon's name, arg1: the napi_status.
+  AddonLoadEnd = 7,
+  /// The async work pool started. arg0: its thread count.
+  WorkerPoolStarted = 8,
+  /// napi_queue_async_work. arg0: the addon's name, arg1: the work's address.
+  WorkQueued = 9,
+  /// A worker finished the work's execute. Arguments as for WorkQueued.
+  WorkExecuted = 10,
+  /// The work's complete callback is about to run on the JS thread, with
+  /// napi_ok. Arguments as for WorkQueued.
+  WorkCompleted = 11,
+  /// As WorkCompleted, with napi_cancelled.
+  WorkCancelled = 12,
+  /// A thread-safe function posted a dispatch. arg0: the addon's name,
+  /// arg1: the task's address.
+  TaskPosted = 13,
+  /// The dispatch is about to run on the JS thread. Arguments as for
+  /// TaskPosted.
+  TaskDispatched = 14,
+  /// Something was dropped rather than delivered. arg0: the addon's name,
+  /// arg1: a DroppedKind.
+  Dropped = 15,
+  /// The process is about to abort. arg0: the message (an event string),
+  /// arg1: a FatalKind.
+  Fatal = 16,
+  /// An addon's external memory grew past the budget (see ExternalMemory).
+  /// arg0: the addon's name, arg1: its external memory in bytes.
+  ExternalMemoryOverBudget = 17,
+  /// An addon's library was closed (see AddonLibraries). arg0: the addon's
+  /// name, arg1: 1 if it was unmapped, 0 if the system kept it loaded.
+  AddonUnloaded = 18,
+};
+
+enum class DroppedKind : int64_t {
+  /// An async work queued while already queued.
+  DuplicateWork = 1,
+  /// An async work completion posted after runtime teardown.
+  Completion = 2,
+  /// A thread-safe function dispatch posted after runtime teardown.
+  Task = 3,
+};
+
+enum class FatalKind : int64_t {
+  FatalError = 1,
+  FatalException = 2,
+};
+
+/// A record as stored, and as written to the file (little-endian).
+struct EventRecord {
+  /// steady_clock nanoseconds.
+  uint64_t timestamp = 0;
+  EventId id{};
+  uint16_t reserved = 0;
+  uint32_t thread = 0;
+  int64_t args[2] = {0, 0};
+};
+static_assert(sizeof(EventRecord) == 32);
+
+/// Appends an event to the process-wide event log, a ring of the most recent
+/// kEventLogCapacity records. Lock-free and free of formatting, so cheap
+/// enough to stay enabled in release builds, where log_debug is compiled
+/// out. Callable from any thread.
+void recordEvent(EventId id, int64_t arg0 = 0, int64_t arg1 = 0);
+
+/// Returns a small integer standing for `text` in event arguments, e.g. an
+/// addon's name. Takes a lock, so intern once, off the hot path.
+int64_t internEventString(std::string_view text);
+
+/// Records a Fatal event carrying (the start of) `message`, right before an
+/// abort.
+void recordFatalEvent(FatalKind kind, std::string_view message);
+
+constexpr size_t kEventLogCapacity = 2048;
+
+/// The records still in the ring, oldest first.
+std::vector<EventRecord> snapshotEvents();
+
+/// The event log file: a header, the records of snapshotEvents() and the
+/// interned strings.
+std::vector<uint8_t> serializeEventLog();
+
+/// Writes serializeEventLog() to `path`, returning whether it succeeded.
+bool writeEventLog(const std::string &path);
+
+/// Moves the event log into a file at `path`, memory-mapped and shared with
+/// the kernel, so that every record made from then on is in the file even
+/// if the process aborts or is killed: no write or flush is needed. Records
+/// made earlier are carried over. A file left at `path` by a previous run is
+/// first moved to `path + ".previous"`, for the app to collect with
+/// readFlightRecording or `react-native-node-api decode-events`.
+///
+/// Call it once, early in the app's native startup code (before addons
+/// load), with a path in the app's cache directory. Returns false if the
+/// file cannot be mapped, or the recorder already runs.
+bool startFlightRecorder(const std::string &path);
+
+struct FlightRecording {
+  /// The recording process.
+  uint32_t pid = 0;
+  /// As in the event log file, taken when the recorder started.
+  int64_t realtimeOffset = 0;
+  /// Oldest first. A record torn by the process dying mid-write is omitted.
+  std::vector<EventRecord> records;
+  /// Event strings by id. Ids past the end were not recorded.
+  std::vector<std::string> strings;
+};
+
+/// Reads a file written by startFlightRecorder, typically the previous
+/// run's. Returns nullopt if it is missing or not a flight recording.
+std::optional<FlightRecording> readFlightRecording(const std::string &path);
+
+} // namespace callstack::react_native_node_api
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <node_api.h>
+
+#include <memory>
+
+namespace callstack::react_native_node_api {
+
+/// Exposes the bytes of `buffer` to `env` as an external ArrayBuffer, without
+/// copying them. `Buffer` is any type with `data()` and `size()` accessors,
+/// such as jsi::MutableBuffer or a std::vector wrapper. The ArrayBuffer
+/// shares ownership of `buffer`: its finalizer drops that reference once JS
+/// has collected it, and the bytes must stay at the same address until then.
+template <typename Buffer>
+napi_status createExternalArrayBuffer(napi_env env,
+                                      std::shared_ptr<Buffer> buffer,
+                                      napi_value *result) {
+  if (buffer == nullptr || result == nullptr) {
+    return napi_invalid_arg;
+  }
+  auto *owner = new std::shared_ptr<Buffer>(std::move(buffer));
+  const napi_status status = napi_create_external_arraybuffer(
+      env, (*owner)->data(), (*owner)->size(),
+      [](napi_env, void *, void *hint) {
+        delete static_cast<std::shared_ptr<Buffer> *>(hint);
+      },
+      owner, result);
+  if (status != napi_ok) {
+    // No ArrayBuffer, so no finalizer will ever run.
+    delete owner;
+  }
+  return status;
+}
+
+} // namespace callstack::react_native_node_api
@@ -0,0 +1,174 @@
+#include "ExternalMemory.hpp"
+#include "EventLog.hpp"
+#include "Logger.hpp"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+namespace callstack::react_native_node_api {
+
+namespace {
+
+struct Account {
+  std::string owner;
+  int64_t ownerEvent = 0;
+  std::atomic<int64_t> current{0};
+  std::atomic<int64_t> peak{0};
+  // Set while `current` is past the budget, so each crossing warns once.
+  std::atomic<bool> overBudget{false};
+};
+
+// What a live env has reported towards its addon's account.
+struct EnvAccount {
+  // Accounts are never freed, so this stays valid.
+  Account *account = nullptr;
+  // The env's share of the account's `current`.
+  std::atomic<int64_t> outstanding{0};
+};
+
+struct Accounts {
+  std::mutex mutex;
+  std::unordered_map<std::string, std::unique_ptr<Account>> byOwner;
+  // Live envs only: an env is erased as it is torn down. Shared with the
+  // thread caches, which may still hold an erased env's entry.
+  std::unordered_map<napi_env, std::shared_ptr<EnvAccount>> byEnv;
+  // Bumped on every registration and teardown, invalidating the thread
+  // caches: an env's address may be reused by a later env of another addon.
+  std::atomic<uint64_t> generation{1};
+  std::atomic<int64_t> budget{0};
+
+  static Accounts &instance() {
+    // Leaked: finalizers may adjust external memory during static
+    // destruction.
+    static auto *accounts = new Accounts();
+    return *accounts;
+  }
+};
+
+struct CachedLookup {
+  napi_env env = nullptr;
+  std::shared_ptr<EnvAccount> envAccount;
+  uint64_t generation = 0;
+};
+
+EnvAccount *envAccountFor(napi_env env) {
+  thread_local CachedLookup cached;
+  Accounts &accounts = Accounts::instance();
+  const uint64_t generation =
+      accounts.generation.load(std::memory_order_acquire);
+  if (cached.env == env && cached.generation == generation) {
+    return cached.envAccount.get();
+  }
+  std::lock_guard lock(accounts.mutex);
+  auto it = accounts.byEnv.find(env);
+  cached = CachedLookup{
+      .env = env,
+      .envAccount = it != accounts.byEnv.end() ? it->second : nullptr,
+      .generation = generation,
+  };
+  return cached.envAccount.get();
+}
+
+// Registered by registerEnv: stops attributing the env as it is torn down,
+// before its address can be reused. The runtime finalizes the env's objects
+// as it is destroyed, so what the env still holds is given back here, ahead
+// of the (no longer attributed) adjustments of those finalizers.
+void releaseEnv(void *arg) {
+  auto env = static_cast<napi_env>(arg);
+  Accounts &accounts = Accounts::instance();
+  std::lock_guard lock(accounts.mutex);
+  auto it = accounts.byEnv.find(env);
+  if (it == accounts.byEnv.end()) {
+    return;
+  }
+  EnvAccount &envAccount = *it->second;
+  const int64_t outstanding =
+      envAccount.outstanding.exchange(0, std::memory_order_relaxed);
+  envAccount.account->current.fetch_sub(outstanding,
+                                        std::memory_order_relaxed);
+  accounts.byEnv.erase(it);
+  accounts.generation.fetch_add(1, std::memory_order_release);
+}
+
+void checkBudget(Account &account, int64_t current) {
+  const int64_t budget =
+      Accounts::instance().budget.load(std::memory_order_relaxed);
+  if (budget <= 0 || current <= budget) {
+    if (account.overBudget.load(std::memory_order_relaxed)) {
+      account.overBudget.store(false, std::memory_order_relaxed);
+    }
+    return;
+  }
+  if (!account.overBudget.exchange(true, std::memory_order_relaxed)) {
+    recordEvent(EventId::ExternalMemoryOverBudget, account.ownerEvent,
+                current);
+    log_warning("NapiHost: '%s' holds %lld bytes of external memory, over "
+                "the budget of %lld bytes",
+                account.owner.c_str(), static_cast<long long>(current),
+                static_cast<long long>(budget));
+  }
+}
+
+} // namespace
+
+void ExternalMemory::registerEnv(napi_env env, const std::string &owner) {
+  Accounts &accounts = Accounts::instance();
+  std::lock_guard lock(accounts.mutex);
+  auto &account = accounts.byOwner[owner];
+  if (!account) {
+    account = std::make_unique<Account>();
+    account->owner = owner;
+    account->ownerEvent = internEventString(owner);
+  }
+  auto &envAccount = accounts.byEnv[env];
+  if (!envAccount &&
+      napi_add_env_cleanup_hook(env, releaseEnv, env) != napi_ok) {
+    // Never erased otherwise: leave the env unattributed instead.
+    accounts.byEnv.erase(env);
+    log_warning("NapiHost: not accounting the external memory of '%s'",
+                owner.c_str());
+    return;
+  }
+  envAccount = std::make_shared<EnvAccount>();
+  envAccount->account = account.get();
+  accounts.generation.fetch_add(1, std::memory_order_release);
+}
+
+void ExternalMemory::adjust(napi_env env, int64_t change) {
+  EnvAccount *envAccount = envAccountFor(env);
+  if (envAccount == nullptr) {
+    return;
+  }
+  envAccount->outstanding.fetch_add(change, std::memory_order_relaxed);
+  Account *account = envAccount->account;
+  const int64_t current =
+      account->current.fetch_add(change, std::memory_order_relaxed) + change;
+  int64_t peak = account->peak.load(std::memory_order_relaxed);
+  while (current > peak && !account->peak.compare_exchange_weak(
+                               peak, current, std::memory_order_relaxed)) {
+  }
+  checkBudget(*account, current);
+}
+
+std::vector<ExternalMemory::AddonMemory> ExternalMemory::snapshot() {
+  Accounts &accounts = Accounts::instance();
+  std::lock_guard lock(accounts.mutex);
+  std::vector<AddonMemory> result;
+  result.reserve(accounts.byOwner.size());
+  for (const auto &[owner, account] : accounts.byOwner) {
+    result.push_back(AddonMemory{
+        .owner = owner,
+        .current = account->current.load(std::memory_order_relaxed),
+        .peak = account->peak.load(std::memory_order_relaxed),
+    });
+  }
+  return result;
+}
+
+void ExternalMemory::setBudget(int64_t bytes) {
+  Accounts::instance().budget.store(bytes, std::memory_order_relaxed);
+}
+
+} // namespace callstack::react_native_node_api
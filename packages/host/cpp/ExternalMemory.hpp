@@ -0,0 +1,46 @@
+#pragma once
+
+#include <node_api.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace callstack::react_native_node_api {
+
+/// Per-addon totals of the external memory addons report through
+/// napi_adjust_external_memory (see RuntimeNodeApi.hpp), which the runtime
+/// only sees as a single number for its GC. Envs are attributed to the addon
+/// they were created for by registerEnv; adjustments made through other envs
+/// are forwarded to the runtime without being counted.
+///
+/// An addon's totals span every env created for it, i.e. every runtime it
+/// was loaded into across reloads. An env stops being attributed as it is
+/// torn down, when what it still holds is given back: the runtime finalizes
+/// its objects as it is destroyed.
+class ExternalMemory {
+public:
+  /// Attributes adjustments made through `env` to `owner` from now on, until
+  /// `env` is torn down (through an env cleanup hook).
+  static void registerEnv(napi_env env, const std::string &owner);
+
+  /// Counts `change` bytes towards the addon owning `env`. Callable from any
+  /// thread; a lookup of the env's addon is cached per thread.
+  static void adjust(napi_env env, int64_t change);
+
+  struct AddonMemory {
+    std::string owner;
+    /// Bytes currently reported.
+    int64_t current = 0;
+    /// The highest `current` has been.
+    int64_t peak = 0;
+  };
+  static std::vector<AddonMemory> snapshot();
+
+  /// Warns (and records an ExternalMemoryOverBudget event) whenever an
+  /// addon's external memory grows past `bytes`, once per crossing. 0, the
+  /// default, disables the warning.
+  static void setBudget(int64_t bytes);
+};
+
+} // namespace callstack::react_native_node_api
@@ -1,6 +1,11 @@
 #include "HermesNapiHost.hpp"
+#include "EventLog.hpp"
 #include "Logger.hpp"
+#include "PropertyKeyCache.hpp"
+#include "ThreadPolicy.hpp"
 
+#include <array>
+#include <atomic>
 #include <condition_variable>
 #include <cstdlib>
 #include <deque>
@@ -10,24 +15,130 @@
 #include <thread>
 #include <vector>
 
+#include <time.h>
+
 namespace callstack::react_native_node_api {
 namespace {
 
+using StallReport = HostContext::StallReport;
+using WatchdogOptions = HostContext::WatchdogOptions;
+using Clock = std::chrono::steady_clock;
+using UsageCounters = HostContext::UsageCounters;
+
 struct WorkItem {
-  // Identifies the HostContext that posted the item; matched together with
-  // workData on cancellation. All envs of one runtime share one context, so
-  // the pair only disambiguates across runtimes (i.e. reloads), where a freed
-  // napi_async_work address could be reused by a new runtime's env.
+  // Identifies the host struct (one per addon and HostContext, never freed)
+  // the item was posted through; matched together with workData on
+  // cancellation. The pair disambiguates across envs and runtimes (i.e.
+  // reloads), where a freed napi_async_work address could be reused.
   void *loopData = nullptr;
-  // Held strongly: contexts are retained for the process lifetime anyway, and
-  // whether the item's runtime can still receive its completion is reported
-  // by the context's dispatcher, not by this pointer's liveness.
+  // Held strongly until the item completes: whether the item's runtime can
+  // still receive its completion is reported by the context's dispatcher,
+  // not by this pointer's liveness.
   std::shared_ptr<HostContext> context;
+  // The addon that posted the item, for watchdog reports. Points into the
+  // context's binding for that addon, so it is valid while `context` is held.
+  const std::string *owner = nullptr;
+  // `owner` as an event string.
+  int64_t ownerEvent = 0;
+  // The owner's usage, also in the context's binding.
+  UsageCounters *usage = nullptr;
   void *workData = nullptr;
   void (*execute)(void *work_data) = nullptr;
   void (*complete)(void *work_data, napi_status status) = nullptr;
 };
 
+// The policy the pool's workers apply to themselves when they start. Leaked,
+// like the pool, so it is still valid for workers started during shutdown.
+struct WorkerPoolConfig {
+  std::mutex mutex;
+  ThreadPolicy policy;
+  bool started = false;
+
+  static WorkerPoolConfig &instance() {
+    static WorkerPoolConfig *config = new WorkerPoolConfig();
+    return *config;
+  }
+};
+
+// Process-wide watchdog state. Leaked like the pool: the watchdog thread is
+// detached and may still be running while statics are destroyed.
+struct WatchdogState {
+  std::mutex mutex;
+  std::condition_variable cv;
+  // Read without the mutex on every post and dispatch, so tracking is
+  // skipped cheaply while the watchdog is disabled.
+  std::atomic<bool> enabled{false};
+  std::optional<WatchdogOptions> options;
+  // Bumped on every (re)configuration, to cut the current interval short.
+  uint64_t generation = 0;
+  bool threadStarted = false;
+  std::vector<std::weak_ptr<HostContext>> contexts;
+
+  static WatchdogState &instance() {
+    static WatchdogState *state = new WatchdogState();
+    return *state;
+  }
+
+  static bool isEnabled() {
+    return instance().enabled.load(std::memory_order_relaxed);
+  }
+};
+
+void logStall(const StallReport &report) {
+  const char *owner =
+      report.owner.empty() ? "(unattributed)" : report.owner.c_str();
+  const auto ageMs = static_cast<long long>(report.age.count());
+  switch (report.kind) {
+  case StallReport::Kind::Execute:
+    log_warning("NapiHost: async work %p of '%s' has been executing for "
+                "%lld ms",
+                report.data, owner, ageMs);
+    break;
+  case StallReport::Kind::Completion:
+    log_warning("NapiHost: the completion of async work %p of '%s' has "
+                "waited %lld ms for the JS thread (%zu dispatches pending)",
+                report.data, owner, ageMs, report.backlog);
+    break;
+  case StallReport::Kind::Task:
+    log_warning("NapiHost: thread-safe function dispatch %p of '%s' has "
+                "waited %lld ms for the JS thread (%zu dispatches pending)",
+                report.data, owner, ageMs, report.backlog);
+    break;
+  }
+}
+
+uint64_t nowNanoseconds() {
+  return static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+          Clock::now().time_since_epoch())
+          .count());
+}
+
+// CPU time of the calling thread, which unlike wall time excludes the time
+// execute spent blocked or preempted.
+uint64_t threadCpuNanoseconds() {
+  timespec time{};
+  clock_gettime(CLOCK_THREAD_CPUTIME_ID, &time);
+  return static_cast<uint64_t>(time.tv_sec) * 1'000'000'000 +
+         static_cast<uint64_t>(time.tv_nsec);
+}
+
+void addUsage(std::atomic<uint64_t> &count, std::atomic<uint64_t> &total,
+              uint64_t nanoseconds) {
+  count.fetch_add(1, std::memory_order_relaxed);
+  total.fetch_add(nanoseconds, std::memory_order_relaxed);
+}
+
+int64_t eventAddress(const void *pointer) {
+  return static_cast<int64_t>(reinterpret_cast<intptr_t>(pointer));
+}
+
+bool isWorkerPoolStarted() {
+  auto &config = WorkerPoolConfig::instance();
+  std::lock_guard lock(config.mutex);
+  return config.started;
+}
+
 class WorkerPool {
 public:
   static WorkerPool &instance() {
@@ -52,6 +163,8 @@ public:
           log_warning("NapiHost: dropping napi_async_work %p, queued while "
                       "already queued",
               item.workData);
+          recordEvent(EventId::Dropped, item.ownerEvent,
+                      static_cast<int64_t>(DroppedKind::DuplicateWork));
           return;
         }
       }
@@ -72,6 +185,25 @@ public:
     return false;
   }
 
+  void collectStalledWork(Clock::time_point now, const WatchdogOptions &options,
+                          std::vector<StallReport> &reports) {
+    std::lock_guard lock(mutex_);
+    for (RunningWork &running : running_) {
+      if (!running.tracked || running.reported ||
+          now - running.started < options.executeThreshold) {
+        continue;
+      }
+      running.reported = true;
+      reports.push_back(StallReport{
+          .kind = StallReport::Kind::Execute,
+          .data = running.workData,
+          .owner = running.owner ? *running.owner : std::string(),
+          .age = std::chrono::duration_cast<std::chrono::milliseconds>(
+              now - running.started),
+      });
+    }
+  }
+
 private:
   // libuv's default thread pool size. Keep this below 5: the cancellation
   // tests make cancel-while-queued deterministic by saturating the pool with
@@ -79,40 +211,98 @@ private:
   static constexpr size_t kThreadCount = 4;
 
   WorkerPool() {
+    ThreadPolicy policy;
+    {
+      auto &config = WorkerPoolConfig::instance();
+      std::lock_guard lock(config.mutex);
+      config.started = true;
+      policy = config.policy;
+    }
     for (size_t i = 0; i < kThreadCount; i++) {
-      std::thread([this] { workerMain(); }).detach();
+      std::thread([this, i, policy] { workerMain(i, policy); }).detach();
     }
+    recordEvent(EventId::WorkerPoolStarted, kThreadCount);
   }
 
-  void workerMain() {
+  void workerMain(size_t index, const ThreadPolicy &policy) {
+    setCurrentThreadName("napi-worker-" + std::to_string(index));
+    applyThreadPolicy(policy);
     for (;;) {
       WorkItem item;
+      bool tracked = false;
       {
         std::unique_lock lock(mutex_);
         cv_.wait(lock, [this] { return !queue_.empty(); });
         item = std::move(queue_.front());
         queue_.pop_front();
+        tracked = WatchdogState::isEnabled();
+        if (tracked) {
+          running_[index] = RunningWork{
+              .tracked = true,
+              .owner = item.owner,
+              .workData = item.workData,
+              .started = Clock::now(),
+          };
+        }
       }
       // An item is either popped here (execute runs, complete gets napi_ok)
       // or removed by tryRemove (complete gets napi_cancelled) — never both,
       // as both happen under the queue mutex.
+      const uint64_t wallStart = nowNanoseconds();
+      const uint64_t cpuStart = threadCpuNanoseconds();
       item.execute(item.workData);
+      item.usage->executeCpuTime.fetch_add(threadCpuNanoseconds() - cpuStart,
+                                           std::memory_order_relaxed);
+      addUsage(item.usage->executions, item.usage->executeWallTime,
+               nowNanoseconds() - wallStart);
+      recordEvent(EventId::WorkExecuted, item.ownerEvent,
+                  eventAddress(item.workData));
+      if (tracked) {
+        std::lock_guard lock(mutex_);
+        running_[index] = RunningWork{};
+      }
+      // The context is captured to keep the binding `usage` points into.
       bool accepted = item.context->dispatchToJs(
-          [workData = item.workData, complete = item.complete] {
+          [workData = item.workData, complete = item.complete,
+           ownerEvent = item.ownerEvent, usage = item.usage,
+           context = item.context] {
+            recordEvent(EventId::WorkCompleted, ownerEvent,
+                        eventAddress(workData));
+            const uint64_t start = nowNanoseconds();
             // No pool state refers to workData at this point, so the
             // complete callback is free to napi_delete_async_work it.
             complete(workData, napi_ok);
+            addUsage(usage->completions, usage->completeTime,
+                     nowNanoseconds() - start);
+          },
+          {
+              .kind = StallReport::Kind::Completion,
+              .data = item.workData,
+              .owner = item.owner,
           });
       if (!accepted) {
         log_warning("NapiHost: dropping an async work completion posted after "
                     "runtime teardown");
+        recordEvent(EventId::Dropped, item.ownerEvent,
+                    static_cast<int64_t>(DroppedKind::Completion));
       }
     }
   }
 
+  // What a worker is executing, recorded while the watchdog is enabled.
+  struct RunningWork {
+    bool tracked = false;
+    bool reported = false;
+    const std::string *owner = nullptr;
+    void *workData = nullptr;
+    Clock::time_point started;
+  };
+
   std::mutex mutex_;
   std::condition_variable cv_;
   std::deque<WorkItem> queue_;
+  // Indexed by worker, guarded by mutex_.
+  std::array<RunningWork, kThreadCount> running_{};
 };
 
 std::optional<std::string> stringValue(napi_env env, napi_value value) {
@@ -134,7 +324,8 @@ std::string describeError(napi_env env, napi_value err) {
   // right before an abort and must not assume anything about the value.
   napi_value stack = nullptr;
   napi_valuetype type = napi_undefined;
-  if (napi_get_named_property(env, err, "stack", &stack) == napi_ok &&
+  if (PropertyKeyCache::getNamedProperty(env, err, "stack", &stack) ==
+          napi_ok &&
       napi_typeof(env, stack, &type) == napi_ok && type == napi_string) {
     if (auto text = stringValue(env, stack)) {
       return *text;
@@ -152,7 +343,9 @@ std::string describeError(napi_env env, napi_value err) {
 // Stringifies `err`, logs it and aborts — the pre-#402 behavior, kept as the
 // fallback for whenever routing through ErrorUtils isn't possible.
 [[noreturn]] void abortWithFatalException(napi_env env, napi_value err) {
-  log_error("napi_fatal_exception: %s", describeError(env, err).c_str());
+  const std::string description = describeError(env, err);
+  recordFatalEvent(FatalKind::FatalException, description);
+  log_error("napi_fatal_exception: %s", description.c_str());
   abort();
 }
 
@@ -173,16 +366,16 @@ bool tryReportFatalError(napi_env env, napi_value err) {
 
   napi_valuetype type = napi_undefined;
   napi_value error_utils = nullptr;
-  if (napi_get_named_property(env, global, "ErrorUtils", &error_utils) !=
-          napi_ok ||
+  if (PropertyKeyCache::getNamedProperty(env, global, "ErrorUtils",
+                                        &error_utils) != napi_ok ||
       napi_typeof(env, error_utils, &type) != napi_ok ||
       type != napi_object) {
     return false;
   }
 
   napi_value report_fatal_error = nullptr;
-  if (napi_get_named_property(env, error_utils, "reportFatalError",
-                              &report_fatal_error) != napi_ok ||
+  if (PropertyKeyCache::getNamedProperty(env, error_utils, "reportFatalError",
+                                        &report_fatal_error) != napi_ok ||
       napi_typeof(env, report_fatal_error, &type) != napi_ok ||
       type != napi_function) {
     return false;
@@ -209,45 +402,291 @@ bool tryReportFatalError(napi_env env, napi_value err) {
 } // namespace
 
 HostContext::HostContext(JsDispatcher dispatchToJs)
-    : dispatchToJs_(std::move(dispatchToJs)),
-      host_{
-          .post_work = &HostContext::postWork,
-          // Hermes null-checks only the host pointer itself before invoking
-          // post_work and cancel_work, so neither may individually be null.
-          .cancel_work = &HostContext::cancelWork,
-          .post_task = &HostContext::postTask,
-          .data = this,
-          // React Native has no libuv loop: napi_get_uv_event_loop() returns
-          // napi_generic_failure, as upstream documents for non-Node hosts.
-          .uv_loop = nullptr,
-          .fatal_exception = &HostContext::fatalException,
-          // The JS thread outlives every producer thread, so there is no loop
-          // lifetime to model: tsfn ref/unref are tracked by Hermes but inert.
-          .ref_loop = nullptr,
-          .unref_loop = nullptr,
-      } {}
+    : dispatchToJs_(std::move(dispatchToJs)) {}
 
 std::shared_ptr<HostContext> HostContext::create(JsDispatcher dispatchToJs) {
-  return std::shared_ptr<HostContext>(new HostContext(std::move(dispatchToJs)));
+  auto context =
+      std::shared_ptr<HostContext>(new HostContext(std::move(dispatchToJs)));
+  auto &watchdog = WatchdogState::instance();
+  std::lock_guard lock(watchdog.mutex);
+  // Registered whether or not the watchdog is enabled yet, so it sees every
+  // runtime once it is.
+  std::erase_if(watchdog.contexts, [](const std::weak_ptr<HostContext> &weak) {
+    return weak.expired();
+  });
+  watchdog.contexts.push_back(context);
+  return context;
+}
+
+struct HostContext::Record {
+  hermes_napi_host host{};
+  std::weak_ptr<HostContext> context;
+  // Only dereferenced while `context` can be locked.
+  Binding *binding = nullptr;
+  // The binding's ownerEvent, for events about calls made after it is gone.
+  int64_t ownerEvent = 0;
+};
+
+hermes_napi_host *HostContext::host(const std::string &owner) {
+  std::lock_guard lock(bindingsMutex_);
+  auto [it, inserted] = bindings_.try_emplace(owner);
+  Binding &binding = it->second;
+  if (inserted) {
+    // One record is kept per addon and runtime, i.e. per reload, for the
+    // lifetime of the process.
+    static_assert(sizeof(Record) <= 128);
+    binding.context = this;
+    binding.owner = owner;
+    binding.ownerEvent = internEventString(owner);
+    // Leaked, like the WorkerPool; a deque keeps the records in place as it
+    // grows.
+    static auto *recordsMutex = new std::mutex();
+    static auto *records = new std::deque<Record>();
+    {
+      std::lock_guard recordsLock(*recordsMutex);
+      binding.record = &records->emplace_back();
+    }
+    binding.record->context = weak_from_this();
+    binding.record->binding = &binding;
+    binding.record->ownerEvent = binding.ownerEvent;
+    binding.record->host = hermes_napi_host{
+        .post_work = &HostContext::postWork,
+        // Hermes null-checks only the host pointer itself before invoking
+        // post_work and cancel_work, so neither may individually be null.
+        .cancel_work = &HostContext::cancelWork,
+        .post_task = &HostContext::postTask,
+        .data = binding.record,
+        // React Native has no libuv loop: napi_get_uv_event_loop() returns
+        // napi_generic_failure, as upstream documents for non-Node hosts.
+        .uv_loop = nullptr,
+        .fatal_exception = &HostContext::fatalException,
+        // The JS thread outlives every producer thread, so there is no loop
+        // lifetime to model: tsfn ref/unref are tracked by Hermes but inert.
+        .ref_loop = nullptr,
+        .unref_loop = nullptr,
+    };
+  }
+  return &binding.record->host;
+}
+
+std::shared_ptr<HostContext> HostContext::contextFor(void *loop_data,
+                                                     Binding *&binding) {
+  const Record &record = *static_cast<const Record *>(loop_data);
+  auto context = record.context.lock();
+  binding = context ? record.binding : nullptr;
+  return context;
+}
+
+int64_t HostContext::ownerEventFor(void *loop_data) {
+  return static_cast<const Record *>(loop_data)->ownerEvent;
 }
 
-void HostContext::retainForProcessLifetime(
-    std::shared_ptr<HostContext> context) {
-  // Leaked for the same reason as the WorkerPool: no safe destruction point.
-  static std::mutex *mutex = new std::mutex();
-  static auto *retained = new std::vector<std::shared_ptr<HostContext>>();
-  std::lock_guard lock(*mutex);
-  retained->push_back(std::move(context));
+std::vector<HostContext::AddonUsage> HostContext::usage() {
+  const auto load = [](const std::atomic<uint64_t> &counter) {
+    return counter.load(std::memory_order_relaxed);
+  };
+  const auto duration = [&](const std::atomic<uint64_t> &counter) {
+    return std::chrono::nanoseconds(load(counter));
+  };
+  std::lock_guard lock(bindingsMutex_);
+  std::vector<AddonUsage> result;
+  result.reserve(bindings_.size());
+  for (const auto &[owner, binding] : bindings_) {
+    const UsageCounters &usage = binding.usage;
+    result.push_back(AddonUsage{
+        .owner = owner,
+        .executions = load(usage.executions),
+        .executeWallTime = duration(usage.executeWallTime),
+        .executeCpuTime = duration(usage.executeCpuTime),
+        .completions = load(usage.completions),
+        .completeTime = duration(usage.completeTime),
+        .taskDispatches = load(usage.taskDispatches),
+        .taskTime = duration(usage.taskTime),
+    });
+  }
+  return result;
+}
+
+bool HostContext::dispatchToJs(std::function<void()> &&fn,
+                               const DispatchSource &source) {
+  if (!WatchdogState::isEnabled()) {
+    return dispatchToJs_(std::move(fn));
+  }
+  uint64_t id = 0;
+  {
+    std::lock_guard lock(pendingMutex_);
+    id = nextDispatchId_++;
+    pending_.emplace(id, PendingDispatch{
+                             .posted = Clock::now(),
+                             .source = source,
+                         });
+  }
+  // Untracked before `fn` runs, as it may free what the report points at
+  // (a completion typically deletes its napi_async_work).
+  bool accepted = dispatchToJs_(
+      [weakSelf = weak_from_this(), id, fn = std::move(fn)] {
+        if (auto self = weakSelf.lock()) {
+          self->untrackDispatch(id);
+        }
+        fn();
+      });
+  if (!accepted) {
+    untrackDispatch(id);
+  }
+  return accepted;
+}
+
+void HostContext::untrackDispatch(uint64_t id) {
+  std::lock_guard lock(pendingMutex_);
+  pending_.erase(id);
+}
+
+void HostContext::collectStalledDispatches(Clock::time_point now,
+                                           const WatchdogOptions &options,
+                                           std::vector<StallReport> &reports) {
+  std::lock_guard lock(pendingMutex_);
+  if (pending_.empty()) {
+    return;
+  }
+  // Dispatches are delivered in order, so only the oldest can be the one
+  // holding the others up.
+  PendingDispatch &oldest = pending_.begin()->second;
+  if (oldest.reported || now - oldest.posted < options.dispatchThreshold) {
+    return;
+  }
+  oldest.reported = true;
+  reports.push_back(StallReport{
+      .kind = oldest.source.kind,
+      .data = oldest.source.data,
+      .owner = oldest.source.owner ? *oldest.source.owner : std::string(),
+      .age = std::chrono::duration_cast<std::chrono::milliseconds>(
+          now - oldest.posted),
+      .backlog = pending_.size(),
+  });
+}
+
+void HostContext::enableWatchdog(WatchdogOptions options) {
+  auto &state = WatchdogState::instance();
+  {
+    std::lock_guard lock(state.mutex);
+    state.options = std::move(options);
+    state.enabled = true;
+    state.generation++;
+    if (!state.threadStarted) {
+      state.threadStarted = true;
+      // Detached and leaked for the same reason as the worker pool.
+      std::thread(&HostContext::watchdogMain).detach();
+    }
+  }
+  state.cv.notify_all();
+}
+
+void HostContext::disableWatchdog() {
+  auto &state = WatchdogState::instance();
+  {
+    std::lock_guard lock(state.mutex);
+    state.options.reset();
+    state.enabled = false;
+    state.generation++;
+  }
+  state.cv.notify_all();
+}
+
+void HostContext::watchdogMain() {
+  setCurrentThreadName("napi-watchdog");
+  auto &state = WatchdogState::instance();
+  std::unique_lock lock(state.mutex);
+  for (;;) {
+    state.cv.wait(lock, [&] { return state.options.has_value(); });
+    const uint64_t generation = state.generation;
+    if (state.cv.wait_for(lock, state.options->interval,
+                          [&] { return state.generation != generation; })) {
+      // Reconfigured (or disabled) mid-interval: start over.
+      continue;
+    }
+    const WatchdogOptions options = *state.options;
+    std::vector<std::shared_ptr<HostContext>> contexts;
+    std::erase_if(state.contexts, [&](const std::weak_ptr<HostContext> &weak) {
+      auto context = weak.lock();
+      if (!context) {
+        return true;
+      }
+      contexts.push_back(std::move(context));
+      return false;
+    });
+    lock.unlock();
+
+    const auto now = Clock::now();
+    std::vector<StallReport> reports;
+    // Asking an unstarted pool would start it.
+    if (isWorkerPoolStarted()) {
+      WorkerPool::instance().collectStalledWork(now, options, reports);
+    }
+    for (const auto &context : contexts) {
+      context->collectStalledDispatches(now, options, reports);
+    }
+    // May release the last reference to a context: done outside the lock.
+    contexts.clear();
+    for (const StallReport &report : reports) {
+      if (options.onStall) {
+        options.onStall(report);
+      } else {
+        logStall(report);
+      }
+    }
+
+    lock.lock();
+  }
+}
+
+void HostContext::retainUntilTeardown(napi_env env) {
+  auto *retained = new std::shared_ptr<HostContext>(shared_from_this());
+  if (napi_add_env_cleanup_hook(
+          env,
+          [](void *arg) {
+            delete static_cast<std::shared_ptr<HostContext> *>(arg);
+          },
+          retained) != napi_ok) {
+    delete retained;
+  }
+}
+
+bool HostContext::setWorkerThreadPolicy(ThreadPolicy policy) {
+  auto &config = WorkerPoolConfig::instance();
+  std::lock_guard lock(config.mutex);
+  if (config.started) {
+    log_warning("NapiHost: ignoring a worker thread policy set after the "
+                "worker pool started");
+    return false;
+  }
+  config.policy = std::move(policy);
+  return true;
 }
 
 void HostContext::postWork(void *loop_data, void *work_data,
                            void (*execute)(void *work_data),
                            void (*complete)(void *work_data,
                                             napi_status status)) noexcept {
-  auto *self = static_cast<HostContext *>(loop_data);
+  Binding *found = nullptr;
+  auto context = contextFor(loop_data, found);
+  if (!context) {
+    // Only reachable once every env of the context is torn down, from
+    // finalizers running during teardown: the completion could never be
+    // delivered anyway.
+    log_warning("NapiHost: dropping work posted after runtime teardown");
+    recordEvent(EventId::Dropped, ownerEventFor(loop_data),
+                static_cast<int64_t>(DroppedKind::Completion));
+    return;
+  }
+  Binding &binding = *found;
+  recordEvent(EventId::WorkQueued, binding.ownerEvent,
+              eventAddress(work_data));
   WorkerPool::instance().enqueue(WorkItem{
       .loopData = loop_data,
-      .context = self->shared_from_this(),
+      .context = std::move(context),
+      .owner = &binding.owner,
+      .ownerEvent = binding.ownerEvent,
+      .usage = &binding.usage,
       .workData = work_data,
       .execute = execute,
       .complete = complete,
@@ -266,16 +705,37 @@ bool HostContext::cancelWork(void *loop_data, void *work_data) noexcept {
   // only reported while the dispatcher accepts the delivery: once the runtime
   // is torn down the complete callback can never run, and claiming success
   // would leave the addon waiting for a complete(napi_cancelled) that never
-  // arrives.
+  // arrives. The context is captured to keep the binding `usage` points into.
   return item.context->dispatchToJs(
-      [workData = item.workData, complete = item.complete] {
+      [workData = item.workData, complete = item.complete,
+       ownerEvent = item.ownerEvent, usage = item.usage,
+       context = item.context] {
+        recordEvent(EventId::WorkCancelled, ownerEvent,
+                    eventAddress(workData));
+        const uint64_t start = nowNanoseconds();
         complete(workData, napi_cancelled);
+        addUsage(usage->completions, usage->completeTime,
+                 nowNanoseconds() - start);
+      },
+      {
+          .kind = StallReport::Kind::Completion,
+          .data = item.workData,
+          .owner = item.owner,
       });
 }
 
 void HostContext::postTask(void *loop_data, void *task_data,
                            void (*callback)(void *task_data)) noexcept {
-  auto *self = static_cast<HostContext *>(loop_data);
+  Binding *found = nullptr;
+  auto context = contextFor(loop_data, found);
+  if (!context) {
+    log_warning("NapiHost: dropping a thread-safe function dispatch posted "
+                "after runtime teardown");
+    recordEvent(EventId::Dropped, ownerEventFor(loop_data),
+                static_cast<int64_t>(DroppedKind::Task));
+    return;
+  }
+  Binding &binding = *found;
   // Thread-safe functions call this from arbitrary producer threads, and
   // Hermes' tsfnDispatch re-posts itself from inside the callback. The
   // dispatcher never runs the callback inline (JS would run off-thread) and
@@ -283,9 +743,27 @@ void HostContext::postTask(void *loop_data, void *task_data,
   // permanently wedge the tsfn, as its dispatch_pending flag stays set. A
   // rejected dispatch therefore implies the runtime (and with it the tsfn's
   // env) is gone, making the wedged flag unobservable.
-  if (!self->dispatchToJs_([task_data, callback] { callback(task_data); })) {
+  recordEvent(EventId::TaskPosted, binding.ownerEvent,
+              eventAddress(task_data));
+  if (!context->dispatchToJs(
+          [task_data, callback, ownerEvent = binding.ownerEvent,
+           usage = &binding.usage, context] {
+            recordEvent(EventId::TaskDispatched, ownerEvent,
+                        eventAddress(task_data));
+            const uint64_t start = nowNanoseconds();
+            callback(task_data);
+            addUsage(usage->taskDispatches, usage->taskTime,
+                     nowNanoseconds() - start);
+          },
+          {
+              .kind = StallReport::Kind::Task,
+              .data = task_data,
+              .owner = &binding.owner,
+          })) {
     log_warning("NapiHost: dropping a thread-safe function dispatch posted "
                 "after runtime teardown");
+    recordEvent(EventId::Dropped, binding.ownerEvent,
+                static_cast<int64_t>(DroppedKind::Task));
   }
 }
 
@@ -305,11 +783,13 @@ void HostContext::fatalException(void *data, napi_env env,
   // whenever an exception escapes a thread-safe function callback, so this
   // is what stands between a throwing tsfn callback and a silent, unhandled
   // abort.
-  auto *self = static_cast<HostContext *>(data);
-  if (self->inFatalException_) {
-    // Reentrant call: the ErrorUtils handler (or something it triggered)
-    // itself hit a fatal exception. Recursing back into reportFatalError
-    // could loop forever, so go straight to the fallback.
+  Binding *binding = nullptr;
+  auto self = contextFor(data, binding);
+  if (!self || self->inFatalException_) {
+    // Raised during teardown, or a reentrant call: the ErrorUtils handler
+    // (or something it triggered) itself hit a fatal exception. Recursing
+    // back into reportFatalError could loop forever, so go straight to the
+    // fallback.
     abortWithFatalException(env, err);
   }
   self->inFatalException_ = true;
@@ -2,8 +2,18 @@
 
 #include <node_api.h>
 
+#include "ThreadPolicy.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
 #include <functional>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 // Mirror of the host-integration interface declared by the vendored Hermes in
 // API/napi/hermes_napi.h. We mirror it here (rather than including that
@@ -75,10 +85,12 @@ namespace callstack::react_native_node_api {
 /// napi_queue_async_work / napi_cancel_async_work and a JS-thread dispatcher
 /// backing thread-safe functions.
 ///
-/// One instance exists per React Native runtime. The JS-thread hop is
-/// type-erased as `JsDispatcher` (backed by CallInvoker::invokeAsync in the
-/// app) so this class has no React Native dependencies and its threading
-/// machinery can be exercised by plain C++ tests.
+/// One instance exists per React Native runtime, handing out one host struct
+/// per addon env so that work can be attributed to the addon that posted it.
+/// The JS-thread hop is type-erased as `JsDispatcher` (backed by
+/// CallInvoker::invokeAsync in the app) so this class has no React Native
+/// dependencies and its threading machinery can be exercised by plain C++
+/// tests.
 class HostContext : public std::enable_shared_from_this<HostContext> {
 public:
   /// Dispatches a function onto the JS thread, returning whether it was
@@ -93,32 +105,169 @@ public:
 
   static std::shared_ptr<HostContext> create(JsDispatcher dispatchToJs);
 
-  /// Keep `context` alive for the remaining lifetime of the process. The
-  /// Hermes env reads the host struct during Runtime teardown *after* running
-  /// env cleanup hooks (napi_env__::shutdown() runs cleanup hooks first, then
+  /// Keeps this context alive until `env` is torn down, through an env
+  /// cleanup hook, so that the runtime's work is served for as long as the
+  /// runtime runs, even once the owner of the context has released it.
+  void retainUntilTeardown(napi_env env);
+
+  /// Sets the scheduling policy of the process-wide worker pool that runs
+  /// every runtime's async work. Workers are named `napi-worker-N` and apply
+  /// the policy to themselves when the pool starts, on the first post_work of
+  /// the process, so this must be called before then (e.g. from the app's
+  /// native startup code) — returns false, and changes nothing, once the pool
+  /// has started. Node-API async work carries no priority of its own, so the
+  /// pool has a single priority class and all workers share the policy.
+  static bool setWorkerThreadPolicy(ThreadPolicy policy);
+
+  /// Something the watchdog (see enableWatchdog) found stuck for longer than
+  /// its configured threshold.
+  struct StallReport {
+    enum class Kind {
+      /// An async work item whose execute is still running on a worker.
+      Execute,
+      /// An async work completion still waiting for the JS thread.
+      Completion,
+      /// A thread-safe function dispatch still waiting for the JS thread.
+      Task,
+    };
+    Kind kind;
+    /// The napi_async_work (Execute, Completion) or tsfn task data (Task).
+    void *data;
+    /// The addon whose env posted the item, or empty if not attributed.
+    std::string owner;
+    /// How long the item has been running or waiting.
+    std::chrono::milliseconds age;
+    /// For JS-thread dispatches: how many dispatches of the same runtime are
+    /// undelivered, including this one. Only the oldest is reported, so a
+    /// completion storm yields a single report carrying the backlog size.
+    size_t backlog = 0;
+  };
+
+  struct WatchdogOptions {
+    std::chrono::milliseconds interval{1000};
+    /// Report async work whose execute has run for longer than this.
+    std::chrono::milliseconds executeThreshold{5000};
+    /// Report the oldest JS-thread dispatch once it has waited this long.
+    std::chrono::milliseconds dispatchThreshold{1000};
+    /// Receives every report, on the watchdog thread. Defaults to logging a
+    /// warning. Each stalled item is reported once.
+    std::function<void(const StallReport &)> onStall;
+  };
+
+  /// Starts (or reconfigures) the process-wide watchdog thread, which
+  /// periodically inspects every runtime's running async work and undelivered
+  /// JS-thread dispatches. Only items posted while it is enabled are tracked:
+  /// tracking costs a lock and a clock read per item, so it is off by default.
+  static void enableWatchdog(WatchdogOptions options);
+  /// Stops tracking new items and reporting. The watchdog thread itself idles
+  /// until re-enabled, as it is never joined, like the worker pool's.
+  static void disableWatchdog();
+
+  /// Time an addon's callbacks spent on the worker pool and on the JS thread,
+  /// since its env was created.
+  struct AddonUsage {
+    std::string owner;
+    /// execute callbacks run, with their wall-clock and thread CPU time.
+    uint64_t executions = 0;
+    std::chrono::nanoseconds executeWallTime{0};
+    std::chrono::nanoseconds executeCpuTime{0};
+    /// complete callbacks run (cancelled ones included), with their time.
+    uint64_t completions = 0;
+    std::chrono::nanoseconds completeTime{0};
+    /// Thread-safe function dispatches run, with their time.
+    uint64_t taskDispatches = 0;
+    std::chrono::nanoseconds taskTime{0};
+  };
+
+  /// The usage of every addon this context hosts, e.g. to find the one
+  /// keeping the worker pool busy. Always counted: it costs a few clock
+  /// reads and relaxed atomic adds per callback.
+  std::vector<AddonUsage> usage();
+
+  /// The running totals behind usage(), in nanoseconds. Updated by workers
+  /// and the JS thread without locking.
+  struct UsageCounters {
+    std::atomic<uint64_t> executions{0};
+    std::atomic<uint64_t> executeWallTime{0};
+    std::atomic<uint64_t> executeCpuTime{0};
+    std::atomic<uint64_t> completions{0};
+    std::atomic<uint64_t> completeTime{0};
+    std::atomic<uint64_t> taskDispatches{0};
+    std::atomic<uint64_t> taskTime{0};
+  };
+
+  /// The struct to pass to hermes_napi_create_env when creating `owner`'s
+  /// env, with `owner` naming the addon in diagnostics. Repeated calls for
+  /// the same owner return the same struct.
+  ///
+  /// The struct outlives this context. The Hermes env reads it during
+  /// Runtime teardown *after* running env cleanup hooks
+  /// (napi_env__::shutdown() runs cleanup hooks first, then
   /// hermes_napi_cleanup_tsfns, which reaches host_->unref_loop through
   /// releaseTsfnLoopRef — verified at the pinned Hermes commit), so no
-  /// cleanup hook can tell us when the last env is truly done with the
-  /// struct. Retaining the context forever guarantees the documented
-  /// contract that the struct outlives every env it was passed to, at the
-  /// cost of a small allocation per React Native runtime (i.e. per reload).
-  static void retainForProcessLifetime(std::shared_ptr<HostContext> context);
+  /// cleanup hook can tell when the last env is truly done with it. Each
+  /// struct is therefore part of a compact record kept for the lifetime of
+  /// the process, which refers to the context weakly: the context itself is
+  /// freed with its last reference, after which work and dispatches posted
+  /// through the struct are dropped, as after runtime teardown.
+  hermes_napi_host *host(const std::string &owner = {});
 
-  /// The struct to pass to hermes_napi_create_env. Owned by this context.
-  hermes_napi_host *host() { return &host_; }
+  /// Identifies a dispatch in watchdog reports.
+  struct DispatchSource {
+    StallReport::Kind kind = StallReport::Kind::Task;
+    void *data = nullptr;
+    const std::string *owner = nullptr;
+  };
 
+  bool dispatchToJs(std::function<void()> &&fn,
+                    const DispatchSource &source);
   bool dispatchToJs(std::function<void()> &&fn) {
-    return dispatchToJs_(std::move(fn));
+    return dispatchToJs(std::move(fn), DispatchSource{});
   }
 
-  // host_.data points at this object and the static callbacks cast it back,
-  // so a copied or moved instance would service callbacks meant for another.
+  // Each host struct's record points at a binding in this object, so a
+  // copied or moved instance would service callbacks meant for another.
   HostContext(const HostContext &) = delete;
   HostContext &operator=(const HostContext &) = delete;
 
 private:
+  /// The part of a binding Hermes holds on to: the host struct, whose data
+  /// points back at the record, and a weak reference to the binding's
+  /// context. Defined in HermesNapiHost.cpp, and never freed.
+  struct Record;
+
+  /// The per-owner state behind a host struct, reached by the static
+  /// callbacks through the struct's record while the context is alive.
+  struct Binding {
+    HostContext *context = nullptr;
+    std::string owner;
+    /// `owner` as an event string (see EventLog.hpp).
+    int64_t ownerEvent = 0;
+    UsageCounters usage;
+    /// Holds the host struct handed to Hermes.
+    Record *record = nullptr;
+  };
+
+  struct PendingDispatch {
+    std::chrono::steady_clock::time_point posted;
+    DispatchSource source;
+    bool reported = false;
+  };
+
   explicit HostContext(JsDispatcher dispatchToJs);
 
+  /// The context a host struct's record refers to, if still alive, and
+  /// with it the record's binding.
+  static std::shared_ptr<HostContext> contextFor(void *loop_data,
+                                                 Binding *&binding);
+  /// The ownerEvent of a host struct's binding, even once it is gone.
+  static int64_t ownerEventFor(void *loop_data);
+  static void watchdogMain();
+  void untrackDispatch(uint64_t id);
+  void collectStalledDispatches(std::chrono::steady_clock::time_point now,
+                                const WatchdogOptions &options,
+                                std::vector<StallReport> &reports);
+
   static void postWork(void *loop_data, void *work_data,
                        void (*execute)(void *work_data),
                        void (*complete)(void *work_data,
@@ -129,7 +278,15 @@ private:
   static void fatalException(void *data, napi_env env, napi_value err) noexcept;
 
   JsDispatcher dispatchToJs_;
-  hermes_napi_host host_;
+  std::mutex bindingsMutex_;
+  // Node-based, so a binding's address (held by its record) stays valid
+  // while other owners are added.
+  std::unordered_map<std::string, Binding> bindings_;
+  // Dispatches posted while the watchdog was enabled and not yet delivered,
+  // keyed by posting order so the first entry is the oldest.
+  std::mutex pendingMutex_;
+  std::map<uint64_t, PendingDispatch> pending_;
+  uint64_t nextDispatchId_ = 0;
   // Reentrancy guard for fatalException(): true for the duration of routing
   // an error through ErrorUtils.reportFatalError. fatalException always runs
   // synchronously on the JS thread (see its doc comment), so a plain member
@@ -0,0 +1,48 @@
+#include "HostExtensions.hpp"
+#include "PropertyKeyCache.hpp"
+
+#include <weak_node_api_extensions_fallback.hpp>
+
+namespace callstack::react_native_node_api {
+
+namespace {
+
+// As weak-node-api's fallbacks, but called from the host: NodeApiCalls'
+// qualified calls reach the runtime's functions directly, and names are
+// looked up through PropertyKeyCache.
+struct HostNodeApiCalls : weak_node_api::NodeApiCalls {
+  static napi_status set_named_property(napi_env env, napi_value object,
+                                        const char *utf8name,
+                                        napi_value value) {
+    return PropertyKeyCache::setNamedProperty(env, object, utf8name, value);
+  }
+};
+
+using Extensions = weak_node_api::ExtensionsOf<HostNodeApiCalls>;
+
+} // namespace
+
+napi_status node_api_ext_get_cb_doubles(napi_env env, napi_callback_info info,
+                                        size_t *argc, double *argv,
+                                        napi_value *this_arg) {
+  return Extensions::node_api_ext_get_cb_doubles(env, info, argc, argv,
+                                                 this_arg);
+}
+
+napi_status node_api_ext_set_named_doubles(napi_env env, napi_value object,
+                                           size_t count,
+                                           const char *const *names,
+                                           const double *values) {
+  return Extensions::node_api_ext_set_named_doubles(env, object, count, names,
+                                                    values);
+}
+
+napi_status node_api_ext_create_float64_array(napi_env env,
+                                              const double *data,
+                                              size_t length,
+                                              napi_value *result) {
+  return Extensions::node_api_ext_create_float64_array(env, data, length,
+                                                       result);
+}
+
+} // namespace callstack::react_native_node_api
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <node_api.h>
+
+namespace callstack::react_native_node_api {
+
+// The host's implementations of weak-node-api's bulk operations (see
+// weak_node_api_extensions.h), which the generated injector passes to it as
+// a NodeApiHostExtensions table. Like the functions of RuntimeNodeApi.hpp,
+// they are declared in this namespace for the injector to resolve each field
+// by unqualified name.
+//
+// An addon calling one of these makes one call through weak-node-api where
+// it would have made one per value. The Node-API calls they stand for are
+// then made from the host, directly into Hermes, and names are looked up
+// through PropertyKeyCache.
+napi_status node_api_ext_get_cb_doubles(napi_env env, napi_callback_info info,
+                                        size_t *argc, double *argv,
+                                        napi_value *this_arg);
+napi_status node_api_ext_set_named_doubles(napi_env env, napi_value object,
+                                           size_t count,
+                                           const char *const *names,
+                                           const double *values);
+napi_status node_api_ext_create_float64_array(napi_env env,
+                                              const double *data,
+                                              size_t length,
+                                              napi_value *result);
+
+} // namespace callstack::react_native_node_api
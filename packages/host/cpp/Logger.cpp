@@ -1,6 +1,22 @@
 #include "Logger.hpp"
+#include "ThreadPolicy.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <cstdarg>
 #include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <sys/uio.h>
+#include <unistd.h>
 
 #if defined(__ANDROID__)
 #include <android/log.h>
@@ -10,14 +26,20 @@
 #endif
 
 namespace {
-constexpr auto LineFormat = "[%s] [NodeApiHost] ";
 
-enum class LogLevel { Debug, Warning, Error };
+using callstack::react_native_node_api::LogLevel;
+using callstack::react_native_node_api::LogSink;
+using callstack::react_native_node_api::setCurrentThreadName;
+using Clock = std::chrono::steady_clock;
+
+constexpr auto LineFormat = "[%s] [NodeApiHost] ";
 
 constexpr std::string_view levelToString(LogLevel level) {
   switch (level) {
   case LogLevel::Debug:
     return "DEBUG";
+  case LogLevel::Info:
+    return "INFO";
   case LogLevel::Warning:
     return "WARNING";
   case LogLevel::Error:
@@ -32,6 +54,8 @@ constexpr int androidLogLevel(LogLevel level) {
   switch (level) {
   case LogLevel::Debug:
     return ANDROID_LOG_DEBUG;
+  case LogLevel::Info:
+    return ANDROID_LOG_INFO;
   case LogLevel::Warning:
     return ANDROID_LOG_WARN;
   case LogLevel::Error:
@@ -42,23 +66,342 @@ constexpr int androidLogLevel(LogLevel level) {
 }
 #endif
 
-void log_message_internal(LogLevel level, const char *format, va_list args) {
+// Longer queued lines are truncated; the queue holds kSlotCount of them.
+constexpr size_t kMaxLineLength = 255;
+constexpr size_t kSlotCount = 512;
+constexpr size_t kRateLimitEntries = 64;
+// How many entries from its hashed one a call site may take.
+constexpr size_t kRateLimitProbes = 4;
+constexpr auto kRateLimitWindow = std::chrono::seconds(1);
+// Bounds how long a line can wait for the logger thread when its wake-up
+// raced with the thread going to sleep.
+constexpr auto kFlushInterval = std::chrono::milliseconds(100);
+
 #if defined(__ANDROID__)
-  __android_log_vprint(androidLogLevel(level), LOG_TAG, format, args);
-#elif defined(__APPLE__)
+// logd truncates longer entries, so longer lines are written in pieces.
+constexpr size_t kAndroidEntryLength = 4000;
+#endif
+
+// Writes one line with a single call, so that lines written concurrently
+// (by the logger thread and log_error) never interleave. Never truncates.
+void writeLine(LogLevel level, const char *line, size_t length) {
+#if defined(__ANDROID__)
+  if (length <= kAndroidEntryLength) {
+    __android_log_write(androidLogLevel(level), LOG_TAG, line);
+    return;
+  }
+  char piece[kAndroidEntryLength + 1];
+  for (size_t offset = 0; offset < length; offset += kAndroidEntryLength) {
+    const size_t pieceLength = std::min(kAndroidEntryLength, length - offset);
+    memcpy(piece, line + offset, pieceLength);
+    piece[pieceLength] = '\0';
+    __android_log_write(androidLogLevel(level), LOG_TAG, piece);
+  }
+#else
+  char prefix[32];
+  int prefixLength =
+      snprintf(prefix, sizeof(prefix), LineFormat, levelToString(level).data());
+  if (prefixLength < 0) {
+    prefixLength = 0;
+  }
+  char newline = '\n';
+  iovec parts[] = {
+      {prefix, static_cast<size_t>(prefixLength)},
+      {const_cast<char *>(line), length},
+      {&newline, 1},
+  };
+#if defined(__APPLE__)
   // iOS or macOS
-  const auto level_str = levelToString(level);
-  fprintf(stderr, LineFormat, level_str.data());
-  vfprintf(stderr, format, args);
-  fprintf(stderr, "\n");
+  const int fd = STDERR_FILENO;
 #else
   // Fallback for other platforms
-  const auto level_str = levelToString(level);
-  fprintf(stdout, LineFormat, level_str.data());
-  vfprintf(stdout, format, args);
-  fprintf(stdout, "\n");
+  const int fd = STDOUT_FILENO;
+#endif
+  // Best-effort: there is nowhere left to report a failed log write.
+  (void)!writev(fd, parts, std::size(parts));
 #endif
 }
+
+// Formats into `buffer`, truncating to kMaxLineLength. Returns the length.
+size_t formatLine(char (&buffer)[kMaxLineLength + 1], const char *format,
+                  va_list args) {
+  const int length = vsnprintf(buffer, sizeof(buffer), format, args);
+  if (length < 0) {
+    return 0;
+  }
+  return std::min(static_cast<size_t>(length), kMaxLineLength);
+}
+
+// A bounded multi-producer queue of formatted lines (see StreamChannel in
+// weak-node-api for the same scheme), drained by the logger thread. Producers
+// never block: a full queue drops the line and counts it.
+class Logger {
+public:
+  static Logger &instance() {
+    // Leaked, with a detached thread: lines may still be logged from other
+    // threads during static destruction.
+    static auto *logger = new Logger();
+    return *logger;
+  }
+
+  bool isEnabled(LogLevel level) const {
+    return level >= minLevel.load(std::memory_order_relaxed);
+  }
+
+  // Returns whether a line from `format` may be written now.
+  bool admit(const char *format) {
+    const uint32_t limit = rateLimit.load(std::memory_order_relaxed);
+    if (limit == 0) {
+      return true;
+    }
+    RateLimitEntry *found = entryFor(format);
+    if (found == nullptr) {
+      // Other call sites hold the entries: leave this one unlimited.
+      return true;
+    }
+    RateLimitEntry &entry = *found;
+    rollWindow(entry, Clock::now());
+    if (entry.count.fetch_add(1, std::memory_order_relaxed) < limit) {
+      return true;
+    }
+    entry.suppressed.fetch_add(1, std::memory_order_relaxed);
+    suppressedLines.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+
+  void enqueue(LogLevel level, const char *format, va_list args) {
+    ensureThread();
+    size_t position = writePosition.load(std::memory_order_relaxed);
+    for (;;) {
+      const size_t sequence =
+          slots[position % kSlotCount].sequence.load(std::memory_order_acquire);
+      const auto difference = static_cast<intptr_t>(sequence) -
+                              static_cast<intptr_t>(position);
+      if (difference == 0) {
+        if (writePosition.compare_exchange_weak(position, position + 1,
+                                                std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (difference < 0) {
+        droppedLines.fetch_add(1, std::memory_order_relaxed);
+        return;
+      } else {
+        position = writePosition.load(std::memory_order_relaxed);
+      }
+    }
+    Slot &slot = slots[position % kSlotCount];
+    slot.level = level;
+    slot.length = formatLine(slot.text, format, args);
+    slot.sequence.store(position + 1, std::memory_order_seq_cst);
+    if (sleeping.load(std::memory_order_seq_cst)) {
+      wakeup.notify_one();
+    }
+  }
+
+  void enqueuef(LogLevel level, const char *format, ...) {
+    va_list args;
+    va_start(args, format);
+    enqueue(level, format, args);
+    va_end(args);
+  }
+
+  // Writes `format` right away, after everything queued before it. Unlike
+  // queued lines, never truncated: it often carries the last words (e.g. a
+  // fatal exception's stack) before an abort.
+  void writeNow(LogLevel level, const char *format, va_list args) {
+    va_list measured;
+    va_copy(measured, args);
+    const int needed = vsnprintf(nullptr, 0, format, measured);
+    va_end(measured);
+    char inlineLine[kMaxLineLength + 1];
+    std::vector<char> heapLine;
+    char *line = inlineLine;
+    size_t length = 0;
+    if (needed > 0) {
+      length = static_cast<size_t>(needed);
+      if (length > kMaxLineLength) {
+        heapLine.resize(length + 1);
+        line = heapLine.data();
+      }
+      vsnprintf(line, length + 1, format, args);
+    } else {
+      line[0] = '\0';
+    }
+    std::lock_guard lock(consumerMutex);
+    drainLocked();
+    write(level, line, length);
+  }
+
+  void flush() {
+    std::lock_guard lock(consumerMutex);
+    drainLocked();
+  }
+
+  callstack::react_native_node_api::LogStats stats() {
+    std::lock_guard lock(consumerMutex);
+    drainLocked();
+    return {
+        .written = writtenLines.load(),
+        .dropped = droppedTotal,
+        .suppressed = suppressedLines.load(),
+    };
+  }
+
+  std::atomic<LogLevel> minLevel{LogLevel::Debug};
+  std::atomic<uint32_t> rateLimit{20};
+  std::atomic<LogSink> sink{nullptr};
+
+private:
+  struct Slot {
+    std::atomic<size_t> sequence;
+    LogLevel level;
+    size_t length;
+    char text[kMaxLineLength + 1];
+  };
+
+  // Per call site: how many lines the current window has admitted, and how
+  // many it held back since the last summary.
+  struct RateLimitEntry {
+    std::atomic<const char *> format{nullptr};
+    std::atomic<Clock::rep> windowStart{0};
+    std::atomic<uint32_t> count{0};
+    std::atomic<uint32_t> suppressed{0};
+  };
+
+  Logger() : slots(new Slot[kSlotCount]) {
+    for (size_t i = 0; i < kSlotCount; i++) {
+      slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    // Lines still queued when the process exits normally are written.
+    std::atexit([] { Logger::instance().flush(); });
+  }
+
+  void ensureThread() {
+    std::call_once(threadStarted, [this] {
+      std::thread([this] { run(); }).detach();
+    });
+  }
+
+  // The entry `format` holds, taking a free one if it has none yet. Format
+  // strings are literals, so their addresses are aligned and spaced alike:
+  // they are mixed before picking an entry, and neighbours are tried on a
+  // collision.
+  RateLimitEntry *entryFor(const char *format) {
+    const auto hash = reinterpret_cast<uintptr_t>(format) *
+                      uint64_t{0x9E3779B97F4A7C15};
+    const size_t start = (hash >> 32) % kRateLimitEntries;
+    for (size_t i = 0; i < kRateLimitProbes; i++) {
+      auto &entry = rateLimits[(start + i) % kRateLimitEntries];
+      const char *owner = nullptr;
+      if (entry.format.compare_exchange_strong(owner, format) ||
+          owner == format) {
+        return &entry;
+      }
+    }
+    return nullptr;
+  }
+
+  // Starts a new window once the current one has expired, summarizing what
+  // it held back. Callable from any thread; one caller wins each rollover.
+  void rollWindow(RateLimitEntry &entry, Clock::time_point now) {
+    Clock::rep start = entry.windowStart.load(std::memory_order_relaxed);
+    if (now.time_since_epoch().count() - start <
+            Clock::duration(kRateLimitWindow).count() ||
+        !entry.windowStart.compare_exchange_strong(
+            start, now.time_since_epoch().count())) {
+      return;
+    }
+    entry.count.store(0, std::memory_order_relaxed);
+    if (const uint32_t suppressed = entry.suppressed.exchange(0)) {
+      enqueuef(LogLevel::Warning,
+               "NapiHost: suppressed %u more lines like \"%s\"", suppressed,
+               entry.format.load());
+    }
+  }
+
+  void write(LogLevel level, const char *line, size_t length) {
+    if (LogSink custom = sink.load()) {
+      custom(level, line, length);
+    } else {
+      writeLine(level, line, length);
+    }
+    writtenLines.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  bool hasQueuedLine() const {
+    const size_t position = readPosition.load(std::memory_order_relaxed);
+    return slots[position % kSlotCount].sequence.load(
+               std::memory_order_seq_cst) == position + 1;
+  }
+
+  void drainLocked() {
+    size_t position = readPosition.load(std::memory_order_relaxed);
+    for (;;) {
+      Slot &slot = slots[position % kSlotCount];
+      if (slot.sequence.load(std::memory_order_acquire) != position + 1) {
+        break;
+      }
+      write(slot.level, slot.text, slot.length);
+      slot.sequence.store(position + kSlotCount, std::memory_order_release);
+      position++;
+    }
+    readPosition.store(position, std::memory_order_relaxed);
+    if (const uint64_t dropped = droppedLines.exchange(0)) {
+      char line[kMaxLineLength + 1];
+      const int length = snprintf(line, sizeof(line),
+                                  "NapiHost: dropped %llu log lines",
+                                  static_cast<unsigned long long>(dropped));
+      write(LogLevel::Warning, line, static_cast<size_t>(length));
+      droppedTotal += dropped;
+    }
+  }
+
+  void run() {
+    setCurrentThreadName("napi-logger");
+    for (;;) {
+      flush();
+      const auto now = Clock::now();
+      for (auto &entry : rateLimits) {
+        if (entry.format.load() != nullptr) {
+          rollWindow(entry, now);
+        }
+      }
+      std::unique_lock lock(wakeupMutex);
+      sleeping.store(true, std::memory_order_seq_cst);
+      wakeup.wait_for(lock, kFlushInterval, [this] { return hasQueuedLine(); });
+      sleeping.store(false, std::memory_order_relaxed);
+    }
+  }
+
+  std::unique_ptr<Slot[]> slots;
+  alignas(64) std::atomic<size_t> writePosition{0};
+  // Only advanced under consumerMutex.
+  alignas(64) std::atomic<size_t> readPosition{0};
+  std::mutex consumerMutex;
+  std::once_flag threadStarted;
+  std::mutex wakeupMutex;
+  std::condition_variable wakeup;
+  std::atomic<bool> sleeping{false};
+  std::array<RateLimitEntry, kRateLimitEntries> rateLimits;
+  std::atomic<uint64_t> writtenLines{0};
+  // Dropped since the last drain, which reports and moves them to
+  // droppedTotal (guarded by consumerMutex).
+  std::atomic<uint64_t> droppedLines{0};
+  uint64_t droppedTotal = 0;
+  std::atomic<uint64_t> suppressedLines{0};
+};
+
+void log_message_internal(LogLevel level, const char *format, va_list args) {
+  Logger &logger = Logger::instance();
+  if (!logger.isEnabled(level)) {
+    return;
+  }
+  if (level == LogLevel::Error) {
+    logger.writeNow(level, format, args);
+  } else if (level == LogLevel::Info || logger.admit(format)) {
+    logger.enqueue(level, format, args);
+  }
+}
 } // anonymous namespace
 
 namespace callstack::react_native_node_api {
@@ -72,6 +415,13 @@ void log_debug(const char *format, ...) {
 }
 #endif
 
+void log_info(const char *format, ...) {
+  va_list args;
+  va_start(args, format);
+  log_message_internal(LogLevel::Info, format, args);
+  va_end(args);
+}
+
 void log_warning(const char *format, ...) {
   va_list args;
   va_start(args, format);
@@ -84,4 +434,16 @@ void log_error(const char *format, ...) {
   log_message_internal(LogLevel::Error, format, args);
   va_end(args);
 }
+
+void setLogLevel(LogLevel level) { Logger::instance().minLevel.store(level); }
+
+void setLogRateLimit(uint32_t linesPerSecond) {
+  Logger::instance().rateLimit.store(linesPerSecond);
+}
+
+void setLogSink(LogSink sink) { Logger::instance().sink.store(sink); }
+
+void flushLogs() { Logger::instance().flush(); }
+
+LogStats logStats() { return Logger::instance().stats(); }
 } // namespace callstack::react_native_node_api
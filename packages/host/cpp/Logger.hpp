@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <string>
 
 namespace callstack::react_native_node_api {
@@ -12,7 +14,47 @@ inline void log_debug(const char *, ...) {}
 void log_debug(const char *format, ...);
 #endif
 
+/// Formats the line on the calling thread and queues it for the logger
+/// thread, so callers never block on the log output. Lines are written
+/// whole, and a line repeated (from the same call site) more often than the
+/// rate limit allows is summarized rather than written again.
+///
+/// Unlike log_debug, kept in release builds: for the few lines worth having
+/// from the field, such as addon load timings. Not rate limited, as a burst
+/// of them (one per addon at startup) is expected.
+void log_info(const char *format, ...);
+/// As log_info, but rate limited.
 void log_warning(const char *format, ...);
+/// Unlike the other levels, written before returning (after every line
+/// queued before it) and never truncated, as it often precedes an abort.
 void log_error(const char *format, ...);
 
+enum class LogLevel { Debug, Info, Warning, Error };
+
+/// Drops lines below `level` before they are formatted. Defaults to Debug.
+void setLogLevel(LogLevel level);
+
+/// How many lines per call site (format string) are written per second
+/// before further ones are counted instead. Defaults to 20; 0 disables the
+/// limit. Info lines and errors are never limited.
+void setLogRateLimit(uint32_t linesPerSecond);
+
+/// Receives every line, one call at a time, instead of logcat or the
+/// standard streams: e.g. to forward them to a crash reporter. Lines carry
+/// no trailing newline. Pass nullptr to restore the default.
+using LogSink = void (*)(LogLevel level, const char *line, size_t length);
+void setLogSink(LogSink sink);
+
+/// Writes every queued line before returning.
+void flushLogs();
+
+struct LogStats {
+  uint64_t written = 0;
+  /// Lines lost because the queue was full.
+  uint64_t dropped = 0;
+  /// Lines held back by the rate limit.
+  uint64_t suppressed = 0;
+};
+LogStats logStats();
+
 } // namespace callstack::react_native_node_api
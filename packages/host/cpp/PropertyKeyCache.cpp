@@ -0,0 +1,188 @@
+#include "PropertyKeyCache.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace callstack::react_native_node_api {
+
+namespace {
+
+struct CachedKey {
+  std::string name;
+  napi_ref key = nullptr;
+};
+
+struct EnvCache {
+  // The generation of the env the keys were created in.
+  uint64_t generation = 0;
+  std::unordered_map<const char *, CachedKey> keys;
+};
+
+// The envs with a cleanup hook registered, shared by every thread. An env is
+// given a new generation when it is first used, so a thread can tell its
+// keys of a torn-down env from those of a new env at the same address.
+struct Generations {
+  std::mutex mutex;
+  std::unordered_map<napi_env, uint64_t> live;
+  uint64_t next = 1;
+  // Bumped by every teardown, for threads to notice with a single load.
+  std::atomic<uint64_t> teardowns{0};
+
+  static Generations &instance() {
+    // Leaked, like the other host singletons: cleanup hooks may run late.
+    static auto *generations = new Generations();
+    return *generations;
+  }
+};
+
+// Each thread keeps the caches of the envs it used and needs no locking,
+// except to drop those of envs torn down since it last looked.
+struct ThreadCaches {
+  uint64_t teardownsSeen = 0;
+  std::unordered_map<napi_env, EnvCache> envs;
+};
+
+thread_local ThreadCaches threadCaches;
+
+// Drops the calling thread's caches of envs torn down on any thread. Their
+// references died with the env, so there is nothing to release.
+void dropStaleCaches() {
+  Generations &generations = Generations::instance();
+  const uint64_t teardowns =
+      generations.teardowns.load(std::memory_order_acquire);
+  if (teardowns == threadCaches.teardownsSeen) {
+    return;
+  }
+  std::lock_guard lock(generations.mutex);
+  std::erase_if(threadCaches.envs, [&](const auto &entry) {
+    auto it = generations.live.find(entry.first);
+    return it == generations.live.end() ||
+           it->second != entry.second.generation;
+  });
+  threadCaches.teardownsSeen = teardowns;
+}
+
+// Registered once per env: ends its generation as the env is torn down,
+// before the address can be reused by another env, and releases the keys
+// cached on the thread tearing it down while the env can still do so.
+void releaseEnvCache(void *arg) {
+  auto env = static_cast<napi_env>(arg);
+  Generations &generations = Generations::instance();
+  {
+    std::lock_guard lock(generations.mutex);
+    generations.live.erase(env);
+    generations.teardowns.fetch_add(1, std::memory_order_release);
+  }
+  auto it = threadCaches.envs.find(env);
+  if (it == threadCaches.envs.end()) {
+    return;
+  }
+  for (auto &[name, cached] : it->second.keys) {
+    napi_delete_reference(env, cached.key);
+  }
+  threadCaches.envs.erase(it);
+}
+
+// Returns the env's cache, or null if it cannot have one.
+EnvCache *cacheFor(napi_env env) {
+  dropStaleCaches();
+  auto it = threadCaches.envs.find(env);
+  if (it != threadCaches.envs.end()) {
+    return &it->second;
+  }
+  Generations &generations = Generations::instance();
+  std::lock_guard lock(generations.mutex);
+  auto [live, inserted] = generations.live.try_emplace(env, 0);
+  if (inserted) {
+    if (napi_add_env_cleanup_hook(env, releaseEnvCache, env) != napi_ok) {
+      generations.live.erase(live);
+      return nullptr;
+    }
+    live->second = generations.next++;
+  }
+  return &threadCaches.envs.emplace(env, EnvCache{live->second, {}})
+              .first->second;
+}
+
+napi_status createKey(napi_env env, const char *name, napi_value *result) {
+  return node_api_create_property_key_utf8(env, name, NAPI_AUTO_LENGTH,
+                                           result);
+}
+
+} // namespace
+
+napi_status PropertyKeyCache::keyFor(napi_env env, const char *name,
+                                     napi_value *result) {
+  if (env == nullptr || name == nullptr || result == nullptr) {
+    return napi_invalid_arg;
+  }
+  EnvCache *envCache = cacheFor(env);
+  if (envCache == nullptr) {
+    return createKey(env, name, result);
+  }
+  auto *cache = &envCache->keys;
+  auto it = cache->find(name);
+  if (it != cache->end()) {
+    if (strcmp(it->second.name.c_str(), name) == 0) {
+      return napi_get_reference_value(env, it->second.key, result);
+    }
+    // The address now holds another name: drop the stale key and re-intern.
+    napi_delete_reference(env, it->second.key);
+    cache->erase(it);
+  }
+  const napi_status status = createKey(env, name, result);
+  if (status != napi_ok || cache->size() >= kMaxEntries) {
+    return status;
+  }
+  napi_ref key = nullptr;
+  // A failure leaves the key usable, just uncached.
+  if (napi_create_reference(env, *result, 1, &key) == napi_ok) {
+    cache->emplace(name, CachedKey{name, key});
+  }
+  return napi_ok;
+}
+
+napi_status PropertyKeyCache::getNamedProperty(napi_env env, napi_value object,
+                                               const char *name,
+                                               napi_value *result) {
+  napi_value key = nullptr;
+  const napi_status status = keyFor(env, name, &key);
+  if (status != napi_ok) {
+    return status;
+  }
+  return napi_get_property(env, object, key, result);
+}
+
+napi_status PropertyKeyCache::setNamedProperty(napi_env env, napi_value object,
+                                               const char *name,
+                                               napi_value value) {
+  napi_value key = nullptr;
+  const napi_status status = keyFor(env, name, &key);
+  if (status != napi_ok) {
+    return status;
+  }
+  return napi_set_property(env, object, key, value);
+}
+
+napi_status PropertyKeyCache::hasNamedProperty(napi_env env, napi_value object,
+                                               const char *name,
+                                               bool *result) {
+  napi_value key = nullptr;
+  const napi_status status = keyFor(env, name, &key);
+  if (status != napi_ok) {
+    return status;
+  }
+  return napi_has_property(env, object, key, result);
+}
+
+size_t PropertyKeyCache::size(napi_env env) {
+  dropStaleCaches();
+  auto it = threadCaches.envs.find(env);
+  return it == threadCaches.envs.end() ? 0 : it->second.keys.size();
+}
+
+} // namespace callstack::react_native_node_api
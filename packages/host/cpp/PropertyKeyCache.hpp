@@ -0,0 +1,44 @@
+#pragma once
+
+#include <node_api.h>
+
+#include <cstddef>
+
+namespace callstack::react_native_node_api {
+
+/// Interned property keys for the C-string names addons and the host look
+/// properties up by: the napi_{get,set,has}_named_property shadows in
+/// RuntimeNodeApi.hpp read through it, as do the host's own lookups. Hermes
+/// has to hash and intern such a name on every napi_get_named_property call;
+/// this cache instead creates the key once per env with
+/// node_api_create_property_key_utf8 and keeps it alive through a reference,
+/// so later calls with the same name only pay for a pointer lookup and a
+/// string comparison.
+///
+/// Names are looked up by address, as callers pass string literals, and
+/// compared by content on every hit, so a buffer reused for a different name
+/// is safe, merely re-interned. Each env caches at most kMaxEntries names;
+/// the rest go uncached. Keys are cached per thread, for the env generation
+/// they were created in: tearing an env down ends its generation, so every
+/// thread drops its keys before a new env at the same address is served.
+class PropertyKeyCache {
+public:
+  static constexpr size_t kMaxEntries = 1024;
+
+  /// Sets `result` to the property key for `name` in `env`, interned on
+  /// first use.
+  static napi_status keyFor(napi_env env, const char *name,
+                            napi_value *result);
+
+  static napi_status getNamedProperty(napi_env env, napi_value object,
+                                      const char *name, napi_value *result);
+  static napi_status setNamedProperty(napi_env env, napi_value object,
+                                      const char *name, napi_value value);
+  static napi_status hasNamedProperty(napi_env env, napi_value object,
+                                      const char *name, bool *result);
+
+  /// How many names `env` has cached on the calling thread.
+  static size_t size(napi_env env);
+};
+
+} // namespace callstack::react_native_node_api
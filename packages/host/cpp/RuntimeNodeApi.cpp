@@ -1,14 +1,69 @@
 #include "RuntimeNodeApi.hpp"
+#include "AddonLibraries.hpp"
+#include "EventLog.hpp"
+#include "ExternalMemory.hpp"
 #include "Logger.hpp"
+#include "PropertyKeyCache.hpp"
+#include "SmallBufferPool.hpp"
 
+#include <cstdint>
 #include <cstdlib>
+#include <cstring>
 
 namespace callstack::react_native_node_api {
 
+namespace {
+
+// Runs when JS collects a pooled Buffer; the hint carries its size class.
+void finalizePooledBuffer(napi_env env, void *data, void *hint) {
+  const auto sizeClass = static_cast<int>(reinterpret_cast<intptr_t>(hint));
+  // Qualified: the runtime's function would be found as well through the
+  // napi_env argument.
+  int64_t adjusted = 0;
+  react_native_node_api::napi_adjust_external_memory(
+      env, -static_cast<int64_t>(SmallBufferPool::blockSize(sizeClass)),
+      &adjusted);
+  SmallBufferPool::instance().release(data, sizeClass);
+}
+
+// Hands a pool block of `length` bytes to JS as a Buffer, returning the block
+// to the pool if that fails. The runtime does not count external memory
+// towards its heap, so the block is reported to its GC explicitly.
+napi_status createPooledBuffer(napi_env env, size_t length, void *block,
+                               int sizeClass, napi_value *result) {
+  const napi_status status = ::napi_create_external_buffer(
+      env, length, block, finalizePooledBuffer,
+      reinterpret_cast<void *>(static_cast<intptr_t>(sizeClass)), result);
+  if (status != napi_ok) {
+    SmallBufferPool::instance().release(block, sizeClass);
+    return status;
+  }
+  int64_t adjusted = 0;
+  react_native_node_api::napi_adjust_external_memory(
+      env, static_cast<int64_t>(SmallBufferPool::blockSize(sizeClass)),
+      &adjusted);
+  return napi_ok;
+}
+
+// Whether a Buffer the pool failed to hand out is worth creating the runtime's
+// way instead: the runtime may refuse external Buffers, but a pending
+// exception would fail the next call just the same.
+bool fallBackFrom(napi_status status) {
+  return status != napi_pending_exception;
+}
+
+} // namespace
+
 // See the comment on the declaration in RuntimeNodeApi.hpp for why this
 // deliberately shadows Hermes' own napi_fatal_error.
 void napi_fatal_error(const char *location, size_t location_len,
                       const char *message, size_t message_len) {
+  if (message != nullptr) {
+    recordFatalEvent(FatalKind::FatalError,
+                     message_len == NAPI_AUTO_LENGTH
+                         ? std::string_view(message)
+                         : std::string_view(message, message_len));
+  }
   if (location && location_len) {
     log_error("Fatal Node-API error: %.*s %.*s", static_cast<int>(location_len),
               location, static_cast<int>(message_len), message);
@@ -19,4 +74,84 @@ void napi_fatal_error(const char *location, size_t location_len,
   abort();
 }
 
+// See the comment on the declarations in RuntimeNodeApi.hpp.
+napi_status napi_create_buffer(napi_env env, size_t length, void **data,
+                               napi_value *result) {
+  const int sizeClass = SmallBufferPool::isEnabled()
+                            ? SmallBufferPool::sizeClassFor(length)
+                            : -1;
+  if (sizeClass < 0 || result == nullptr) {
+    return ::napi_create_buffer(env, length, data, result);
+  }
+  void *block = SmallBufferPool::instance().allocate(sizeClass);
+  // Blocks are reused, and must not leak a previous Buffer's contents.
+  memset(block, 0, length);
+  const napi_status status =
+      createPooledBuffer(env, length, block, sizeClass, result);
+  if (status != napi_ok) {
+    return fallBackFrom(status)
+               ? ::napi_create_buffer(env, length, data, result)
+               : status;
+  }
+  if (data != nullptr) {
+    *data = block;
+  }
+  return napi_ok;
+}
+
+napi_status napi_create_buffer_copy(napi_env env, size_t length,
+                                    const void *data, void **result_data,
+                                    napi_value *result) {
+  const int sizeClass = SmallBufferPool::isEnabled()
+                            ? SmallBufferPool::sizeClassFor(length)
+                            : -1;
+  if (sizeClass < 0 || data == nullptr || result == nullptr) {
+    return ::napi_create_buffer_copy(env, length, data, result_data, result);
+  }
+  void *block = SmallBufferPool::instance().allocate(sizeClass);
+  memcpy(block, data, length);
+  const napi_status status =
+      createPooledBuffer(env, length, block, sizeClass, result);
+  if (status != napi_ok) {
+    return fallBackFrom(status) ? ::napi_create_buffer_copy(
+                                      env, length, data, result_data, result)
+                                : status;
+  }
+  if (result_data != nullptr) {
+    *result_data = block;
+  }
+  return napi_ok;
+}
+
+napi_status napi_get_named_property(napi_env env, napi_value object,
+                                    const char *utf8name, napi_value *result) {
+  return PropertyKeyCache::getNamedProperty(env, object, utf8name, result);
+}
+
+napi_status napi_set_named_property(napi_env env, napi_value object,
+                                    const char *utf8name, napi_value value) {
+  return PropertyKeyCache::setNamedProperty(env, object, utf8name, value);
+}
+
+napi_status napi_has_named_property(napi_env env, napi_value object,
+                                    const char *utf8name, bool *result) {
+  return PropertyKeyCache::hasNamedProperty(env, object, utf8name, result);
+}
+
+void napi_module_register(napi_module *mod) {
+  if (!AddonLibraries::captureRegistration(mod)) {
+    ::napi_module_register(mod);
+  }
+}
+
+napi_status napi_adjust_external_memory(napi_env env, int64_t change_in_bytes,
+                                        int64_t *adjusted_value) {
+  const napi_status status =
+      ::napi_adjust_external_memory(env, change_in_bytes, adjusted_value);
+  if (status == napi_ok) {
+    ExternalMemory::adjust(env, change_in_bytes);
+  }
+  return status;
+}
+
 } // namespace callstack::react_native_node_api
@@ -29,4 +29,34 @@ void __attribute__((noreturn)) napi_fatal_error(const char *location,
                                                 const char *message,
                                                 size_t message_len);
 
+// Shadowed the same way, so that once SmallBufferPool::enable() is called,
+// Buffers of up to SmallBufferPool::kMaxBlockSize bytes are served from the
+// pool's slabs as external Buffers. Until then, for larger or empty Buffers,
+// and whenever the runtime refuses an external Buffer, these forward to
+// Hermes' implementation.
+napi_status napi_create_buffer(napi_env env, size_t length, void **data,
+                               napi_value *result);
+napi_status napi_create_buffer_copy(napi_env env, size_t length,
+                                    const void *data, void **result_data,
+                                    napi_value *result);
+
+// Also shadowed, to look the names addons pass up through PropertyKeyCache
+// rather than have Hermes hash and intern the C string on every call.
+napi_status napi_get_named_property(napi_env env, napi_value object,
+                                    const char *utf8name, napi_value *result);
+napi_status napi_set_named_property(napi_env env, napi_value object,
+                                    const char *utf8name, napi_value value);
+napi_status napi_has_named_property(napi_env env, napi_value object,
+                                    const char *utf8name, bool *result);
+
+// Also shadowed, so that AddonLibraries::open captures the addons a library
+// registers from its static initializers as it loads. Other registrations go
+// to Hermes.
+void napi_module_register(napi_module *mod);
+
+// Also shadowed, to attribute the external memory addons report to them (see
+// ExternalMemory) before forwarding it to the runtime's GC.
+napi_status napi_adjust_external_memory(napi_env env, int64_t change_in_bytes,
+                                        int64_t *adjusted_value);
+
 } // namespace callstack::react_native_node_api
@@ -0,0 +1,81 @@
+#include "SmallBufferPool.hpp"
+
+#include <atomic>
+
+namespace callstack::react_native_node_api {
+
+namespace {
+
+std::atomic<bool> enabled{false};
+
+} // namespace
+
+void SmallBufferPool::enable() { enabled.store(true); }
+
+void SmallBufferPool::disable() { enabled.store(false); }
+
+bool SmallBufferPool::isEnabled() {
+  return enabled.load(std::memory_order_relaxed);
+}
+
+SmallBufferPool &SmallBufferPool::instance() {
+  // Leaked: finalizers of pooled Buffers may still run during process
+  // teardown, after static destructors.
+  static auto *pool = new SmallBufferPool();
+  return *pool;
+}
+
+int SmallBufferPool::sizeClassFor(size_t size) {
+  if (size == 0 || size > kMaxBlockSize) {
+    return -1;
+  }
+  int sizeClass = 0;
+  while (blockSize(sizeClass) < size) {
+    sizeClass++;
+  }
+  return sizeClass;
+}
+
+size_t SmallBufferPool::blockSize(int sizeClass) {
+  return kMinBlockSize << sizeClass;
+}
+
+void *SmallBufferPool::allocate(int sizeClass) {
+  SizeClass &entry = classes_[sizeClass];
+  std::lock_guard lock(entry.mutex);
+  if (entry.free == nullptr) {
+    // Carve a fresh slab into blocks, linked in address order.
+    const size_t size = blockSize(sizeClass);
+    auto &slab = entry.slabs.emplace_back(new std::byte[kSlabSize]);
+    for (size_t offset = kSlabSize; offset >= size; offset -= size) {
+      auto *block = reinterpret_cast<FreeBlock *>(slab.get() + offset - size);
+      block->next = entry.free;
+      entry.free = block;
+    }
+  }
+  FreeBlock *block = entry.free;
+  entry.free = block->next;
+  entry.inUse++;
+  return block;
+}
+
+void SmallBufferPool::release(void *block, int sizeClass) {
+  SizeClass &entry = classes_[sizeClass];
+  std::lock_guard lock(entry.mutex);
+  auto *freeBlock = static_cast<FreeBlock *>(block);
+  freeBlock->next = entry.free;
+  entry.free = freeBlock;
+  entry.inUse--;
+}
+
+SmallBufferPool::Stats SmallBufferPool::stats() {
+  Stats stats;
+  for (auto &entry : classes_) {
+    std::lock_guard lock(entry.mutex);
+    stats.slabBytes += entry.slabs.size() * kSlabSize;
+    stats.blocksInUse += entry.inUse;
+  }
+  return stats;
+}
+
+} // namespace callstack::react_native_node_api
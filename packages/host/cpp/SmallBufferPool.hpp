@@ -0,0 +1,81 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace callstack::react_native_node_api {
+
+/// Size-class slabs serving the small Buffers addons create through
+/// napi_create_buffer and napi_create_buffer_copy (see RuntimeNodeApi.hpp).
+/// Addons that return many short-lived Buffers otherwise cost a malloc/free
+/// pair each; the pool instead hands out blocks carved from 64 KB slabs and
+/// takes them back when the Buffer's finalizer runs.
+///
+/// Slabs are never returned to the system: the pool retains its high-water
+/// mark for the remaining lifetime of the process, like the worker pool.
+class SmallBufferPool {
+public:
+  /// The largest Buffer served from the pool; larger ones go to the runtime.
+  static constexpr size_t kMaxBlockSize = 4096;
+  static constexpr size_t kSlabSize = 64 * 1024;
+
+  /// Opts the process into serving small Buffers from the pool. Off by
+  /// default, as a pooled Buffer is an external one to the runtime, which
+  /// costs a finalizer per Buffer. Buffers created before keep their
+  /// allocator, so this can be toggled at any time.
+  static void enable();
+  static void disable();
+  static bool isEnabled();
+
+  static SmallBufferPool &instance();
+
+  /// The size class index serving `size` bytes, or -1 if `size` is zero or
+  /// larger than kMaxBlockSize.
+  static int sizeClassFor(size_t size);
+  static size_t blockSize(int sizeClass);
+
+  /// Returns an uninitialized block of blockSize(sizeClass) bytes. Callable
+  /// from any thread.
+  void *allocate(int sizeClass);
+  /// Returns a block obtained from allocate(sizeClass). Callable from any
+  /// thread.
+  void release(void *block, int sizeClass);
+
+  struct Stats {
+    /// Bytes held in slabs, whether handed out or not.
+    size_t slabBytes = 0;
+    /// Blocks currently handed out.
+    size_t blocksInUse = 0;
+  };
+  Stats stats();
+
+  SmallBufferPool(const SmallBufferPool &) = delete;
+  SmallBufferPool &operator=(const SmallBufferPool &) = delete;
+
+private:
+  static constexpr size_t kMinBlockSize = 64;
+  // 64, 128, ..., 4096.
+  static constexpr size_t kSizeClassCount = 7;
+
+  // Free blocks link through their own first bytes.
+  struct FreeBlock {
+    FreeBlock *next;
+  };
+
+  // One lock per class keeps Buffers of different sizes from contending.
+  struct SizeClass {
+    std::mutex mutex;
+    FreeBlock *free = nullptr;
+    std::vector<std::unique_ptr<std::byte[]>> slabs;
+    size_t inUse = 0;
+  };
+
+  SmallBufferPool() = default;
+
+  std::array<SizeClass, kSizeClassCount> classes_;
+};
+
+} // namespace callstack::react_native_node_api
@@ -0,0 +1,98 @@
+#include "ThreadPolicy.hpp"
+#include "Logger.hpp"
+
+#include <cerrno>
+#include <cstring>
+
+#include <pthread.h>
+
+#if defined(__APPLE__)
+#include <pthread/qos.h>
+#elif defined(__linux__)
+#include <sched.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace callstack::react_native_node_api {
+
+namespace {
+
+#if defined(__APPLE__)
+// Darwin schedules by QoS class; nice values on individual threads are not
+// honored. The bands follow the priorities the classes map to in the kernel.
+qos_class_t qosClassForNiceValue(int niceValue) {
+  if (niceValue <= -10) {
+    return QOS_CLASS_USER_INTERACTIVE;
+  } else if (niceValue < 0) {
+    return QOS_CLASS_USER_INITIATED;
+  } else if (niceValue == 0) {
+    return QOS_CLASS_DEFAULT;
+  } else if (niceValue < 10) {
+    return QOS_CLASS_UTILITY;
+  }
+  return QOS_CLASS_BACKGROUND;
+}
+#endif
+
+} // namespace
+
+void setCurrentThreadName(const std::string &name) {
+#if defined(__APPLE__)
+  // Darwin only allows a thread to name itself.
+  const int result = pthread_setname_np(name.c_str());
+#elif defined(__linux__)
+  // The kernel's comm field holds 15 characters plus the terminator, and
+  // pthread_setname_np fails with ERANGE rather than truncating.
+  const int result =
+      pthread_setname_np(pthread_self(), name.substr(0, 15).c_str());
+#else
+  const int result = 0;
+#endif
+  if (result != 0) {
+    log_warning("NapiHost: failed to name thread '%s': %s", name.c_str(),
+                strerror(result));
+  }
+}
+
+void applyThreadPolicy(const ThreadPolicy &policy) {
+#if defined(__APPLE__)
+  if (policy.niceValue) {
+    const int result = pthread_set_qos_class_self_np(
+        qosClassForNiceValue(*policy.niceValue), 0);
+    if (result != 0) {
+      log_warning("NapiHost: failed to set thread QoS class: %s",
+                  strerror(result));
+    }
+  }
+#elif defined(__linux__)
+  if (policy.niceValue) {
+    // On Linux, PRIO_PROCESS with a thread id applies to that thread only.
+    const auto tid = static_cast<id_t>(syscall(SYS_gettid));
+    if (setpriority(PRIO_PROCESS, tid, *policy.niceValue) != 0) {
+      log_warning("NapiHost: failed to set thread nice value %d: %s",
+                  *policy.niceValue, strerror(errno));
+    }
+  }
+  if (policy.affinityMask) {
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    for (size_t cpu = 0; cpu < 64 && cpu < CPU_SETSIZE; cpu++) {
+      if (*policy.affinityMask & (uint64_t{1} << cpu)) {
+        CPU_SET(cpu, &cpus);
+      }
+    }
+    // Pid 0 addresses the calling thread.
+    if (sched_setaffinity(0, sizeof(cpus), &cpus) != 0) {
+      log_warning("NapiHost: failed to set thread affinity mask 0x%llx: %s",
+                  static_cast<unsigned long long>(*policy.affinityMask),
+                  strerror(errno));
+    }
+  }
+#else
+  (void)policy;
+#endif
+}
+
+} // namespace callstack::react_native_node_api
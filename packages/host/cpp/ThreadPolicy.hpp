@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+
+namespace callstack::react_native_node_api {
+
+/// Scheduling attributes for a host-owned thread. Unset fields leave the
+/// attribute the thread inherited from its creator untouched.
+struct ThreadPolicy {
+  /// Linux/Android: the thread's nice value (-20..19, lower is more urgent).
+  /// Raising priority (a negative value) typically needs privileges an app
+  /// lacks and is then ignored with a warning. On Apple platforms the value is
+  /// mapped onto the nearest QoS class instead, as the kernel schedules
+  /// threads by QoS rather than by nice value.
+  std::optional<int> niceValue;
+
+  /// Linux/Android: the CPUs the thread may run on, bit N allowing CPU N —
+  /// e.g. to keep latency-sensitive work off the LITTLE cores. Ignored on
+  /// Apple platforms, which have no thread affinity API.
+  std::optional<uint64_t> affinityMask;
+};
+
+/// Names the calling thread, so profilers, systrace and crash reports show
+/// `name` instead of an anonymous thread. Linux and Android truncate names to
+/// 15 characters.
+void setCurrentThreadName(const std::string &name);
+
+/// Applies `policy` to the calling thread. Every platform call is best-effort:
+/// a failure is logged and the remaining attributes are still applied, as a
+/// thread running at the wrong priority beats no thread at all.
+void applyThreadPolicy(const ThreadPolicy &policy);
+
+} // namespace callstack::react_native_node_api
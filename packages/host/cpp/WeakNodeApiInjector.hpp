@@ -1,5 +1,26 @@
+#pragma once
+
 #include <weak_node_api.hpp>
 
+#include <mutex>
+
 namespace callstack::react_native_node_api {
 void injectIntoWeakNodeApi();
+
+/// Injects the host into weak-node-api on the first call: called as the first
+/// addon loads rather than as the app starts, so launches loading no addon
+/// never pay for it. On Android, where the host does not link weak-node-api,
+/// this is also what loads it; Apple apps link its framework, which loads at
+/// launch regardless. Thread-safe: calls
+/// racing the first wait for its injection. Returns whether this call
+/// injected.
+inline bool ensureInjectedIntoWeakNodeApi() {
+  static std::once_flag once;
+  bool injected = false;
+  std::call_once(once, [&injected] {
+    injectIntoWeakNodeApi();
+    injected = true;
+  });
+  return injected;
 }
+} // namespace callstack::react_native_node_api
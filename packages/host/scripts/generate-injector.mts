@@ -2,14 +2,21 @@ import fs from "node:fs";
 import path from "node:path";
 import cp from "node:child_process";
 
-import { type FunctionDecl, getNodeApiFunctions } from "weak-node-api";
+import {
+  type FunctionDecl,
+  getHostExtensionFunctions,
+  getNodeApiFunctions,
+} from "weak-node-api";
 
 export const CPP_SOURCE_PATH = path.join(import.meta.dirname, "../cpp");
 
 /**
  * Generates source code which injects the Node API functions from the host.
  */
-export function generateSource(functions: FunctionDecl[]) {
+export function generateSource(
+  functions: FunctionDecl[],
+  extensions: FunctionDecl[],
+) {
   return `
     // This file is generated by react-native-node-api
     // Versions.hpp must come first so <node_api.h> exposes the full v10 surface.
@@ -18,25 +25,21 @@ export function generateSource(functions: FunctionDecl[]) {
     #include <dlfcn.h>
     #include <weak_node_api.hpp>
 
+    #include <EventLog.hpp>
+    #include <HostExtensions.hpp>
     #include <Logger.hpp>
     #include <RuntimeNodeApi.hpp>
 
-    #if defined(__APPLE__)
-    #define WEAK_NODE_API_LIBRARY_NAME "@rpath/weak-node-api.framework/weak-node-api"
-    #elif defined(__ANDROID__)
-    #define WEAK_NODE_API_LIBRARY_NAME "libweak-node-api.so"
-    #else
-    #error "WEAK_NODE_API_LIBRARY_NAME cannot be defined for this platform"
-    #endif
-
     namespace callstack::react_native_node_api {
 
     void injectIntoWeakNodeApi() {
+    recordEvent(EventId::InjectBegin);
     void *module = dlopen(WEAK_NODE_API_LIBRARY_NAME, RTLD_NOW | RTLD_LOCAL);
     if (nullptr == module) {
       log_debug("NapiHost: Failed to load weak-node-api: %s", dlerror());
       abort();
     }
+    recordEvent(EventId::WeakNodeApiLoaded);
 
     auto inject_weak_node_api_host = (InjectHostFunction)dlsym(
     module, "inject_weak_node_api_host");
@@ -46,9 +49,26 @@ export function generateSource(functions: FunctionDecl[]) {
     }
 
     log_debug("Injecting NodeApiHost");
-    inject_weak_node_api_host(NodeApiHost {
+    const NodeApiHost host {
       ${functions.flatMap(({ name }) => `.${name} = ${name},`).join("\n")}
-      });
+      };
+    // Addons linking weak-node-api statically copy it from there
+    inject_weak_node_api_host(host);
+
+    const NodeApiHostExtensions extensions {
+      .version = NODE_API_HOST_EXTENSIONS_VERSION,
+      ${extensions.flatMap(({ name }) => `.${name} = ${name},`).join("\n")}
+      };
+    auto inject_weak_node_api_host_extensions = (InjectHostExtensionsFunction)dlsym(
+    module, "inject_weak_node_api_host_extensions");
+    if (nullptr == inject_weak_node_api_host_extensions) {
+      // An older weak-node-api, predating the extensions
+      log_debug("NapiHost: weak-node-api takes no host extensions");
+    } else {
+      log_debug("Injecting NodeApiHostExtensions");
+      inject_weak_node_api_host_extensions(extensions);
+    }
+    recordEvent(EventId::InjectEnd);
     }
     } // namespace callstack::react_native_node_api
   `;
@@ -57,7 +77,7 @@ export function generateSource(functions: FunctionDecl[]) {
 async function run() {
   const nodeApiFunctions = getNodeApiFunctions();
 
-  const source = generateSource(nodeApiFunctions);
+  const source = generateSource(nodeApiFunctions, getHostExtensionFunctions());
   const sourcePath = path.join(CPP_SOURCE_PATH, "WeakNodeApiInjector.cpp");
   await fs.promises.writeFile(sourcePath, source, "utf-8");
   cp.spawnSync("clang-format", ["-i", sourcePath], { stdio: "inherit" });
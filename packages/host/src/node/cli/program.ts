@@ -1,4 +1,5 @@
 import assert from "node:assert/strict";
+import fs from "node:fs";
 import path from "node:path";
 
 import {
@@ -10,6 +11,14 @@ import {
   prettyPath,
 } from "@react-native-node-api/cli-utils";
 
+import {
+  findLibraries,
+  formatExportsList,
+  getImportsReport,
+  readHostTableFunctions,
+  readUndefinedSymbols,
+} from "weak-node-api";
+
 import {
   determineModuleContext,
   findNodeApiModulePathsByDependency,
@@ -27,6 +36,7 @@ import { packageNameOption, pathSuffixOption } from "./options";
 import { linkModules, pruneLinkedModules, ModuleLinker } from "./link-modules";
 import { ensureXcodeBuildPhase, createAppleLinker } from "./apple";
 import { linkAndroidDir } from "./android";
+import { decodeEventLog, formatEventLog } from "../event-log";
 
 export const program = new Command("react-native-node-api")
   .addCommand(vendorHermes)
@@ -233,6 +243,89 @@ program
     }),
   );
 
+program
+  .command("decode-events <path>")
+  .description(
+    "Print an event log or flight recording written by the host (see cpp/EventLog.hpp), e.g. one pulled from a release build",
+  )
+  .option("--json", "Print the decoded records as JSON")
+  .action(
+    wrapAction((pathInput, { json }) => {
+      const log = decodeEventLog(fs.readFileSync(path.resolve(pathInput)));
+      if (json) {
+        console.log(
+          JSON.stringify(
+            log,
+            (_, value: unknown) =>
+              typeof value === "bigint" ? value.toString() : value,
+            2,
+          ),
+        );
+      } else {
+        for (const line of formatEventLog(log)) {
+          console.log(line);
+        }
+      }
+    }),
+  );
+
+program
+  .command("report-imports <paths...>")
+  .description(
+    "Report the Node-API functions a set of addons imports, for building a minimal weak-node-api serving only them",
+  )
+  .option(
+    "--exports <path>",
+    "Write the imported functions to a file, to pass the weak-node-api build as WEAK_NODE_API_EXPORTS",
+  )
+  .option("--json", "Output as JSON", false)
+  .action(
+    wrapAction(async (pathInputs, { exports, json }) => {
+      const libraries = pathInputs.flatMap((pathInput) =>
+        findLibraries(path.resolve(pathInput)),
+      );
+      assert(libraries.length > 0, "Found no libraries in the given paths");
+      const report = getImportsReport(
+        Object.fromEntries(
+          libraries.map((library) => [library, readUndefinedSymbols(library)]),
+        ),
+        readHostTableFunctions(),
+      );
+      if (exports) {
+        await fs.promises.writeFile(exports, formatExportsList(report));
+      }
+      if (json) {
+        console.log(JSON.stringify(report, null, 2));
+        return;
+      }
+      console.log(
+        "Found",
+        chalk.greenBright(report.libraries.length),
+        report.libraries.length === 1 ? "library" : "libraries",
+        "importing",
+        chalk.greenBright(report.functions.length),
+        "of",
+        report.fullTableSize,
+        "Node-API functions",
+      );
+      for (const { name, version, importedBy } of report.functions) {
+        console.log(
+          `  ${name}`,
+          chalk.dim(`(v${version}) ←`),
+          importedBy.map((library) => prettyPath(library)).join(", "),
+        );
+      }
+      console.log(
+        "\nA weak-node-api built with",
+        chalk.blueBright(`-D WEAK_NODE_API_VERSION=${report.version}`),
+        exports
+          ? chalk.blueBright(`-D WEAK_NODE_API_EXPORTS=${exports}`)
+          : "(and the list written by --exports)",
+        `serves them with a table of ${report.tableSize} instead of ${report.fullTableSize} functions`,
+      );
+    }),
+  );
+
 program
   .command("patch-xcode-project")
   .description("Patch the Xcode project to include the Node-API build phase")
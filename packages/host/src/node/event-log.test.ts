@@ -0,0 +1,159 @@
+import assert from "node:assert/strict";
+import { describe, it } from "node:test";
+
+import { decodeEventLog, formatEventLog } from "./event-log.js";
+
+type TestRecord = {
+  timestamp: bigint;
+  id: number;
+  thread: number;
+  args: [bigint, bigint];
+};
+
+/** Lays a log out as cpp/EventLog.cpp writes it. */
+function encodeEventLog(records: TestRecord[], strings: string[]) {
+  const header = Buffer.alloc(32);
+  header.write("RNNAPIEV", 0, "latin1");
+  header.writeUInt16LE(1, 8);
+  header.writeUInt16LE(32, 10);
+  header.writeUInt32LE(records.length, 12);
+  header.writeUInt32LE(strings.length, 16);
+  header.writeBigInt64LE(1_000n, 24);
+  const body = records.map(({ timestamp, id, thread, args }) => {
+    const record = Buffer.alloc(32);
+    record.writeBigUInt64LE(timestamp, 0);
+    record.writeUInt16LE(id, 8);
+    record.writeUInt32LE(thread, 12);
+    record.writeBigInt64LE(args[0], 16);
+    record.writeBigInt64LE(args[1], 24);
+    return record;
+  });
+  const tail = strings.map((text) => {
+    const bytes = Buffer.from(text, "utf8");
+    const length = Buffer.alloc(4);
+    length.writeUInt32LE(bytes.length);
+    return Buffer.concat([length, bytes]);
+  });
+  return Buffer.concat([header, ...body, ...tail]);
+}
+
+/** Lays a flight recording out as cpp/EventLog.cpp maps it. */
+function encodeFlightRecording(
+  slots: { sequence: bigint; record: TestRecord }[],
+  strings: string[],
+) {
+  const capacity = slots.length;
+  const ringOffset = 64;
+  const stringsOffset = ringOffset + 8 + capacity * 40;
+  const stringsCapacity = 256;
+  const buffer = Buffer.alloc(stringsOffset + stringsCapacity);
+  buffer.write("RNNAPIFR", 0, "latin1");
+  buffer.writeUInt16LE(1, 8);
+  buffer.writeUInt16LE(32, 10);
+  buffer.writeUInt32LE(capacity, 12);
+  buffer.writeBigInt64LE(0n, 16);
+  buffer.writeUInt32LE(4321, 24);
+  buffer.writeUInt32LE(ringOffset, 28);
+  buffer.writeUInt32LE(stringsOffset, 32);
+  buffer.writeUInt32LE(stringsCapacity, 36);
+  slots.forEach(({ sequence, record }, i) => {
+    const at = ringOffset + 8 + i * 40;
+    buffer.writeBigUInt64LE(sequence, at);
+    buffer.writeBigUInt64LE(record.timestamp, at + 8);
+    buffer.writeUInt16LE(record.id, at + 16);
+    buffer.writeUInt32LE(record.thread, at + 20);
+    buffer.writeBigInt64LE(record.args[0], at + 24);
+    buffer.writeBigInt64LE(record.args[1], at + 32);
+  });
+  let used = 0;
+  for (const text of strings) {
+    const bytes = Buffer.from(text, "utf8");
+    buffer.writeUInt32LE(bytes.length, stringsOffset + used);
+    bytes.copy(buffer, stringsOffset + used + 4);
+    used += 4 + bytes.length;
+  }
+  buffer.writeUInt32LE(used, 40);
+  return buffer;
+}
+
+describe("decodeEventLog", () => {
+  it("decodes records and resolves addon names", () => {
+    const buffer = encodeEventLog(
+      [
+        { timestamp: 5_000_000n, id: 1, thread: 7, args: [0n, 0n] },
+        { timestamp: 6_500_000n, id: 4, thread: 7, args: [1n, 0n] },
+        { timestamp: 9_000_000n, id: 7, thread: 7, args: [1n, 9n] },
+      ],
+      ["other-addon", "my-addon"],
+    );
+    const log = decodeEventLog(buffer);
+    assert.equal(log.version, 1);
+    assert.equal(log.realtimeOffset, 1_000n);
+    assert.deepEqual(log.strings, ["other-addon", "my-addon"]);
+    assert.deepEqual(
+      log.records.map(({ name, subject }) => ({ name, subject })),
+      [
+        { name: "inject-begin", subject: undefined },
+        { name: "addon-load-begin", subject: "my-addon" },
+        { name: "addon-load-end", subject: "my-addon" },
+      ],
+    );
+    assert.deepEqual(formatEventLog(log), [
+      "+0.000ms [7] inject-begin",
+      "+1.500ms [7] addon-load-begin my-addon",
+      "+4.000ms [7] addon-load-end my-addon status=9",
+    ]);
+  });
+
+  it("names unknown events by id", () => {
+    const log = decodeEventLog(
+      encodeEventLog(
+        [{ timestamp: 0n, id: 999, thread: 1, args: [3n, 0n] }],
+        [],
+      ),
+    );
+    assert.equal(log.records[0].name, "unknown-999");
+    assert.deepEqual(formatEventLog(log), ["+0.000ms [1] unknown-999 3"]);
+  });
+
+  it("decodes flight recordings in ring order, skipping torn records", () => {
+    const record = (timestamp: bigint, id: number): TestRecord => ({
+      timestamp,
+      id,
+      thread: 3,
+      args: [0n, 0n],
+    });
+    const buffer = encodeFlightRecording(
+      [
+        // Positions 4 and 5 overwrote 0 and 1 once the ring wrapped.
+        { sequence: 10n, record: record(5_000_000n, 16) },
+        { sequence: 12n, record: record(6_000_000n, 13) },
+        { sequence: 6n, record: record(3_000_000n, 9) },
+        // Torn: the process died while writing position 3.
+        { sequence: 7n, record: record(0n, 99) },
+      ],
+      ["my-addon"],
+    );
+    const log = decodeEventLog(buffer);
+    assert.equal(log.pid, 4321);
+    assert.deepEqual(log.strings, ["my-addon"]);
+    assert.deepEqual(
+      log.records.map(({ name }) => name),
+      ["work-queued", "fatal", "task-posted"],
+    );
+    assert.deepEqual(formatEventLog(log), [
+      "+0.000ms [3] work-queued my-addon 0x0",
+      "+2.000ms [3] fatal my-addon",
+      "+3.000ms [3] task-posted my-addon 0x0",
+    ]);
+  });
+
+  it("rejects other files", () => {
+    assert.throws(() => decodeEventLog(Buffer.alloc(64)), /Not an event log/);
+    const truncated = encodeEventLog(
+      [{ timestamp: 0n, id: 1, thread: 1, args: [0n, 0n] }],
+      [],
+    ).subarray(0, 40);
+    assert.throws(() => decodeEventLog(truncated), /truncated/);
+  });
+});
@@ -0,0 +1,244 @@
+import assert from "node:assert/strict";
+
+type EventKind = {
+  name: string;
+  /** Whether the first argument is an interned string (an addon's name). */
+  subject?: boolean;
+  /** Renders the second argument. */
+  detail?: (arg: bigint) => string | undefined;
+};
+
+const status = (arg: bigint) => (arg !== 0n ? `status=${arg}` : undefined);
+const address = (arg: bigint) => `0x${BigInt.asUintN(64, arg).toString(16)}`;
+
+const DROPPED_KINDS: Record<string, string> = {
+  1: "duplicate-work",
+  2: "completion",
+  3: "task",
+};
+
+const FATAL_KINDS: Record<string, string> = {
+  1: "napi_fatal_error",
+  2: "napi_fatal_exception",
+};
+
+/**
+ * Mirrors `EventId` in cpp/EventLog.hpp: ids are never renumbered.
+ */
+export const EVENT_KINDS: Record<number, EventKind> = {
+  1: { name: "inject-begin" },
+  2: { name: "weak-node-api-loaded" },
+  3: { name: "inject-end" },
+  4: { name: "addon-load-begin", subject: true },
+  5: { name: "addon-env-created", subject: true },
+  6: { name: "addon-module-loaded", subject: true, detail: status },
+  7: { name: "addon-load-end", subject: true, detail: status },
+  8: { name: "worker-pool-started" },
+  9: { name: "work-queued", subject: true, detail: address },
+  10: { name: "work-executed", subject: true, detail: address },
+  11: { name: "work-completed", subject: true, detail: address },
+  12: { name: "work-cancelled", subject: true, detail: address },
+  13: { name: "task-posted", subject: true, detail: address },
+  14: { name: "task-dispatched", subject: true, detail: address },
+  15: {
+    name: "dropped",
+    subject: true,
+    detail: (arg) => DROPPED_KINDS[arg.toString()],
+  },
+  16: {
+    name: "fatal",
+    subject: true,
+    detail: (arg) => FATAL_KINDS[arg.toString()],
+  },
+  17: {
+    name: "external-memory-over-budget",
+    subject: true,
+    detail: (arg) => `bytes=${arg}`,
+  },
+  18: {
+    name: "addon-unloaded",
+    subject: true,
+    detail: (arg) => (arg === 0n ? "kept-loaded" : undefined),
+  },
+};
+
+const MAGIC = "RNNAPIEV";
+const FLIGHT_RECORDER_MAGIC = "RNNAPIFR";
+const HEADER_SIZE = 32;
+const RECORD_SIZE = 32;
+const SLOT_SIZE = 8 + RECORD_SIZE;
+
+export type EventLogRecord = {
+  /** Nanoseconds on the device's monotonic clock. */
+  timestamp: bigint;
+  id: number;
+  name: string;
+  thread: number;
+  args: [bigint, bigint];
+  /** The first argument resolved to its interned string, if it is one. */
+  subject?: string;
+};
+
+export type EventLog = {
+  version: number;
+  /** Add to a record's timestamp to get nanoseconds since the Unix epoch. */
+  realtimeOffset: bigint;
+  /** The recording process, for flight recordings. */
+  pid?: number;
+  records: EventLogRecord[];
+  strings: string[];
+};
+
+function readRecord(buffer: Buffer, at: number, strings: string[]) {
+  const id = buffer.readUInt16LE(at + 8);
+  const kind = EVENT_KINDS[id];
+  const args: [bigint, bigint] = [
+    buffer.readBigInt64LE(at + 16),
+    buffer.readBigInt64LE(at + 24),
+  ];
+  const record: EventLogRecord = {
+    timestamp: buffer.readBigUInt64LE(at),
+    id,
+    name: kind?.name ?? `unknown-${id}`,
+    thread: buffer.readUInt32LE(at + 12),
+    args,
+  };
+  if (kind?.subject && args[0] >= 0n && args[0] < BigInt(strings.length)) {
+    record.subject = strings[Number(args[0])];
+  }
+  return record;
+}
+
+/** Reads length-prefixed strings from `start` until `end`. */
+function readStrings(
+  buffer: Buffer,
+  start: number,
+  end: number,
+  max = 2 ** 32,
+) {
+  const strings: string[] = [];
+  let offset = start;
+  while (strings.length < max && offset + 4 <= end) {
+    const length = buffer.readUInt32LE(offset);
+    offset += 4;
+    if (offset + length > end) {
+      break;
+    }
+    strings.push(buffer.toString("utf8", offset, offset + length));
+    offset += length;
+  }
+  return strings;
+}
+
+function decodeFlightRecording(buffer: Buffer): EventLog {
+  const version = buffer.readUInt16LE(8);
+  assert.equal(version, 1, `Unsupported flight recording version ${version}`);
+  const recordSize = buffer.readUInt16LE(10);
+  assert.equal(recordSize, RECORD_SIZE, `Unexpected record size ${recordSize}`);
+  const capacity = buffer.readUInt32LE(12);
+  const realtimeOffset = buffer.readBigInt64LE(16);
+  const pid = buffer.readUInt32LE(24);
+  const ringOffset = buffer.readUInt32LE(28);
+  const stringsOffset = buffer.readUInt32LE(32);
+  const stringsCapacity = buffer.readUInt32LE(36);
+  const stringsUsed = Math.min(buffer.readUInt32LE(40), stringsCapacity);
+  assert(
+    buffer.length >= ringOffset + 8 + capacity * SLOT_SIZE &&
+      buffer.length >= stringsOffset + stringsUsed,
+    "Flight recording is truncated",
+  );
+
+  const strings = readStrings(
+    buffer,
+    stringsOffset,
+    stringsOffset + stringsUsed,
+  );
+
+  // A slot holds the record at position p once its sequence is 2 * (p + 1);
+  // an odd sequence is a record torn by the process dying mid-write.
+  const positioned: { position: bigint; record: EventLogRecord }[] = [];
+  for (let i = 0; i < capacity; i++) {
+    const at = ringOffset + 8 + i * SLOT_SIZE;
+    const sequence = buffer.readBigUInt64LE(at);
+    if (sequence === 0n || sequence % 2n === 1n) {
+      continue;
+    }
+    positioned.push({
+      position: sequence / 2n - 1n,
+      record: readRecord(buffer, at + 8, strings),
+    });
+  }
+  positioned.sort((a, b) =>
+    a.position < b.position ? -1 : a.position > b.position ? 1 : 0,
+  );
+  return {
+    version,
+    realtimeOffset,
+    pid,
+    records: positioned.map(({ record }) => record),
+    strings,
+  };
+}
+
+/**
+ * Decodes an event log file written by `writeEventLog`, or a flight
+ * recording written by `startFlightRecorder` (cpp/EventLog.cpp).
+ */
+export function decodeEventLog(buffer: Buffer): EventLog {
+  assert(buffer.length >= HEADER_SIZE, "Event log is shorter than its header");
+  const magic = buffer.toString("latin1", 0, 8);
+  if (magic === FLIGHT_RECORDER_MAGIC) {
+    return decodeFlightRecording(buffer);
+  }
+  assert.equal(magic, MAGIC, "Not an event log (bad magic)");
+  const version = buffer.readUInt16LE(8);
+  assert.equal(version, 1, `Unsupported event log version ${version}`);
+  const recordSize = buffer.readUInt16LE(10);
+  assert.equal(recordSize, RECORD_SIZE, `Unexpected record size ${recordSize}`);
+  const recordCount = buffer.readUInt32LE(12);
+  const stringCount = buffer.readUInt32LE(16);
+  const realtimeOffset = buffer.readBigInt64LE(24);
+
+  const recordsEnd = HEADER_SIZE + recordCount * RECORD_SIZE;
+  assert(buffer.length >= recordsEnd, "Event log is truncated");
+  const strings = readStrings(
+    buffer,
+    recordsEnd,
+    buffer.length,
+    stringCount,
+  );
+  assert.equal(strings.length, stringCount, "Event log is truncated");
+
+  const records: EventLogRecord[] = [];
+  for (let i = 0; i < recordCount; i++) {
+    records.push(readRecord(buffer, HEADER_SIZE + i * RECORD_SIZE, strings));
+  }
+  return { version, realtimeOffset, records, strings };
+}
+
+/**
+ * One line per record, timed in milliseconds from the first record.
+ */
+export function formatEventLog({ records }: EventLog): string[] {
+  if (records.length === 0) {
+    return [];
+  }
+  const start = records[0].timestamp;
+  return records.map(({ timestamp, id, name, thread, args, subject }) => {
+    const elapsed = Number(timestamp - start) / 1e6;
+    const kind = EVENT_KINDS[id];
+    const details: string[] = [];
+    if (kind?.subject) {
+      details.push(subject === undefined ? `#${args[0]}` : subject);
+      const detail = kind.detail?.(args[1]);
+      if (detail !== undefined) {
+        details.push(detail);
+      }
+    } else {
+      details.push(...args.filter((arg) => arg !== 0n).map(String));
+    }
+    return [`+${elapsed.toFixed(3)}ms`, `[${thread}]`, name, ...details].join(
+      " ",
+    );
+  });
+}
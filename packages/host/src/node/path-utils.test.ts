@@ -54,6 +54,14 @@ function restoreReadPermissions(p: string) {
     throw new Error("can not set attributes to restore read permissions");
 }
 
+/**
+ * Move the mtime of a directory into the past, for its listing to be cached.
+ */
+function backdateDirectory(p: string) {
+  const past = new Date(Date.now() - 60_000);
+  fs.utimesSync(p, past, past);
+}
+
 describe("isNodeApiModule", () => {
   it("returns true for .node", (context) => {
     const tempDirectoryPath = setupTempDirectory(context, {
@@ -132,6 +140,31 @@ describe("isNodeApiModule", () => {
     );
     restoreReadPermissions(unreadable);
   });
+
+  it("lists a directory once while its mtime is unchanged", (context) => {
+    const tempDirectoryPath = setupTempDirectory(context, {
+      "addon.android.node": "",
+    });
+    backdateDirectory(tempDirectoryPath);
+    const readdirSync = context.mock.method(fs, "readdirSync");
+
+    assert(isNodeApiModule(path.join(tempDirectoryPath, "addon")));
+    assert(isNodeApiModule(path.join(tempDirectoryPath, "addon")));
+    assert.equal(isNodeApiModule(path.join(tempDirectoryPath, "other")), false);
+    assert.equal(readdirSync.mock.callCount(), 1);
+  });
+
+  it("notices modules added to a listed directory", (context) => {
+    const tempDirectoryPath = setupTempDirectory(context, {
+      "index.js": "",
+    });
+    backdateDirectory(tempDirectoryPath);
+    const modulePath = path.join(tempDirectoryPath, "addon");
+
+    assert.equal(isNodeApiModule(modulePath), false);
+    fs.writeFileSync(path.join(tempDirectoryPath, "addon.apple.node"), "");
+    assert.equal(isNodeApiModule(modulePath), true);
+  });
 });
 
 describe("stripExtension", () => {
@@ -958,6 +991,70 @@ describe("findNodeAddonForBindings()", () => {
       assert.equal(actualPath, expectedAbsPath);
     });
   }
+
+  it("should look for addons in subdirectories of the id", (context) => {
+    const tempDirectoryPath = setupTempDirectory(context, {
+      "build/Release/lib/addon.node": "",
+    });
+    assert.equal(
+      findNodeAddonForBindings("lib/addon", tempDirectoryPath),
+      path.join(tempDirectoryPath, "build/Release/lib/addon.node"),
+    );
+  });
+
+  it("should memoize resolutions until a directory probed changes", (context) => {
+    const tempDirectoryPath = setupTempDirectory(context, {
+      "build/Release/addon.node": "",
+    });
+    for (const dir of ["build/Release", "build", "."]) {
+      backdateDirectory(path.join(tempDirectoryPath, dir));
+    }
+    const expectedPath = path.join(
+      tempDirectoryPath,
+      "build/Release/addon.node",
+    );
+    assert.equal(
+      findNodeAddonForBindings("addon", tempDirectoryPath),
+      expectedPath,
+    );
+
+    const readdirSync = context.mock.method(fs, "readdirSync");
+    const statSync = context.mock.method(fs, "statSync");
+    assert.equal(
+      findNodeAddonForBindings("addon", tempDirectoryPath),
+      expectedPath,
+    );
+    assert.equal(readdirSync.mock.callCount(), 0);
+    // Only the directories which exist are stat'ed
+    assert.equal(statSync.mock.callCount(), 3);
+
+    // An addon placed in a directory probed earlier takes precedence
+    fs.writeFileSync(path.join(tempDirectoryPath, "addon.node"), "");
+    assert.equal(
+      findNodeAddonForBindings("addon", tempDirectoryPath),
+      path.join(tempDirectoryPath, "addon.node"),
+    );
+  });
+
+  it("should notice a probed directory being created", (context) => {
+    const tempDirectoryPath = setupTempDirectory(context, {
+      "index.js": "",
+    });
+    backdateDirectory(tempDirectoryPath);
+    assert.equal(
+      findNodeAddonForBindings("addon", tempDirectoryPath),
+      undefined,
+    );
+    fs.mkdirSync(path.join(tempDirectoryPath, "build/Debug"), {
+      recursive: true,
+    });
+    const expectedPath = path.join(tempDirectoryPath, "build/Debug/addon.node");
+    fs.writeFileSync(expectedPath, "");
+    assert.equal(
+      findNodeAddonForBindings("addon", tempDirectoryPath),
+      expectedPath,
+    );
+  });
 });
 
 describe("dereferenceDirectory", () => {
@@ -59,6 +59,57 @@ export type NamingStrategy = {
 // Cache mapping package directory to package name across calls
 const packageNameCache = new Map<string, string>();
 
+/**
+ * Directories modified this recently could change again without their mtime
+ * changing (its granularity is coarse on some filesystems), so their listings
+ * aren't cached.
+ */
+const RACY_MTIME_MS = 2000;
+
+type DirectoryListing = { mtimeMs: number; entries: Set<string> };
+
+// Cache mapping directory path to its entries across calls (process-wide), for as long as its mtime is unchanged
+const directoryListingCache = new Map<string, DirectoryListing>();
+
+function isRacyMtime(mtimeMs: number) {
+  return Date.now() - mtimeMs < RACY_MTIME_MS;
+}
+
+function getMtime(dirPath: string): number | undefined {
+  try {
+    return fs.statSync(dirPath, { throwIfNoEntry: false })?.mtimeMs;
+  } catch {
+    return undefined;
+  }
+}
+
+/**
+ * List the entries of a directory, memoized until the directory's mtime
+ * changes (as it does when an entry is added, removed or renamed).
+ * @returns The listing, or undefined if the directory cannot be read.
+ */
+function listDirectory(dirPath: string): DirectoryListing | undefined {
+  const mtimeMs = getMtime(dirPath);
+  if (mtimeMs === undefined) {
+    return undefined;
+  }
+  const cached = directoryListingCache.get(dirPath);
+  if (cached && cached.mtimeMs === mtimeMs) {
+    return cached;
+  }
+  directoryListingCache.delete(dirPath);
+  let listing: DirectoryListing;
+  try {
+    listing = { mtimeMs, entries: new Set(fs.readdirSync(dirPath)) };
+  } catch {
+    return undefined;
+  }
+  if (!isRacyMtime(mtimeMs)) {
+    directoryListingCache.set(dirPath, listing);
+  }
+  return listing;
+}
+
 /**
  * @param modulePath  Batch-scans the path to the module to check (must be extensionless or end in .node)
  * @returns True if a platform specific prebuild exists for the module path, warns on unreadable modules.
@@ -66,29 +117,39 @@ const packageNameCache = new Map<string, string>();
  * TODO: Consider checking for a specific platform extension.
  */
 export function isNodeApiModule(modulePath: string): boolean {
+  const dir = path.dirname(modulePath);
+  return isNodeApiModuleInDirectory(
+    dir,
+    listDirectory(dir),
+    path.basename(modulePath, ".node"),
+  );
+}
+
+function isNodeApiModuleInDirectory(
+  dir: string,
+  listing: DirectoryListing | undefined,
+  baseName: string,
+): boolean {
   {
     // HACK: Take a shortcut (if applicable): existing `.node` files are addons
-    try {
-      fs.accessSync(
-        modulePath.endsWith(".node") ? modulePath : `${modulePath}.node`,
-      );
-      return true;
-    } catch {
-      // intentionally left empty
+    const fileName = `${baseName}.node`;
+    // Unless the listing rules it out, access the file (following symlinks)
+    if (!listing || listing.entries.has(fileName)) {
+      try {
+        fs.accessSync(path.join(dir, fileName));
+        return true;
+      } catch {
+        // intentionally left empty
+      }
     }
   }
-  const dir = path.dirname(modulePath);
-  const baseName = path.basename(modulePath, ".node");
-  let entries: string[];
-  try {
-    entries = fs.readdirSync(dir);
-  } catch {
+  if (!listing) {
     // Cannot read directory: treat as no module
     return false;
   }
   return Object.values(PLATFORM_EXTENSIONS).some((extension) => {
     const fileName = baseName + extension;
-    if (!entries.includes(fileName)) {
+    if (!listing.entries.has(fileName)) {
       return false;
     }
 
@@ -624,13 +685,105 @@ const nodeBindingsSubdirs = [
   "./Debug",
 ];
 
+type BindingsResolution = {
+  resolvedPath: string | undefined;
+  /** mtime per directory listed while resolving (undefined if missing) */
+  directoryMtimes: Map<string, number | undefined>;
+};
+
+// Cache mapping the id and directory of a `bindings()` call to the addon it resolved to across calls (process-wide)
+const bindingsResolutionCache = new Map<string, BindingsResolution>();
+
+/**
+ * List a directory below another, descending through the listings of the
+ * directories in between: a missing subdirectory is ruled out by its parent's
+ * listing instead of being stat'ed.
+ * @returns The listing, undefined if the directory cannot be read or false if
+ * it's missing from its parent's listing.
+ */
+function listSubdirectory(
+  fromDir: string,
+  relativePath: string,
+  list: (dirPath: string) => DirectoryListing | undefined,
+): DirectoryListing | undefined | false {
+  const segments = path
+    .normalize(relativePath)
+    .split(path.sep)
+    .filter((segment) => segment !== "" && segment !== ".");
+  if (segments.includes("..")) {
+    return list(path.join(fromDir, relativePath));
+  }
+  let dirPath = fromDir;
+  let listing = list(dirPath);
+  for (const segment of segments) {
+    if (listing && !listing.entries.has(segment)) {
+      return false;
+    }
+    dirPath = path.join(dirPath, segment);
+    listing = list(dirPath);
+  }
+  return listing;
+}
+
+/**
+ * Find the addon a `bindings(id)` call resolves to, memoized until one of the
+ * directories listed to resolve it changes. Metro transforms every file
+ * requiring `bindings` with this, so a repeated call costs a stat of the
+ * existing directories probed instead of probing every path.
+ */
 export function findNodeAddonForBindings(id: string, fromDir: string) {
+  const cacheKey = `${fromDir}\0${id}`;
+  const cached = bindingsResolutionCache.get(cacheKey);
+  if (
+    cached &&
+    [...cached.directoryMtimes].every(
+      ([dirPath, mtimeMs]) => getMtime(dirPath) === mtimeMs,
+    )
+  ) {
+    return cached.resolvedPath;
+  }
+  bindingsResolutionCache.delete(cacheKey);
+
+  const directoryMtimes = new Map<string, number | undefined>();
+  const list = (dirPath: string) => {
+    const listing = listDirectory(dirPath);
+    directoryMtimes.set(dirPath, listing?.mtimeMs);
+    return listing;
+  };
+  const resolvedPath = resolveNodeAddonForBindings(id, fromDir, list);
+  if (
+    [...directoryMtimes.values()].every(
+      (mtimeMs) => mtimeMs === undefined || !isRacyMtime(mtimeMs),
+    )
+  ) {
+    bindingsResolutionCache.set(cacheKey, { resolvedPath, directoryMtimes });
+  }
+  return resolvedPath;
+}
+
+function resolveNodeAddonForBindings(
+  id: string,
+  fromDir: string,
+  list: (dirPath: string) => DirectoryListing | undefined,
+) {
   const idWithExt = id.endsWith(".node") ? id : `${id}.node`;
   // Support traversing the filesystem to find the Node-API module.
   // Currently, we check the most common directories like `bindings` does.
   for (const subdir of nodeBindingsSubdirs) {
     const resolvedPath = path.join(fromDir, subdir, idWithExt);
-    if (isNodeApiModule(resolvedPath)) {
+    const listing = listSubdirectory(
+      fromDir,
+      path.join(subdir, path.dirname(idWithExt)),
+      list,
+    );
+    if (
+      listing !== false &&
+      isNodeApiModuleInDirectory(
+        path.dirname(resolvedPath),
+        listing,
+        path.basename(resolvedPath, ".node"),
+      )
+    ) {
       return resolvedPath;
     }
   }
@@ -1,7 +1,76 @@
 import { type TurboModule, TurboModuleRegistry } from "react-native";
 
+/**
+ * The time an addon's callbacks spent on the worker pool and the JS thread,
+ * since it was loaded.
+ */
+export type NodeAddonStats = {
+  /** `execute` callbacks of async work run on the worker pool. */
+  executions: number;
+  executeWallMs: number;
+  /** CPU time of `execute`, excluding time blocked or preempted. */
+  executeCpuMs: number;
+  /** `complete` callbacks of async work run on the JS thread. */
+  completions: number;
+  completeMs: number;
+  /** Thread-safe function dispatches run on the JS thread. */
+  taskDispatches: number;
+  taskMs: number;
+};
+
+/**
+ * The external memory an addon reported through
+ * `napi_adjust_external_memory`, across every runtime it was loaded into.
+ */
+export type NodeAddonMemory = {
+  externalBytes: number;
+  /** The most `externalBytes` has been. */
+  peakExternalBytes: number;
+};
+
+/**
+ * Where the time of loading an addon went, measured on the monotonic clock.
+ */
+export type NodeAddonLoadTiming = {
+  libraryName: string;
+  /** When the load started, since the host module was created. */
+  startMs: number;
+  totalMs: number;
+  /**
+   * Loading weak-node-api and injecting the host into it, which the first
+   * load in the process does, rather than the app as it starts.
+   */
+  injectMs: number;
+  /** Creating the addon's Node-API environment. */
+  envMs: number;
+  /**
+   * Looking the addon up in addon bundles, which opens them if this load was
+   * the first lookup since they were added.
+   */
+  bundleLookupMs: number;
+  /**
+   * Opening the addon's own library, including its static initializers. Zero
+   * for a bundled addon.
+   */
+  libraryOpenMs: number;
+  /** Initializing the addon: its init function, called with the exports. */
+  initMs: number;
+  /** Handing the exports over to JavaScript. */
+  bridgeMs: number;
+  /** Whether the addon was loaded from a bundle. */
+  bundled: boolean;
+  /** Whether the addon's library was already loaded, e.g. before a reload. */
+  resident: boolean;
+  /** Later `requireNodeAddon` calls served from the cache. */
+  cacheHits: number;
+  cacheHitMs: number;
+};
+
 export interface Spec extends TurboModule {
   requireNodeAddon<T = unknown>(libraryName: string): T;
+  getNodeAddonStats(): Record<string, NodeAddonStats>;
+  getNodeAddonMemory(): Record<string, NodeAddonMemory>;
+  getNodeAddonLoadTimings(): NodeAddonLoadTiming[];
 }
 
 const native = TurboModuleRegistry.getEnforcing<Spec>("NodeApiHost");
@@ -12,3 +81,26 @@ const native = TurboModuleRegistry.getEnforcing<Spec>("NodeApiHost");
 export function requireNodeAddon<T = unknown>(libraryName: string): T {
   return native.requireNodeAddon<T>(libraryName);
 }
+
+/**
+ * Per-addon time accounting, keyed by library name: e.g. to find the addon
+ * keeping the worker pool busy in production.
+ */
+export function getNodeAddonStats(): Record<string, NodeAddonStats> {
+  return native.getNodeAddonStats();
+}
+
+/**
+ * Per-addon external memory, keyed by library name.
+ */
+export function getNodeAddonMemory(): Record<string, NodeAddonMemory> {
+  return native.getNodeAddonMemory();
+}
+
+/**
+ * The addons loaded into this runtime, in load order, with where their load
+ * time went: e.g. to attribute a startup regression to an addon.
+ */
+export function getNodeAddonLoadTimings(): NodeAddonLoadTiming[] {
+  return native.getNodeAddonLoadTimings();
+}
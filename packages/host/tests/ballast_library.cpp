@@ -0,0 +1,18 @@
+// A shared library standing in for a large addon in test_addon_libraries.cpp:
+// loading it commits its ballast, which only unmapping the library gives
+// back.
+#include <cstring>
+
+// Zero-initialized, so it costs no file size, only memory once touched.
+// Exported to keep the stores below.
+extern "C" {
+__attribute__((visibility("default"))) unsigned char ballast[32 << 20];
+}
+
+namespace {
+
+__attribute__((constructor)) void touchBallast() {
+  memset(ballast, 1, sizeof(ballast));
+}
+
+} // namespace
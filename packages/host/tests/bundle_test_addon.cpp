@@ -0,0 +1,12 @@
+// A minimal addon, built once per BUNDLE_TEST_ADDON_ID both into a library of
+// its own and into a bundle (see tests/CMakeLists.txt). Its init only tags
+// the exports it is given with its id, for test_addon_bundles.cpp to check.
+#include <node_api.h>
+
+#include <cstdint>
+
+NAPI_MODULE_INIT() {
+  (void)env;
+  return reinterpret_cast<napi_value>(reinterpret_cast<uintptr_t>(exports) +
+                                      BUNDLE_TEST_ADDON_ID);
+}
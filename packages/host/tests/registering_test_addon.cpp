@@ -0,0 +1,26 @@
+// An addon registering itself from a static initializer, as
+// node-addon-examples' module-register does, built against both weak-node-api
+// and weak-node-api-static (see tests/CMakeLists.txt). Its init returns what
+// napi_get_undefined gives it, for test_static_weak_node_api.cpp to check
+// which host it called.
+#include <node_api.h>
+
+namespace {
+
+napi_value Init(napi_env env, napi_value exports) {
+  (void)exports;
+  napi_value result = nullptr;
+  napi_get_undefined(env, &result);
+  return result;
+}
+
+napi_module addonModule = {
+    NAPI_MODULE_VERSION, 0,       __FILE__, Init, "registering-test-addon",
+    nullptr,             {nullptr},
+};
+
+__attribute__((constructor)) void registerAddon() {
+  napi_module_register(&addonModule);
+}
+
+} // namespace
@@ -0,0 +1,26 @@
+// A process standing in for an app starting, for the startup benchmark in
+// test_weak_node_api_injector.cpp. Like the host, it uses weak-node-api's
+// headers only. Given "inject", it does what the host did as it was loaded,
+// before the injection was deferred: load weak-node-api and inject a host.
+#include <weak_node_api.hpp>
+
+#include <dlfcn.h>
+
+#include <cstring>
+
+int main(int argc, char **argv) {
+  if (argc < 2 || strcmp(argv[1], "inject") != 0) {
+    return 0;
+  }
+  void *module = dlopen(WEAK_NODE_API_PATH, RTLD_NOW | RTLD_LOCAL);
+  if (module == nullptr) {
+    return 1;
+  }
+  auto inject_weak_node_api_host = reinterpret_cast<InjectHostFunction>(
+      dlsym(module, "inject_weak_node_api_host"));
+  if (inject_weak_node_api_host == nullptr) {
+    return 1;
+  }
+  inject_weak_node_api_host(NodeApiHost{});
+  return 0;
+}
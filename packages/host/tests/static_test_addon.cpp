@@ -0,0 +1,11 @@
+// An addon linking weak-node-api statically (see tests/CMakeLists.txt), whose
+// init returns what napi_get_undefined gives it, for
+// test_static_weak_node_api.cpp to check which host it called.
+#include <node_api.h>
+
+NAPI_MODULE_INIT() {
+  (void)exports;
+  napi_value result = nullptr;
+  napi_get_undefined(env, &result);
+  return result;
+}
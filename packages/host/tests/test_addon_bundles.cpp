@@ -0,0 +1,117 @@
+// Exercises AddonBundles against a bundle of the minimal addons in
+// bundle_test_addon.cpp, built by add_node_api_bundle, and compares loading
+// that bundle with loading each addon from its own library. Bundles cannot
+// be removed once added, so every test finds the same one.
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <AddonBundles.hpp>
+#include <weak_node_api.hpp>
+#include <weak_node_api_bundle.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include <dlfcn.h>
+
+using namespace callstack::react_native_node_api;
+
+namespace {
+
+napi_value fakeValue(uintptr_t value) {
+  return reinterpret_cast<napi_value>(value);
+}
+
+void addBundleOnce() {
+  static bool added = false;
+  if (!added) {
+    AddonBundles::add(BUNDLE_TEST_PATH);
+    added = true;
+  }
+}
+
+std::string standalonePath(int id) {
+  char path[1024];
+  snprintf(path, sizeof(path), BUNDLE_TEST_ADDON_PATTERN, id);
+  return path;
+}
+
+} // namespace
+
+TEST_CASE("bundled addons resolve by name from one library") {
+  addBundleOnce();
+  for (int id = 1; id <= BUNDLE_TEST_ADDON_COUNT; id++) {
+    auto addon = AddonBundles::find("bundle-test-addon-" + std::to_string(id));
+    REQUIRE(addon.has_value());
+    CHECK(addon->init(nullptr, fakeValue(0x1000)) == fakeValue(0x1000 + id));
+  }
+  CHECK_FALSE(AddonBundles::find("not-a-bundled-addon").has_value());
+}
+
+TEST_CASE("a bundle's table records each addon's Node-API version") {
+  void *handle = dlopen(BUNDLE_TEST_PATH, RTLD_NOW | RTLD_LOCAL);
+  REQUIRE(handle != nullptr);
+  const auto *entry = static_cast<const node_api_bundle_entry *>(
+      dlsym(handle, NODE_API_BUNDLE_SYMBOL));
+  REQUIRE(entry != nullptr);
+  int count = 0;
+  for (; entry->name != nullptr; entry++, count++) {
+    REQUIRE(entry->get_api_version != nullptr);
+    CHECK(entry->get_api_version() == NAPI_VERSION);
+  }
+  CHECK(count == BUNDLE_TEST_ADDON_COUNT);
+  dlclose(handle);
+}
+
+TEST_CASE("a bundled addon loads with a fresh exports object") {
+  addBundleOnce();
+  inject_weak_node_api_host(NodeApiHost{
+      .napi_create_object = [](napi_env, napi_value *result) -> napi_status {
+        *result = fakeValue(0x2000);
+        return napi_ok;
+      },
+      .napi_is_exception_pending = [](napi_env, bool *result) -> napi_status {
+        *result = false;
+        return napi_ok;
+      },
+  });
+  auto addon = AddonBundles::find("bundle-test-addon-7");
+  REQUIRE(addon.has_value());
+  napi_value exports = nullptr;
+  REQUIRE(AddonBundles::load(nullptr, *addon, &exports) == napi_ok);
+  CHECK(exports == fakeValue(0x2007));
+}
+
+// Hidden from the default run; `node-api-host-tests "[benchmark]"` runs it.
+// Run alone, so that the bundle is not already open.
+TEST_CASE("loading addons at startup", "[.][benchmark]") {
+  BENCHMARK("one library per addon") {
+    std::vector<void *> handles;
+    for (int id = 1; id <= BUNDLE_TEST_ADDON_COUNT; id++) {
+      void *handle = dlopen(standalonePath(id).c_str(), RTLD_NOW | RTLD_LOCAL);
+      REQUIRE(handle != nullptr);
+      REQUIRE(dlsym(handle, "napi_register_module_v1") != nullptr);
+      handles.push_back(handle);
+    }
+    for (void *handle : handles) {
+      dlclose(handle);
+    }
+    return handles.size();
+  };
+
+  BENCHMARK("one bundle") {
+    void *handle = dlopen(BUNDLE_TEST_PATH, RTLD_NOW | RTLD_LOCAL);
+    REQUIRE(handle != nullptr);
+    const auto *entry = static_cast<const node_api_bundle_entry *>(
+        dlsym(handle, NODE_API_BUNDLE_SYMBOL));
+    REQUIRE(entry != nullptr);
+    size_t count = 0;
+    for (; entry->name != nullptr; entry++) {
+      count++;
+    }
+    dlclose(handle);
+    return count;
+  };
+}
@@ -0,0 +1,190 @@
+// Exercises AddonLibraries against a real shared library (ballast_library.cpp,
+// whose path CMake passes as BALLAST_LIBRARY_PATH), opened with dlopen as
+// hermes_napi_load_module does. Unloading is process wide and cannot be
+// disabled once libraries are adopted, so each test adopts its own load.
+// AddonLibraries::open is exercised against registering_test_addon.cpp, which
+// registers itself as it loads.
+#include <catch2/catch_test_macros.hpp>
+
+#include <AddonLibraries.hpp>
+#include <RuntimeNodeApi.hpp>
+#include <weak_node_api.hpp>
+
+#include <cstdio>
+#include <functional>
+
+#include <dlfcn.h>
+#include <unistd.h>
+
+using namespace callstack::react_native_node_api;
+
+namespace {
+
+constexpr const char *kLibraryPath = BALLAST_LIBRARY_PATH;
+
+// Runtimes are only compared by address; any distinct objects will do.
+int firstRuntime;
+int secondRuntime;
+
+bool isLoaded() {
+  void *handle = dlopen(kLibraryPath, RTLD_NOW | RTLD_NOLOAD);
+  if (handle == nullptr) {
+    return false;
+  }
+  dlclose(handle);
+  return true;
+}
+
+// Stands in for hermes_napi_load_module, which keeps its reference.
+void openLikeHermes() { REQUIRE(dlopen(kLibraryPath, RTLD_NOW) != nullptr); }
+
+std::shared_ptr<HostContext> createContext() {
+  return HostContext::create(
+      [](std::function<void()> &&) -> bool { return false; });
+}
+
+#if defined(__linux__)
+long residentBytes() {
+  FILE *statm = fopen("/proc/self/statm", "r");
+  REQUIRE(statm != nullptr);
+  long size = 0;
+  long resident = 0;
+  REQUIRE(fscanf(statm, "%ld %ld", &size, &resident) == 2);
+  fclose(statm);
+  return resident * sysconf(_SC_PAGESIZE);
+}
+#endif
+
+} // namespace
+
+TEST_CASE("libraries are kept while unloading is disabled") {
+  REQUIRE_FALSE(AddonLibraries::unloadEnabled());
+  openLikeHermes();
+  auto context = createContext();
+  AddonLibraries::adopt(context, &firstRuntime, "ballast", kLibraryPath);
+  context.reset();
+  CHECK(AddonLibraries::runtimeDestroyed(&firstRuntime) == 0);
+  CHECK(isLoaded());
+  // Hand the reference back, as an adopted one would have been.
+  void *handle = dlopen(kLibraryPath, RTLD_NOW | RTLD_NOLOAD);
+  dlclose(handle);
+  dlclose(handle);
+  REQUIRE_FALSE(isLoaded());
+}
+
+TEST_CASE("a library is unloaded once every runtime loading it is destroyed") {
+  AddonLibraries::setUnloadEnabled(true);
+  // Loaded into two runtimes, e.g. across a reload.
+  auto first = createContext();
+  auto second = createContext();
+  openLikeHermes();
+  AddonLibraries::adopt(first, &firstRuntime, "ballast", kLibraryPath);
+  openLikeHermes();
+  AddonLibraries::adopt(second, &secondRuntime, "ballast", kLibraryPath);
+
+  first.reset();
+  CHECK(AddonLibraries::runtimeDestroyed(&firstRuntime) == 0);
+  CHECK(isLoaded());
+
+#if defined(__linux__)
+  const long loaded = residentBytes();
+#endif
+  second.reset();
+  // The env cleanup hooks ran, but finalizers may still run until the
+  // runtime is destroyed.
+  CHECK(isLoaded());
+  CHECK(AddonLibraries::runtimeDestroyed(&secondRuntime) == 1);
+  CHECK_FALSE(isLoaded());
+#if defined(__linux__)
+  // The ballast is 32 MiB; allow for the test's own allocations.
+  CHECK(loaded - residentBytes() >= (24 << 20));
+#endif
+  AddonLibraries::setUnloadEnabled(false);
+}
+
+TEST_CASE("a runtime whose context outlives its destruction keeps the "
+          "library until the context is gone") {
+  AddonLibraries::setUnloadEnabled(true);
+  auto context = createContext();
+  openLikeHermes();
+  AddonLibraries::adopt(context, &firstRuntime, "ballast", kLibraryPath);
+
+  // Work posted through the runtime's envs is still in flight.
+  CHECK(AddonLibraries::runtimeDestroyed(&firstRuntime) == 0);
+  CHECK(isLoaded());
+
+  context.reset();
+  // Signalling any runtime retries it.
+  CHECK(AddonLibraries::runtimeDestroyed(&secondRuntime) == 1);
+  CHECK_FALSE(isLoaded());
+  AddonLibraries::setUnloadEnabled(false);
+}
+
+namespace {
+
+napi_module *registeredWithHermes = nullptr;
+
+// The host's napi_module_register, which a registering addon reaches through
+// weak-node-api.
+void injectRegisteringHost() {
+  registeredWithHermes = nullptr;
+  inject_weak_node_api_host(NodeApiHost{
+      .napi_get_undefined = [](napi_env, napi_value *result) -> napi_status {
+        *result = reinterpret_cast<napi_value>(0x5);
+        return napi_ok;
+      },
+      .napi_module_register =
+          [](napi_module *module) {
+            // As the shadow does, with Hermes' function standing by.
+            if (!AddonLibraries::captureRegistration(module)) {
+              registeredWithHermes = module;
+            }
+          },
+  });
+}
+
+void checkCapturesRegistration(const char *path) {
+  injectRegisteringHost();
+  auto opened = AddonLibraries::open(path);
+  REQUIRE(opened.handle != nullptr);
+  REQUIRE(opened.registered != nullptr);
+  CHECK(registeredWithHermes == nullptr);
+  CHECK(opened.registered->nm_register_func(nullptr, nullptr) ==
+        reinterpret_cast<napi_value>(0x5));
+
+  // Loaded already, its static initializers do not run again.
+  auto reopened = AddonLibraries::open(path);
+  REQUIRE(reopened.handle != nullptr);
+  CHECK(reopened.registered == nullptr);
+  dlclose(reopened.handle);
+  dlclose(opened.handle);
+
+  // Outside of open(), registrations reach Hermes.
+  void *handle = dlopen(path, RTLD_NOW | RTLD_LOCAL);
+  REQUIRE(handle != nullptr);
+  CHECK(registeredWithHermes != nullptr);
+  dlclose(handle);
+}
+
+} // namespace
+
+TEST_CASE("opening a library captures the addon it registers as it loads") {
+  SECTION("linking weak-node-api") {
+    checkCapturesRegistration(REGISTERING_TEST_ADDON_PATH);
+  }
+  SECTION("linking weak-node-api-static") {
+    checkCapturesRegistration(REGISTERING_TEST_ADDON_STATIC_PATH);
+  }
+}
+
+TEST_CASE("opening a library registering nothing captures nothing") {
+  injectRegisteringHost();
+  auto opened = AddonLibraries::open(kLibraryPath);
+  REQUIRE(opened.handle != nullptr);
+  CHECK(opened.registered == nullptr);
+  dlclose(opened.handle);
+
+  CHECK(AddonLibraries::open("libmissing-addon.so").handle == nullptr);
+  // A failed open leaves later registrations to Hermes.
+  CHECK_FALSE(AddonLibraries::captureRegistration(nullptr));
+}
@@ -0,0 +1,238 @@
+// Exercises the event log (EventLog.cpp): the ring of records, the file
+// format read by `react-native-node-api decode-events` and the flight
+// recorder. The log is process wide, so tests locate their own records by a
+// per-test marker argument rather than assuming an empty log, and the flight
+// recorder (which cannot be stopped) only runs in forked children.
+#include <catch2/catch_test_macros.hpp>
+
+#include <EventLog.hpp>
+
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace callstack::react_native_node_api;
+
+namespace {
+
+std::vector<EventRecord> recordsWithMarker(int64_t marker) {
+  std::vector<EventRecord> matching;
+  for (const EventRecord &record : snapshotEvents()) {
+    if (record.id == EventId::AddonLoadBegin && record.args[0] == marker) {
+      matching.push_back(record);
+    }
+  }
+  return matching;
+}
+
+// Runs `recording` in a forked child that starts the flight recorder at
+// `path` and is then killed, leaving only what reached the mapped file.
+template <typename F>
+void recordAndKill(const std::string &path, F recording) {
+  const pid_t child = fork();
+  REQUIRE(child >= 0);
+  if (child == 0) {
+    if (!startFlightRecorder(path)) {
+      _exit(1);
+    }
+    recording();
+    raise(SIGKILL);
+    _exit(2);
+  }
+  int status = 0;
+  REQUIRE(waitpid(child, &status, 0) == child);
+  REQUIRE(WIFSIGNALED(status));
+  REQUIRE(WTERMSIG(status) == SIGKILL);
+}
+
+template <typename T> T readAt(const std::vector<uint8_t> &bytes, size_t at) {
+  T value;
+  memcpy(&value, bytes.data() + at, sizeof(value));
+  return value;
+}
+
+} // namespace
+
+TEST_CASE("the event log keeps records in order, with their arguments") {
+  const int64_t marker = 1'000'001;
+  recordEvent(EventId::AddonLoadBegin, marker, 1);
+  recordEvent(EventId::AddonLoadBegin, marker, 2);
+  recordEvent(EventId::AddonLoadBegin, marker, 3);
+
+  const auto records = recordsWithMarker(marker);
+  REQUIRE(records.size() == 3);
+  for (size_t i = 0; i < records.size(); i++) {
+    CHECK(records[i].args[1] == static_cast<int64_t>(i + 1));
+    CHECK(records[i].thread != 0);
+  }
+  CHECK(records[0].timestamp <= records[1].timestamp);
+  CHECK(records[1].timestamp <= records[2].timestamp);
+}
+
+TEST_CASE("the event log keeps the most recent records once it wraps") {
+  const int64_t marker = 1'000'002;
+  const size_t total = kEventLogCapacity + 100;
+  for (size_t i = 0; i < total; i++) {
+    recordEvent(EventId::AddonLoadBegin, marker, static_cast<int64_t>(i));
+  }
+
+  const auto records = recordsWithMarker(marker);
+  REQUIRE(records.size() == kEventLogCapacity);
+  CHECK(records.front().args[1] == 100);
+  CHECK(records.back().args[1] == static_cast<int64_t>(total - 1));
+}
+
+TEST_CASE("the event log records from many threads at once") {
+  const int64_t marker = 1'000'003;
+  constexpr int kThreads = 8;
+  constexpr int kPerThread = 200;
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kThreads; t++) {
+    threads.emplace_back([t, marker] {
+      for (int i = 0; i < kPerThread; i++) {
+        recordEvent(EventId::AddonLoadBegin, marker, t * kPerThread + i);
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  const auto records = recordsWithMarker(marker);
+  REQUIRE(records.size() == kThreads * kPerThread);
+  std::vector<bool> seen(kThreads * kPerThread);
+  for (const EventRecord &record : records) {
+    REQUIRE(record.args[1] >= 0);
+    REQUIRE(record.args[1] < kThreads * kPerThread);
+    CHECK_FALSE(seen[record.args[1]]);
+    seen[record.args[1]] = true;
+  }
+}
+
+TEST_CASE("interned event strings keep their ids") {
+  const int64_t id = internEventString("event-log-test-addon");
+  CHECK(internEventString("event-log-test-addon") == id);
+  CHECK(internEventString("event-log-test-other-addon") != id);
+}
+
+TEST_CASE("the serialized event log has a header, the records and the "
+          "strings") {
+  const int64_t addon = internEventString("event-log-serialized-addon");
+  recordEvent(EventId::AddonLoadEnd, addon, 0);
+
+  const std::vector<uint8_t> bytes = serializeEventLog();
+  REQUIRE(bytes.size() >= 32);
+  CHECK(memcmp(bytes.data(), "RNNAPIEV", 8) == 0);
+  CHECK(readAt<uint16_t>(bytes, 8) == 1);
+  CHECK(readAt<uint16_t>(bytes, 10) == sizeof(EventRecord));
+  const auto recordCount = readAt<uint32_t>(bytes, 12);
+  const auto stringCount = readAt<uint32_t>(bytes, 16);
+  REQUIRE(recordCount > 0);
+  REQUIRE(recordCount <= kEventLogCapacity);
+  REQUIRE(stringCount > static_cast<uint32_t>(addon));
+
+  // The last record is the one just written.
+  const size_t last = 32 + (recordCount - 1) * sizeof(EventRecord);
+  const auto record = readAt<EventRecord>(bytes, last);
+  CHECK(record.id == EventId::AddonLoadEnd);
+  CHECK(record.args[0] == addon);
+
+  size_t at = 32 + recordCount * sizeof(EventRecord);
+  std::vector<std::string> strings;
+  for (uint32_t i = 0; i < stringCount; i++) {
+    const auto length = readAt<uint32_t>(bytes, at);
+    at += sizeof(length);
+    REQUIRE(at + length <= bytes.size());
+    strings.emplace_back(reinterpret_cast<const char *>(&bytes[at]), length);
+    at += length;
+  }
+  CHECK(at == bytes.size());
+  CHECK(strings[addon] == "event-log-serialized-addon");
+}
+
+TEST_CASE("the event log is written to a file") {
+  recordEvent(EventId::WorkerPoolStarted, 4);
+  char path[] = "/tmp/event-log-test-XXXXXX";
+  const int fd = mkstemp(path);
+  REQUIRE(fd >= 0);
+  close(fd);
+
+  REQUIRE(writeEventLog(path));
+  FILE *file = fopen(path, "rb");
+  REQUIRE(file != nullptr);
+  char magic[8] = {};
+  CHECK(fread(magic, 1, sizeof(magic), file) == sizeof(magic));
+  fclose(file);
+  unlink(path);
+  CHECK(memcmp(magic, "RNNAPIEV", 8) == 0);
+
+  CHECK_FALSE(writeEventLog("/nonexistent-directory/events.bin"));
+}
+
+TEST_CASE("the flight recorder keeps the events of a killed process") {
+  char directory[] = "/tmp/flight-recorder-test-XXXXXX";
+  REQUIRE(mkdtemp(directory) != nullptr);
+  const std::string path = std::string(directory) + "/events";
+  const int64_t marker = 1'000'004;
+
+  recordAndKill(path, [marker] {
+    recordEvent(EventId::AddonLoadBegin, marker, 1);
+    const int64_t addon = internEventString("flight-recorder-addon");
+    // More than the ring holds, to cover wrapping inside the mapped file.
+    for (size_t i = 0; i < kEventLogCapacity + 10; i++) {
+      recordEvent(EventId::WorkQueued, addon, static_cast<int64_t>(i));
+    }
+    recordFatalEvent(FatalKind::FatalError, "flight recorder test");
+  });
+
+  auto recording = readFlightRecording(path);
+  REQUIRE(recording.has_value());
+  CHECK(recording->pid != static_cast<uint32_t>(getpid()));
+  REQUIRE(recording->records.size() == kEventLogCapacity);
+  const EventRecord &last = recording->records.back();
+  CHECK(last.id == EventId::Fatal);
+  CHECK(last.args[1] == static_cast<int64_t>(FatalKind::FatalError));
+  REQUIRE(last.args[0] < static_cast<int64_t>(recording->strings.size()));
+  CHECK(recording->strings[last.args[0]] == "flight recorder test");
+  const EventRecord &queued =
+      recording->records[recording->records.size() - 2];
+  CHECK(queued.id == EventId::WorkQueued);
+  CHECK(queued.args[1] == static_cast<int64_t>(kEventLogCapacity + 9));
+  CHECK(recording->strings[queued.args[0]] == "flight-recorder-addon");
+
+  SECTION("a later run moves the recording aside") {
+    recordAndKill(path, [marker] {
+      recordEvent(EventId::AddonLoadBegin, marker, 2);
+    });
+    auto previous = readFlightRecording(path + ".previous");
+    REQUIRE(previous.has_value());
+    CHECK(previous->records.back().id == EventId::Fatal);
+
+    auto latest = readFlightRecording(path);
+    REQUIRE(latest.has_value());
+    CHECK(latest->records.back().id == EventId::AddonLoadBegin);
+    CHECK(latest->records.back().args[1] == 2);
+    unlink((path + ".previous").c_str());
+  }
+
+  unlink(path.c_str());
+  rmdir(directory);
+}
+
+TEST_CASE("reading a missing or foreign flight recording fails") {
+  CHECK_FALSE(readFlightRecording("/nonexistent-directory/events"));
+  char path[] = "/tmp/flight-recorder-test-XXXXXX";
+  const int fd = mkstemp(path);
+  REQUIRE(fd >= 0);
+  close(fd);
+  REQUIRE(writeEventLog(path));
+  CHECK_FALSE(readFlightRecording(path));
+  unlink(path);
+}
@@ -0,0 +1,113 @@
+// Exercises createExternalArrayBuffer (ExternalArrayBuffer.hpp) against an
+// injected fake of the one Node-API function it calls, which records the
+// ArrayBuffer it was asked for and lets the tests run its finalizer as the
+// garbage collector would.
+#include <catch2/catch_test_macros.hpp>
+
+#include <ExternalArrayBuffer.hpp>
+#include <weak_node_api.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+using namespace callstack::react_native_node_api;
+
+namespace {
+
+// Stands in for jsi::MutableBuffer, which needs a React Native build.
+struct VectorBuffer {
+  explicit VectorBuffer(size_t size) : bytes(size) {}
+  uint8_t *data() { return bytes.data(); }
+  size_t size() const { return bytes.size(); }
+  std::vector<uint8_t> bytes;
+};
+
+struct FakeArrayBuffers {
+  void *data = nullptr;
+  size_t length = 0;
+  napi_finalize finalizer = nullptr;
+  void *hint = nullptr;
+  napi_status status = napi_ok;
+
+  static FakeArrayBuffers &instance() {
+    static FakeArrayBuffers buffers;
+    return buffers;
+  }
+
+  void collect() {
+    finalizer(nullptr, data, hint);
+    finalizer = nullptr;
+  }
+};
+
+void injectFakeArrayBuffers() {
+  FakeArrayBuffers::instance() = FakeArrayBuffers{};
+  inject_weak_node_api_host(NodeApiHost{
+      .napi_create_external_arraybuffer =
+          [](napi_env, void *external_data, size_t byte_length,
+             napi_finalize finalize_cb, void *finalize_hint,
+             napi_value *result) -> napi_status {
+        auto &buffers = FakeArrayBuffers::instance();
+        if (buffers.status != napi_ok) {
+          return buffers.status;
+        }
+        buffers.data = external_data;
+        buffers.length = byte_length;
+        buffers.finalizer = finalize_cb;
+        buffers.hint = finalize_hint;
+        *result = reinterpret_cast<napi_value>(2);
+        return napi_ok;
+      },
+  });
+}
+
+napi_env fakeEnv() { return reinterpret_cast<napi_env>(1); }
+
+} // namespace
+
+TEST_CASE("createExternalArrayBuffer exposes the buffer's bytes in place") {
+  injectFakeArrayBuffers();
+  auto &buffers = FakeArrayBuffers::instance();
+  auto buffer = std::make_shared<VectorBuffer>(1024);
+
+  napi_value result = nullptr;
+  REQUIRE(createExternalArrayBuffer(fakeEnv(), buffer, &result) == napi_ok);
+  REQUIRE(result != nullptr);
+  REQUIRE(buffers.data == buffer->data());
+  REQUIRE(buffers.length == 1024);
+  buffers.collect();
+}
+
+TEST_CASE("createExternalArrayBuffer keeps the buffer alive until the "
+          "ArrayBuffer is collected") {
+  injectFakeArrayBuffers();
+  auto &buffers = FakeArrayBuffers::instance();
+  auto buffer = std::make_shared<VectorBuffer>(16);
+  std::weak_ptr<VectorBuffer> weak = buffer;
+
+  napi_value result = nullptr;
+  REQUIRE(createExternalArrayBuffer(fakeEnv(), std::move(buffer), &result) ==
+          napi_ok);
+  REQUIRE(!weak.expired());
+  buffers.collect();
+  REQUIRE(weak.expired());
+}
+
+TEST_CASE("createExternalArrayBuffer releases the buffer when the runtime "
+          "refuses it") {
+  injectFakeArrayBuffers();
+  auto &buffers = FakeArrayBuffers::instance();
+  buffers.status = napi_generic_failure;
+  auto buffer = std::make_shared<VectorBuffer>(16);
+  std::weak_ptr<VectorBuffer> weak = buffer;
+
+  napi_value result = nullptr;
+  REQUIRE(createExternalArrayBuffer(fakeEnv(), std::move(buffer), &result) ==
+          napi_generic_failure);
+  REQUIRE(weak.expired());
+  REQUIRE(buffers.finalizer == nullptr);
+
+  REQUIRE(createExternalArrayBuffer<VectorBuffer>(fakeEnv(), nullptr,
+                                                  &result) == napi_invalid_arg);
+}
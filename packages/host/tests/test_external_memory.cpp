@@ -0,0 +1,190 @@
+// Exercises ExternalMemory and the napi_adjust_external_memory shadow feeding
+// it (RuntimeNodeApi.cpp), the latter against an injected fake of the
+// runtime's function. Accounts are process wide and never reset, so every
+// test uses its own addon names and envs.
+#include <catch2/catch_test_macros.hpp>
+
+#include <ExternalMemory.hpp>
+#include <Logger.hpp>
+#include <RuntimeNodeApi.hpp>
+#include <weak_node_api.hpp>
+
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace host = callstack::react_native_node_api;
+using host::ExternalMemory;
+
+namespace {
+
+napi_env fakeEnv(uintptr_t id) { return reinterpret_cast<napi_env>(id); }
+
+std::optional<ExternalMemory::AddonMemory> memoryOf(const std::string &owner) {
+  for (const auto &addon : ExternalMemory::snapshot()) {
+    if (addon.owner == owner) {
+      return addon;
+    }
+  }
+  return std::nullopt;
+}
+
+std::mutex warningsMutex;
+std::vector<std::string> warnings;
+
+void collectWarning(host::LogLevel level, const char *line, size_t length) {
+  if (level == host::LogLevel::Warning) {
+    std::lock_guard lock(warningsMutex);
+    warnings.emplace_back(line, length);
+  }
+}
+
+int64_t runtimeExternalMemory = 0;
+
+struct CleanupHook {
+  void (*fun)(void *);
+  void *arg;
+};
+std::map<napi_env, CleanupHook> cleanupHooks;
+
+void injectFakeRuntime() {
+  runtimeExternalMemory = 0;
+  cleanupHooks.clear();
+  inject_weak_node_api_host(NodeApiHost{
+      .napi_adjust_external_memory = [](napi_env, int64_t change,
+                                        int64_t *result) -> napi_status {
+        runtimeExternalMemory += change;
+        *result = runtimeExternalMemory;
+        return napi_ok;
+      },
+      .napi_add_env_cleanup_hook = [](napi_env env, void (*fun)(void *arg),
+                                      void *arg) -> napi_status {
+        cleanupHooks[env] = CleanupHook{fun, arg};
+        return napi_ok;
+      },
+  });
+}
+
+// Tears `env` down, as Hermes would.
+void tearDown(napi_env env) {
+  auto hook = cleanupHooks.at(env);
+  cleanupHooks.erase(env);
+  hook.fun(hook.arg);
+}
+
+} // namespace
+
+TEST_CASE("external memory is counted per addon, with its high-water mark") {
+  injectFakeRuntime();
+  ExternalMemory::registerEnv(fakeEnv(0x1001), "memory-addon-a");
+  ExternalMemory::registerEnv(fakeEnv(0x1002), "memory-addon-b");
+  // A second env of the same addon, as after a reload.
+  ExternalMemory::registerEnv(fakeEnv(0x1003), "memory-addon-a");
+
+  ExternalMemory::adjust(fakeEnv(0x1001), 1000);
+  ExternalMemory::adjust(fakeEnv(0x1003), 500);
+  ExternalMemory::adjust(fakeEnv(0x1001), -800);
+  ExternalMemory::adjust(fakeEnv(0x1002), 64);
+  // Unregistered envs are not counted.
+  ExternalMemory::adjust(fakeEnv(0x1fff), 1 << 20);
+
+  auto a = memoryOf("memory-addon-a");
+  REQUIRE(a);
+  CHECK(a->current == 700);
+  CHECK(a->peak == 1500);
+  auto b = memoryOf("memory-addon-b");
+  REQUIRE(b);
+  CHECK(b->current == 64);
+  CHECK(b->peak == 64);
+}
+
+TEST_CASE("an env address reused by another addon is attributed to it") {
+  injectFakeRuntime();
+  ExternalMemory::registerEnv(fakeEnv(0x2001), "memory-addon-c");
+  ExternalMemory::adjust(fakeEnv(0x2001), 10);
+  tearDown(fakeEnv(0x2001));
+  ExternalMemory::registerEnv(fakeEnv(0x2001), "memory-addon-d");
+  ExternalMemory::adjust(fakeEnv(0x2001), 20);
+
+  CHECK(memoryOf("memory-addon-c")->current == 0);
+  CHECK(memoryOf("memory-addon-c")->peak == 10);
+  CHECK(memoryOf("memory-addon-d")->current == 20);
+}
+
+TEST_CASE("a torn-down env gives back what it held and is no longer "
+          "attributed") {
+  injectFakeRuntime();
+  ExternalMemory::registerEnv(fakeEnv(0x2101), "memory-addon-h");
+  // A second env of the addon, as after a reload, which keeps its share.
+  ExternalMemory::registerEnv(fakeEnv(0x2102), "memory-addon-h");
+  ExternalMemory::adjust(fakeEnv(0x2101), 300);
+  ExternalMemory::adjust(fakeEnv(0x2102), 50);
+  tearDown(fakeEnv(0x2101));
+  CHECK(memoryOf("memory-addon-h")->current == 50);
+
+  // Finalizers running as the runtime is destroyed free what it held.
+  ExternalMemory::adjust(fakeEnv(0x2101), -300);
+  CHECK(memoryOf("memory-addon-h")->current == 50);
+  CHECK(memoryOf("memory-addon-h")->peak == 350);
+}
+
+TEST_CASE("external memory adjusted from many threads adds up") {
+  injectFakeRuntime();
+  ExternalMemory::registerEnv(fakeEnv(0x3001), "memory-addon-e");
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 8; t++) {
+    threads.emplace_back([] {
+      for (int i = 0; i < 1000; i++) {
+        ExternalMemory::adjust(fakeEnv(0x3001), 3);
+        ExternalMemory::adjust(fakeEnv(0x3001), -1);
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  auto e = memoryOf("memory-addon-e");
+  CHECK(e->current == 8 * 1000 * 2);
+  CHECK(e->peak >= e->current);
+}
+
+TEST_CASE("growing past the budget warns once per crossing") {
+  injectFakeRuntime();
+  host::flushLogs();
+  warnings.clear();
+  host::setLogSink(collectWarning);
+  ExternalMemory::setBudget(1000);
+  ExternalMemory::registerEnv(fakeEnv(0x4001), "memory-addon-f");
+
+  ExternalMemory::adjust(fakeEnv(0x4001), 900);
+  ExternalMemory::adjust(fakeEnv(0x4001), 200);
+  ExternalMemory::adjust(fakeEnv(0x4001), 200);
+  ExternalMemory::adjust(fakeEnv(0x4001), -600);
+  ExternalMemory::adjust(fakeEnv(0x4001), 500);
+
+  ExternalMemory::setBudget(0);
+  host::flushLogs();
+  host::setLogSink(nullptr);
+  std::lock_guard lock(warningsMutex);
+  REQUIRE(warnings.size() == 2);
+  CHECK(warnings[0] == "NapiHost: 'memory-addon-f' holds 1100 bytes of "
+                       "external memory, over the budget of 1000 bytes");
+  CHECK(warnings[1].find("holds 1200 bytes") != std::string::npos);
+}
+
+TEST_CASE("the napi_adjust_external_memory shadow forwards to the runtime "
+          "and counts the change") {
+  injectFakeRuntime();
+  ExternalMemory::registerEnv(fakeEnv(0x5001), "memory-addon-g");
+
+  int64_t adjusted = 0;
+  REQUIRE(host::napi_adjust_external_memory(fakeEnv(0x5001), 4096,
+                                            &adjusted) == napi_ok);
+  CHECK(adjusted == 4096);
+  CHECK(runtimeExternalMemory == 4096);
+  CHECK(memoryOf("memory-addon-g")->current == 4096);
+}
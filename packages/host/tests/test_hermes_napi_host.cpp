@@ -12,7 +12,9 @@
 #include <condition_variable>
 #include <deque>
 #include <functional>
+#include <memory>
 #include <mutex>
+#include <string>
 #include <thread>
 #include <vector>
 
@@ -375,9 +377,9 @@ TEST_CASE("post_task delivers exactly once, in order and never inline") {
 
 TEST_CASE("a dispatcher that stops accepting (runtime teardown) fails "
           "cancellations and drops completions") {
-  // Models the state production actually reaches: the HostContext is retained
-  // for the process lifetime, but its dispatcher's CallInvoker expires with
-  // the runtime, so dispatchToJs starts returning false.
+  // Models the state production reaches while the runtime's envs still hold
+  // the HostContext: its dispatcher's CallInvoker expires with the runtime,
+  // so dispatchToJs starts returning false.
   FakeJsQueue js;
   auto context = HostContext::create(js.dispatcher());
   hermes_napi_host *host = context->host();
@@ -424,3 +426,186 @@ TEST_CASE("a dispatcher that stops accepting (runtime teardown) fails "
     REQUIRE(runs.load() == 0);
   }
 }
+
+TEST_CASE("the watchdog reports stalled work and dispatches, attributed to "
+          "the addon that posted them") {
+  FakeJsQueue js;
+  auto context = HostContext::create(js.dispatcher());
+  hermes_napi_host *host = context->host("stalling-addon");
+
+  // Shared with the watchdog thread, which may still hold a copy of the
+  // options after this test has returned. Other tests' items can be
+  // reported while the watchdog is enabled, so only this addon's are kept.
+  struct Reports {
+    std::mutex mutex;
+    std::vector<HostContext::StallReport> reports;
+
+    bool waitFor(size_t count) {
+      for (int i = 0; i < 500; i++) {
+        {
+          std::lock_guard lock(mutex);
+          if (reports.size() >= count) {
+            return true;
+          }
+        }
+        std::this_thread::sleep_for(10ms);
+      }
+      return false;
+    }
+  };
+  auto collected = std::make_shared<Reports>();
+  HostContext::enableWatchdog({
+      .interval = 10ms,
+      .executeThreshold = 50ms,
+      .dispatchThreshold = 50ms,
+      .onStall =
+          [collected](const HostContext::StallReport &report) {
+            if (report.owner == "stalling-addon") {
+              std::lock_guard lock(collected->mutex);
+              collected->reports.push_back(report);
+            }
+          },
+  });
+
+  SECTION("an execute running past the threshold is reported once") {
+    auto *work = new GatedWork();
+    host->post_work(host->data, work, GatedWork::execute, GatedWork::complete);
+    REQUIRE(collected->waitFor(1));
+    // Let several more intervals pass while the item is still stuck.
+    std::this_thread::sleep_for(100ms);
+    work->openGate();
+    REQUIRE(js.waitForItems(1));
+    REQUIRE(js.drain() == 1);
+
+    std::lock_guard lock(collected->mutex);
+    REQUIRE(collected->reports.size() == 1);
+    const auto &report = collected->reports[0];
+    REQUIRE(report.kind == HostContext::StallReport::Kind::Execute);
+    REQUIRE(report.data == work);
+    REQUIRE(report.age >= 50ms);
+    delete work;
+  }
+
+  SECTION("only the oldest undelivered dispatch is reported, with the size "
+          "of the backlog behind it") {
+    int first = 0;
+    int second = 0;
+    auto callback = [](void *) {};
+    host->post_task(host->data, &first, callback);
+    host->post_task(host->data, &second, callback);
+    host->post_task(host->data, &second, callback);
+    REQUIRE(collected->waitFor(1));
+    std::this_thread::sleep_for(100ms);
+    REQUIRE(js.drain() == 3);
+
+    std::lock_guard lock(collected->mutex);
+    REQUIRE(collected->reports.size() == 1);
+    const auto &report = collected->reports[0];
+    REQUIRE(report.kind == HostContext::StallReport::Kind::Task);
+    REQUIRE(report.data == &first);
+    REQUIRE(report.backlog == 3);
+  }
+
+  HostContext::disableWatchdog();
+}
+
+TEST_CASE("usage attributes callback time to the addon that posted it") {
+  FakeJsQueue js;
+  auto context = HostContext::create(js.dispatcher());
+  hermes_napi_host *busyAddon = context->host("busy-addon");
+  hermes_napi_host *idleAddon = context->host("idle-addon");
+
+  // Spins rather than sleeps, so that it also shows up as CPU time.
+  auto spin = [](void *) {
+    const auto until = std::chrono::steady_clock::now() + 20ms;
+    while (std::chrono::steady_clock::now() < until) {
+    }
+  };
+  busyAddon->post_work(busyAddon->data, nullptr, spin,
+                       [](void *, napi_status) {});
+  REQUIRE(js.waitForItems(1));
+  busyAddon->post_task(busyAddon->data, nullptr, spin);
+  REQUIRE(js.drain() == 2);
+
+  const auto usage = context->usage();
+  REQUIRE(usage.size() == 2);
+  for (const auto &addon : usage) {
+    if (addon.owner == "busy-addon") {
+      CHECK(addon.executions == 1);
+      CHECK(addon.executeWallTime >= 20ms);
+      // How much of it was CPU time depends on the machine's load.
+      CHECK(addon.executeCpuTime > 0ms);
+      CHECK(addon.executeCpuTime <= addon.executeWallTime);
+      CHECK(addon.completions == 1);
+      CHECK(addon.taskDispatches == 1);
+      CHECK(addon.taskTime >= 20ms);
+    } else {
+      CHECK(addon.owner == "idle-addon");
+      CHECK(addon.executions == 0);
+      CHECK(addon.executeWallTime == 0ms);
+      CHECK(addon.completions == 0);
+      CHECK(addon.taskDispatches == 0);
+    }
+  }
+  (void)idleAddon;
+}
+
+TEST_CASE("contexts of reloaded runtimes are freed, and their host structs "
+          "drop later calls") {
+  // Models many reloads: each runtime gets a context serving a few addons,
+  // which post work and dispatches before the context is released.
+  constexpr int kReloads = 2000;
+  constexpr int kAddons = 3;
+  FakeJsQueue js;
+  std::vector<std::weak_ptr<HostContext>> released;
+  std::vector<hermes_napi_host *> hosts;
+  std::atomic<int> completions{0};
+  std::atomic<int> dispatches{0};
+  for (int reload = 0; reload < kReloads; reload++) {
+    auto context = HostContext::create(js.dispatcher());
+    for (int addon = 0; addon < kAddons; addon++) {
+      hermes_napi_host *host = context->host("addon-" + std::to_string(addon));
+      host->post_work(
+          host->data, &completions, [](void *) {},
+          [](void *data, napi_status) {
+            static_cast<std::atomic<int> *>(data)->fetch_add(1);
+          });
+      host->post_task(host->data, &dispatches, [](void *data) {
+        static_cast<std::atomic<int> *>(data)->fetch_add(1);
+      });
+      hosts.push_back(host);
+    }
+    released.push_back(context);
+    if (reload % 100 == 99) {
+      REQUIRE(js.waitForItems(2 * kAddons * 100));
+      js.drain();
+    }
+  }
+  REQUIRE(completions.load() == kReloads * kAddons);
+  REQUIRE(dispatches.load() == kReloads * kAddons);
+  // A worker drops its reference to the context just after posting the
+  // completion, so the last ones may take a moment to be freed.
+  const auto deadline = std::chrono::steady_clock::now() + 5s;
+  for (const auto &context : released) {
+    while (!context.expired() &&
+           std::chrono::steady_clock::now() < deadline) {
+      std::this_thread::sleep_for(1ms);
+    }
+    REQUIRE(context.expired());
+  }
+
+  // Hermes may still call through the struct of a freed context during
+  // teardown: work and dispatches are dropped and cancellation fails.
+  hermes_napi_host *stale = hosts.front();
+  auto *work = new GatedWork();
+  stale->post_work(stale->data, work, GatedWork::execute, GatedWork::complete);
+  CHECK_FALSE(stale->cancel_work(stale->data, work));
+  stale->post_task(stale->data, &dispatches, [](void *data) {
+    static_cast<std::atomic<int> *>(data)->fetch_add(1);
+  });
+  std::this_thread::sleep_for(50ms);
+  CHECK(js.drain() == 0);
+  CHECK(work->executions.load() == 0);
+  CHECK(dispatches.load() == kReloads * kAddons);
+  delete work;
+}
@@ -0,0 +1,145 @@
+// Exercises the host's extensions against injected fakes of the Node-API
+// functions they build on: a number is modeled as the address of a double,
+// and a property key as the address of its interned name.
+#include <catch2/catch_test_macros.hpp>
+
+#include <HostExtensions.hpp>
+#include <weak_node_api.hpp>
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <map>
+#include <string>
+
+using namespace callstack::react_native_node_api;
+
+namespace {
+
+struct FakeValues {
+  std::deque<double> numbers;
+  std::deque<std::string> interned;
+  int internCalls = 0;
+  std::map<std::string, double> properties;
+
+  static FakeValues &instance() {
+    static FakeValues values;
+    return values;
+  }
+
+  static napi_value number(double value) {
+    auto &numbers = instance().numbers;
+    numbers.push_back(value);
+    return reinterpret_cast<napi_value>(&numbers.back());
+  }
+};
+
+void injectFakeValues() {
+  FakeValues::instance() = FakeValues{};
+  inject_weak_node_api_host(NodeApiHost{
+      .napi_create_double = [](napi_env, double value,
+                               napi_value *result) -> napi_status {
+        *result = FakeValues::number(value);
+        return napi_ok;
+      },
+      .napi_get_value_double = [](napi_env, napi_value value,
+                                  double *result) -> napi_status {
+        if (value == nullptr) {
+          return napi_number_expected;
+        }
+        *result = *reinterpret_cast<double *>(value);
+        return napi_ok;
+      },
+      .napi_set_property = [](napi_env, napi_value, napi_value key,
+                              napi_value value) -> napi_status {
+        FakeValues::instance().properties[*reinterpret_cast<std::string *>(
+            key)] = *reinterpret_cast<double *>(value);
+        return napi_ok;
+      },
+      .napi_get_cb_info = [](napi_env, napi_callback_info info, size_t *argc,
+                             napi_value *argv, napi_value *,
+                             void **) -> napi_status {
+        // The info is the arguments' count.
+        const auto count = reinterpret_cast<uintptr_t>(info);
+        for (size_t i = 0; i < *argc && i < count; i++) {
+          argv[i] = FakeValues::number(static_cast<double>(i) + 0.5);
+        }
+        *argc = count;
+        return napi_ok;
+      },
+      .napi_create_reference = [](napi_env, napi_value value, uint32_t,
+                                  napi_ref *result) -> napi_status {
+        *result = reinterpret_cast<napi_ref>(value);
+        return napi_ok;
+      },
+      .napi_delete_reference = [](napi_env, napi_ref) -> napi_status {
+        return napi_ok;
+      },
+      .napi_get_reference_value = [](napi_env, napi_ref ref,
+                                     napi_value *result) -> napi_status {
+        *result = reinterpret_cast<napi_value>(ref);
+        return napi_ok;
+      },
+      .napi_add_env_cleanup_hook = [](napi_env, void (*)(void *arg),
+                                      void *) -> napi_status {
+        return napi_ok;
+      },
+      .node_api_create_property_key_utf8 =
+          [](napi_env, const char *str, size_t length,
+             napi_value *result) -> napi_status {
+        auto &values = FakeValues::instance();
+        values.internCalls++;
+        values.interned.emplace_back(
+            str, length == NAPI_AUTO_LENGTH ? strlen(str) : length);
+        *result = reinterpret_cast<napi_value>(&values.interned.back());
+        return napi_ok;
+      },
+  });
+}
+
+napi_callback_info callWithArguments(uintptr_t count) {
+  return reinterpret_cast<napi_callback_info>(count);
+}
+
+} // namespace
+
+TEST_CASE("node_api_ext_get_cb_doubles reads every argument") {
+  injectFakeValues();
+  const napi_env env = reinterpret_cast<napi_env>(0x10);
+
+  double argv[3];
+  size_t argc = std::size(argv);
+  REQUIRE(node_api_ext_get_cb_doubles(env, callWithArguments(2), &argc, argv,
+                                      nullptr) == napi_ok);
+  CHECK(argc == 2);
+  CHECK(argv[0] == 0.5);
+  CHECK(argv[1] == 1.5);
+  CHECK(std::isnan(argv[2]));
+
+  // More arguments than fit inline
+  double many[20];
+  argc = std::size(many);
+  REQUIRE(node_api_ext_get_cb_doubles(env, callWithArguments(20), &argc, many,
+                                      nullptr) == napi_ok);
+  CHECK(argc == 20);
+  CHECK(many[19] == 19.5);
+}
+
+TEST_CASE("node_api_ext_set_named_doubles interns each name once per env") {
+  injectFakeValues();
+  auto &values = FakeValues::instance();
+  const napi_env env = reinterpret_cast<napi_env>(0x20);
+  const napi_value object = reinterpret_cast<napi_value>(0x1);
+
+  const char *const names[] = {"x", "y", "z"};
+  const double first[] = {1.0, 2.0, 3.0};
+  const double second[] = {4.0, 5.0, 6.0};
+  REQUIRE(node_api_ext_set_named_doubles(env, object, 3, names, first) ==
+          napi_ok);
+  REQUIRE(node_api_ext_set_named_doubles(env, object, 3, names, second) ==
+          napi_ok);
+  CHECK(values.properties ==
+        std::map<std::string, double>{{"x", 4.0}, {"y", 5.0}, {"z", 6.0}});
+  CHECK(values.internCalls == 3);
+}
@@ -0,0 +1,189 @@
+// Exercises the logger (Logger.cpp) through a custom sink, which receives the
+// lines the logger thread (or log_error, synchronously) would otherwise write
+// to logcat or the standard streams.
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <Logger.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace callstack::react_native_node_api;
+using namespace std::chrono_literals;
+
+namespace {
+
+struct Line {
+  LogLevel level;
+  std::string text;
+};
+
+std::mutex linesMutex;
+std::vector<Line> lines;
+
+void collect(LogLevel level, const char *line, size_t length) {
+  std::lock_guard lock(linesMutex);
+  lines.push_back({level, std::string(line, length)});
+}
+
+std::vector<Line> collected() {
+  std::lock_guard lock(linesMutex);
+  return lines;
+}
+
+// Routes lines to `lines` for the duration of a test, restoring the defaults
+// afterwards.
+struct CollectedLogs {
+  CollectedLogs() {
+    flushLogs();
+    lines.clear();
+    setLogSink(collect);
+  }
+  ~CollectedLogs() {
+    flushLogs();
+    setLogSink(nullptr);
+    setLogLevel(LogLevel::Debug);
+    setLogRateLimit(20);
+  }
+};
+
+} // namespace
+
+TEST_CASE("the logger writes whole lines, in order per thread, from many "
+          "threads at once") {
+  CollectedLogs logs;
+  setLogRateLimit(0);
+  constexpr int kThreads = 8;
+  constexpr int kLinesPerThread = 5000;
+  const LogStats before = logStats();
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kThreads; t++) {
+    threads.emplace_back([t] {
+      for (int i = 0; i < kLinesPerThread; i++) {
+        log_warning("NapiHost: thread %d line %d", t, i);
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  const LogStats after = logStats();
+
+  std::vector<int> lastLine(kThreads, -1);
+  uint64_t received = 0;
+  for (const auto &line : collected()) {
+    int t = 0;
+    int i = 0;
+    char tail = 0;
+    if (sscanf(line.text.c_str(), "NapiHost: thread %d line %d%c", &t, &i,
+               &tail) != 2) {
+      // Only the logger's own reports of dropped lines may be mixed in.
+      REQUIRE(line.text.rfind("NapiHost: dropped ", 0) == 0);
+      continue;
+    }
+    REQUIRE(line.level == LogLevel::Warning);
+    REQUIRE(i > lastLine[t]);
+    lastLine[t] = i;
+    received++;
+  }
+  // Every line was either written or counted as dropped, never lost.
+  REQUIRE(received + (after.dropped - before.dropped) ==
+          kThreads * kLinesPerThread);
+  REQUIRE(received > 0);
+}
+
+TEST_CASE("the logger summarizes lines beyond the rate limit") {
+  CollectedLogs logs;
+  setLogRateLimit(5);
+  const LogStats before = logStats();
+
+  for (int i = 0; i < 100; i++) {
+    log_warning("NapiHost: repeated line %d", i);
+  }
+  flushLogs();
+  REQUIRE(collected().size() == 5);
+  REQUIRE(logStats().suppressed - before.suppressed == 95);
+
+  // The summary is written once the window has passed, by the logger thread
+  // if no further line from the same call site arrives first.
+  std::this_thread::sleep_for(1200ms);
+  flushLogs();
+  const auto result = collected();
+  REQUIRE(result.size() == 6);
+  REQUIRE(result.back().text ==
+          "NapiHost: suppressed 95 more lines like \"NapiHost: repeated line "
+          "%d\"");
+}
+
+TEST_CASE("info lines are never rate limited") {
+  CollectedLogs logs;
+  setLogRateLimit(5);
+
+  for (int i = 0; i < 30; i++) {
+    log_info("NapiHost: loaded addon %d", i);
+  }
+  flushLogs();
+  const auto result = collected();
+  REQUIRE(result.size() == 30);
+  REQUIRE(result[0].level == LogLevel::Info);
+  REQUIRE(result[29].text == "NapiHost: loaded addon 29");
+}
+
+TEST_CASE("the logger filters by level, and writes errors before returning") {
+  CollectedLogs logs;
+  setLogLevel(LogLevel::Error);
+
+  log_warning("NapiHost: filtered");
+  log_error("NapiHost: fatal %s", "error");
+  // No flush: errors are written synchronously.
+  const auto result = collected();
+  REQUIRE(result.size() == 1);
+  REQUIRE(result[0].level == LogLevel::Error);
+  REQUIRE(result[0].text == "NapiHost: fatal error");
+}
+
+TEST_CASE("the logger writes long errors whole") {
+  CollectedLogs logs;
+  const std::string stack(5000, 's');
+  log_error("napi_fatal_exception: %s", stack.c_str());
+  const auto result = collected();
+  REQUIRE(result.size() == 1);
+  REQUIRE(result[0].text == "napi_fatal_exception: " + stack);
+}
+
+TEST_CASE("the logger truncates long queued lines") {
+  CollectedLogs logs;
+  const std::string longText(1000, 'x');
+  log_warning("%s", longText.c_str());
+  flushLogs();
+  const auto result = collected();
+  REQUIRE(result.size() == 1);
+  REQUIRE(result[0].text == longText.substr(0, 255));
+}
+
+// Hidden from the default run; `node-api-host-tests "[benchmark]"` runs it.
+TEST_CASE("log_warning from 8 threads", "[.][benchmark]") {
+  CollectedLogs logs;
+  setLogRateLimit(0);
+  setLogSink([](LogLevel, const char *, size_t) {});
+
+  BENCHMARK("1000 lines per thread") {
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 8; t++) {
+      threads.emplace_back([t] {
+        for (int i = 0; i < 1000; i++) {
+          log_warning("NapiHost: thread %d line %d", t, i);
+        }
+      });
+    }
+    for (auto &thread : threads) {
+      thread.join();
+    }
+  };
+}
@@ -0,0 +1,406 @@
+// Exercises PropertyKeyCache, and the named property shadows reading through
+// it (RuntimeNodeApi.cpp), against injected fakes of the Node-API functions it
+// builds on: a property key is modeled as the address of its interned name,
+// which lets the tests see which key each property access used.
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <PropertyKeyCache.hpp>
+#include <RuntimeNodeApi.hpp>
+#include <weak_node_api.hpp>
+
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <iterator>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_set>
+
+namespace host = callstack::react_native_node_api;
+using namespace callstack::react_native_node_api;
+
+namespace {
+
+struct FakeKeys {
+  std::deque<std::string> interned;
+  int internCalls = 0;
+  std::map<napi_ref, int> liveReferences;
+  void (*cleanupHook)(void *) = nullptr;
+  void *cleanupArg = nullptr;
+  // The key used by the last property access.
+  napi_value lastKey = nullptr;
+
+  static FakeKeys &instance() {
+    static FakeKeys keys;
+    return keys;
+  }
+
+  static std::string nameOf(napi_value key) {
+    return *reinterpret_cast<std::string *>(key);
+  }
+};
+
+void injectFakeKeys() {
+  FakeKeys::instance() = FakeKeys{};
+  inject_weak_node_api_host(NodeApiHost{
+      .napi_set_property = [](napi_env, napi_value, napi_value key,
+                              napi_value) -> napi_status {
+        FakeKeys::instance().lastKey = key;
+        return napi_ok;
+      },
+      .napi_has_property = [](napi_env, napi_value, napi_value key,
+                              bool *result) -> napi_status {
+        FakeKeys::instance().lastKey = key;
+        *result = true;
+        return napi_ok;
+      },
+      .napi_get_property = [](napi_env, napi_value, napi_value key,
+                              napi_value *result) -> napi_status {
+        FakeKeys::instance().lastKey = key;
+        *result = key;
+        return napi_ok;
+      },
+      .napi_create_reference = [](napi_env, napi_value value, uint32_t,
+                                  napi_ref *result) -> napi_status {
+        *result = reinterpret_cast<napi_ref>(value);
+        FakeKeys::instance().liveReferences[*result]++;
+        return napi_ok;
+      },
+      .napi_delete_reference = [](napi_env, napi_ref ref) -> napi_status {
+        auto &live = FakeKeys::instance().liveReferences;
+        if (--live[ref] == 0) {
+          live.erase(ref);
+        }
+        return napi_ok;
+      },
+      .napi_get_reference_value = [](napi_env, napi_ref ref,
+                                     napi_value *result) -> napi_status {
+        *result = reinterpret_cast<napi_value>(ref);
+        return napi_ok;
+      },
+      .napi_add_env_cleanup_hook = [](napi_env, void (*fun)(void *arg),
+                                      void *arg) -> napi_status {
+        auto &keys = FakeKeys::instance();
+        keys.cleanupHook = fun;
+        keys.cleanupArg = arg;
+        return napi_ok;
+      },
+      .node_api_create_property_key_utf8 =
+          [](napi_env, const char *str, size_t length,
+             napi_value *result) -> napi_status {
+        auto &keys = FakeKeys::instance();
+        keys.internCalls++;
+        keys.interned.emplace_back(
+            str, length == NAPI_AUTO_LENGTH ? strlen(str) : length);
+        *result = reinterpret_cast<napi_value>(&keys.interned.back());
+        return napi_ok;
+      },
+  });
+}
+
+// Every test uses a fresh env, as caches outlive the fakes.
+napi_env freshEnv() {
+  static uintptr_t next = 0x1000;
+  return reinterpret_cast<napi_env>(next += 8);
+}
+
+napi_value object() { return reinterpret_cast<napi_value>(1); }
+
+// Tears the env down, as Hermes would.
+void tearDown() {
+  auto &keys = FakeKeys::instance();
+  keys.cleanupHook(keys.cleanupArg);
+}
+
+// A thread outliving the envs it uses, like a worker's, which runs one task
+// at a time for the test thread.
+class Worker {
+public:
+  Worker() : thread_([this] { loop(); }) {}
+  ~Worker() {
+    run(nullptr);
+    thread_.join();
+  }
+
+  // Runs `task` on the worker and waits for it; a null task stops it.
+  void run(std::function<void()> task) {
+    std::unique_lock lock(mutex_);
+    task_ = std::move(task);
+    pending_ = true;
+    changed_.notify_all();
+    changed_.wait(lock, [this] { return !pending_; });
+  }
+
+private:
+  void loop() {
+    std::unique_lock lock(mutex_);
+    for (;;) {
+      changed_.wait(lock, [this] { return pending_; });
+      auto task = std::move(task_);
+      if (task) {
+        lock.unlock();
+        task();
+        lock.lock();
+      }
+      pending_ = false;
+      changed_.notify_all();
+      if (!task) {
+        return;
+      }
+    }
+  }
+
+  std::mutex mutex_;
+  std::condition_variable changed_;
+  std::function<void()> task_;
+  bool pending_ = false;
+  std::thread thread_;
+};
+
+} // namespace
+
+TEST_CASE("PropertyKeyCache interns each name once per env") {
+  injectFakeKeys();
+  auto &keys = FakeKeys::instance();
+  const napi_env env = freshEnv();
+
+  napi_value result = nullptr;
+  for (int i = 0; i < 3; i++) {
+    REQUIRE(PropertyKeyCache::getNamedProperty(env, object(), "length",
+                                               &result) == napi_ok);
+    REQUIRE(FakeKeys::nameOf(result) == "length");
+  }
+  bool has = false;
+  REQUIRE(PropertyKeyCache::hasNamedProperty(env, object(), "length", &has) ==
+          napi_ok);
+  REQUIRE(PropertyKeyCache::setNamedProperty(env, object(), "length",
+                                             object()) == napi_ok);
+  REQUIRE(FakeKeys::nameOf(keys.lastKey) == "length");
+  REQUIRE(keys.internCalls == 1);
+
+  // Another env needs its own keys.
+  const napi_env other = freshEnv();
+  REQUIRE(PropertyKeyCache::getNamedProperty(other, object(), "length",
+                                             &result) == napi_ok);
+  REQUIRE(keys.internCalls == 2);
+  tearDown();
+}
+
+TEST_CASE("PropertyKeyCache re-interns a name buffer reused for another "
+          "name") {
+  injectFakeKeys();
+  auto &keys = FakeKeys::instance();
+  const napi_env env = freshEnv();
+
+  char name[16] = "first";
+  napi_value result = nullptr;
+  REQUIRE(PropertyKeyCache::getNamedProperty(env, object(), name, &result) ==
+          napi_ok);
+  strcpy(name, "second");
+  REQUIRE(PropertyKeyCache::getNamedProperty(env, object(), name, &result) ==
+          napi_ok);
+  REQUIRE(FakeKeys::nameOf(result) == "second");
+  REQUIRE(keys.internCalls == 2);
+  // The stale key is no longer held.
+  REQUIRE(keys.liveReferences.size() == 1);
+  tearDown();
+}
+
+TEST_CASE("PropertyKeyCache releases an env's keys when it is torn down") {
+  injectFakeKeys();
+  auto &keys = FakeKeys::instance();
+  const napi_env env = freshEnv();
+
+  napi_value result = nullptr;
+  PropertyKeyCache::getNamedProperty(env, object(), "a", &result);
+  PropertyKeyCache::getNamedProperty(env, object(), "b", &result);
+  REQUIRE(PropertyKeyCache::size(env) == 2);
+  REQUIRE(keys.liveReferences.size() == 2);
+
+  tearDown();
+  REQUIRE(PropertyKeyCache::size(env) == 0);
+  REQUIRE(keys.liveReferences.empty());
+}
+
+TEST_CASE("PropertyKeyCache drops keys another thread cached for a torn-down "
+          "env") {
+  injectFakeKeys();
+  auto &keys = FakeKeys::instance();
+  const napi_env env = freshEnv();
+  Worker worker;
+
+  napi_value result = nullptr;
+  napi_status status = napi_generic_failure;
+  worker.run([&] {
+    status = PropertyKeyCache::getNamedProperty(env, object(), "length",
+                                                &result);
+  });
+  REQUIRE(status == napi_ok);
+  REQUIRE(keys.internCalls == 1);
+
+  // Torn down on this thread, then reused by a new env at the same address,
+  // which the worker must not serve the first env's key to.
+  tearDown();
+  worker.run([&] {
+    status = PropertyKeyCache::getNamedProperty(env, object(), "length",
+                                                &result);
+  });
+  REQUIRE(status == napi_ok);
+  REQUIRE(keys.internCalls == 2);
+  REQUIRE(FakeKeys::nameOf(result) == "length");
+  REQUIRE(result == reinterpret_cast<napi_value>(&keys.interned.back()));
+  tearDown();
+}
+
+TEST_CASE("PropertyKeyCache stops caching at its capacity") {
+  injectFakeKeys();
+  auto &keys = FakeKeys::instance();
+  const napi_env env = freshEnv();
+
+  std::deque<std::string> names;
+  napi_value result = nullptr;
+  for (size_t i = 0; i <= PropertyKeyCache::kMaxEntries; i++) {
+    names.push_back("name" + std::to_string(i));
+    REQUIRE(PropertyKeyCache::getNamedProperty(env, object(),
+                                               names.back().c_str(),
+                                               &result) == napi_ok);
+  }
+  REQUIRE(PropertyKeyCache::size(env) == PropertyKeyCache::kMaxEntries);
+
+  // The name past capacity still works, interned on every call.
+  const int internCalls = keys.internCalls;
+  REQUIRE(PropertyKeyCache::getNamedProperty(env, object(),
+                                             names.back().c_str(),
+                                             &result) == napi_ok);
+  REQUIRE(FakeKeys::nameOf(result) == names.back());
+  REQUIRE(keys.internCalls == internCalls + 1);
+  tearDown();
+}
+
+TEST_CASE("PropertyKeyCache rejects a null name") {
+  injectFakeKeys();
+  napi_value result = nullptr;
+  REQUIRE(PropertyKeyCache::getNamedProperty(freshEnv(), object(), nullptr,
+                                             &result) == napi_invalid_arg);
+}
+
+TEST_CASE("the named property shadows read through PropertyKeyCache") {
+  injectFakeKeys();
+  auto &keys = FakeKeys::instance();
+  const napi_env env = freshEnv();
+
+  // Qualified: the runtime's functions would be found as well through the
+  // napi_env argument.
+  napi_value result = nullptr;
+  bool has = false;
+  REQUIRE(host::napi_get_named_property(
+              env, object(), "length", &result) == napi_ok);
+  REQUIRE(host::napi_has_named_property(
+              env, object(), "length", &has) == napi_ok);
+  REQUIRE(host::napi_set_named_property(
+              env, object(), "length", object()) == napi_ok);
+  REQUIRE(FakeKeys::nameOf(keys.lastKey) == "length");
+  REQUIRE(keys.internCalls == 1);
+  tearDown();
+}
+
+namespace {
+
+// Stands in for the runtime's identifier table: every lookup by C string
+// hashes the name and finds its interned copy, as Hermes does for each
+// napi_get_named_property call.
+struct FakeIdentifiers {
+  std::unordered_set<std::string> table;
+  double value = 2;
+
+  static FakeIdentifiers &instance() {
+    static FakeIdentifiers identifiers;
+    return identifiers;
+  }
+
+  napi_value intern(const char *name) {
+    auto it = table.emplace(name).first;
+    return reinterpret_cast<napi_value>(const_cast<std::string *>(&*it));
+  }
+};
+
+void injectFakeIdentifiers() {
+  inject_weak_node_api_host(NodeApiHost{
+      .napi_get_property = [](napi_env, napi_value, napi_value,
+                              napi_value *result) -> napi_status {
+        *result =
+            reinterpret_cast<napi_value>(&FakeIdentifiers::instance().value);
+        return napi_ok;
+      },
+      .napi_get_named_property = [](napi_env, napi_value, const char *utf8name,
+                                    napi_value *result) -> napi_status {
+        auto &identifiers = FakeIdentifiers::instance();
+        identifiers.intern(utf8name);
+        *result = reinterpret_cast<napi_value>(&identifiers.value);
+        return napi_ok;
+      },
+      .napi_create_reference = [](napi_env, napi_value value, uint32_t,
+                                  napi_ref *result) -> napi_status {
+        *result = reinterpret_cast<napi_ref>(value);
+        return napi_ok;
+      },
+      .napi_delete_reference = [](napi_env, napi_ref) -> napi_status {
+        return napi_ok;
+      },
+      .napi_get_reference_value = [](napi_env, napi_ref ref,
+                                     napi_value *result) -> napi_status {
+        *result = reinterpret_cast<napi_value>(ref);
+        return napi_ok;
+      },
+      .napi_add_env_cleanup_hook = [](napi_env, void (*)(void *arg),
+                                      void *) -> napi_status {
+        return napi_ok;
+      },
+      .node_api_create_property_key_utf8 =
+          [](napi_env, const char *str, size_t,
+             napi_value *result) -> napi_status {
+        *result = FakeIdentifiers::instance().intern(str);
+        return napi_ok;
+      },
+  });
+}
+
+} // namespace
+
+// Hidden from the default run; `node-api-host-tests "[benchmark]"` runs it.
+// The host side only: the property-keys example in node-addon-examples
+// measures the same reads against Hermes.
+TEST_CASE("repeated named property reads", "[.][benchmark]") {
+  injectFakeIdentifiers();
+  const napi_env env = freshEnv();
+  // Names of the length addons typically read, among others in the table.
+  const char *const kNames[] = {"byteLength", "prototype", "constructor",
+                                "addEventListener"};
+  auto &identifiers = FakeIdentifiers::instance();
+  for (int i = 0; i < 1000; i++) {
+    identifiers.intern(("property" + std::to_string(i)).c_str());
+  }
+  constexpr int kReads = 1000;
+
+  BENCHMARK("interned by the runtime on every read") {
+    napi_value result = nullptr;
+    for (int i = 0; i < kReads; i++) {
+      ::napi_get_named_property(env, object(), kNames[i % std::size(kNames)],
+                                &result);
+    }
+    return result;
+  };
+
+  BENCHMARK("through PropertyKeyCache") {
+    napi_value result = nullptr;
+    for (int i = 0; i < kReads; i++) {
+      host::napi_get_named_property(
+          env, object(), kNames[i % std::size(kNames)], &result);
+    }
+    return result;
+  };
+}
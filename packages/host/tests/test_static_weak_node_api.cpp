@@ -0,0 +1,69 @@
+// Exercises weak-node-api-static against static_test_addon.cpp, an addon
+// linking it, which must call the host injected into the weak-node-api
+// library without being injected into itself, and registering_test_addon.cpp,
+// which calls Node-API as its library loads, before a host could inject into
+// it, linked against both variants.
+#include <catch2/catch_test_macros.hpp>
+
+#include <weak_node_api.hpp>
+
+#include <cstdint>
+#include <string>
+
+#include <dlfcn.h>
+
+namespace {
+
+napi_value fakeValue(uintptr_t value) {
+  return reinterpret_cast<napi_value>(value);
+}
+
+napi_module *registered = nullptr;
+
+void injectFakeHost(uintptr_t undefinedValue) {
+  static uintptr_t undefined = 0;
+  undefined = undefinedValue;
+  registered = nullptr;
+  inject_weak_node_api_host(NodeApiHost{
+      .napi_get_undefined = [](napi_env, napi_value *result) -> napi_status {
+        *result = fakeValue(undefined);
+        return napi_ok;
+      },
+      .napi_module_register = [](napi_module *module) { registered = module; },
+  });
+}
+
+// Loads the library at `path`, as hermes_napi_load_module does, and checks
+// that its static initializer registered an addon calling the fake host.
+void checkRegisters(const char *path) {
+  injectFakeHost(0x3);
+  void *library = dlopen(path, RTLD_NOW | RTLD_LOCAL);
+  REQUIRE(library != nullptr);
+  REQUIRE(registered != nullptr);
+  CHECK(registered->nm_modname == std::string("registering-test-addon"));
+  CHECK(registered->nm_register_func(nullptr, nullptr) == fakeValue(0x3));
+  dlclose(library);
+}
+
+} // namespace
+
+TEST_CASE("an addon linking weak-node-api statically calls the host injected "
+          "into the weak-node-api library") {
+  injectFakeHost(0x1);
+  void *library = dlopen(STATIC_TEST_ADDON_PATH, RTLD_NOW | RTLD_LOCAL);
+  REQUIRE(library != nullptr);
+  auto init = reinterpret_cast<napi_addon_register_func>(
+      dlsym(library, "napi_register_module_v1"));
+  REQUIRE(init != nullptr);
+  CHECK(init(nullptr, nullptr) == fakeValue(0x1));
+  dlclose(library);
+}
+
+TEST_CASE("an addon registering itself as it loads reaches the host") {
+  SECTION("linking weak-node-api") {
+    checkRegisters(REGISTERING_TEST_ADDON_PATH);
+  }
+  SECTION("linking weak-node-api-static") {
+    checkRegisters(REGISTERING_TEST_ADDON_STATIC_PATH);
+  }
+}
@@ -0,0 +1,176 @@
+// Exercises the worker thread platform layer (ThreadPolicy.cpp) by inspecting
+// the kernel's view of the affected threads through /proc, which is why these
+// tests only run on Linux.
+#include <catch2/catch_test_macros.hpp>
+
+#include <HermesNapiHost.hpp>
+#include <ThreadPolicy.hpp>
+
+#if defined(__linux__)
+
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <thread>
+
+using namespace callstack::react_native_node_api;
+
+namespace {
+
+pid_t currentThreadId() { return static_cast<pid_t>(syscall(SYS_gettid)); }
+
+std::string readProcFile(pid_t tid, const char *name) {
+  std::ifstream file("/proc/self/task/" + std::to_string(tid) + "/" + name);
+  return std::string(std::istreambuf_iterator<char>(file), {});
+}
+
+std::string threadName(pid_t tid) {
+  std::string comm = readProcFile(tid, "comm");
+  if (!comm.empty() && comm.back() == '\n') {
+    comm.pop_back();
+  }
+  return comm;
+}
+
+int threadNiceValue(pid_t tid) {
+  // The comm field (2) is parenthesized and may contain spaces, so count
+  // fields from the closing parenthesis: nice is field 19 overall.
+  const std::string stat = readProcFile(tid, "stat");
+  std::istringstream fields(stat.substr(stat.rfind(')') + 2));
+  std::string field;
+  for (int i = 3; i <= 19; i++) {
+    fields >> field;
+  }
+  return std::stoi(field);
+}
+
+std::string threadStatusField(pid_t tid, const std::string &key) {
+  std::istringstream status(readProcFile(tid, "status"));
+  for (std::string line; std::getline(status, line);) {
+    if (line.rfind(key + ":", 0) == 0) {
+      return line.substr(line.find_first_not_of(" \t", key.size() + 1));
+    }
+  }
+  return {};
+}
+
+int firstAllowedCpu() {
+  cpu_set_t cpus;
+  CPU_ZERO(&cpus);
+  sched_getaffinity(0, sizeof(cpus), &cpus);
+  for (int cpu = 0; cpu < 64; cpu++) {
+    if (CPU_ISSET(cpu, &cpus)) {
+      return cpu;
+    }
+  }
+  return -1;
+}
+
+// Runs `apply` on a fresh thread, then `check` with that thread's id while
+// holding the thread alive so its /proc entry can still be inspected.
+template <typename Apply, typename Check>
+void onFreshThread(Apply apply, Check check) {
+  std::atomic<pid_t> tid{0};
+  std::atomic<bool> done{false};
+  std::thread thread([&] {
+    apply();
+    tid = currentThreadId();
+    while (!done.load()) {
+      std::this_thread::yield();
+    }
+  });
+  while (tid.load() == 0) {
+    std::this_thread::yield();
+  }
+  check(tid.load());
+  done = true;
+  thread.join();
+}
+
+} // namespace
+
+TEST_CASE("setCurrentThreadName names the calling thread") {
+  SECTION("a short name is applied verbatim") {
+    onFreshThread([] { setCurrentThreadName("napi-test"); },
+                  [](pid_t tid) { REQUIRE(threadName(tid) == "napi-test"); });
+  }
+
+  SECTION("a name beyond the kernel's limit is truncated, not rejected") {
+    onFreshThread(
+        [] { setCurrentThreadName("napi-worker-with-a-long-name"); },
+        [](pid_t tid) { REQUIRE(threadName(tid) == "napi-worker-wit"); });
+  }
+}
+
+TEST_CASE("applyThreadPolicy applies the nice value and affinity mask to the "
+          "calling thread only") {
+  const int cpu = firstAllowedCpu();
+  REQUIRE(cpu >= 0);
+  const int callerNice = threadNiceValue(currentThreadId());
+  const std::string callerCpus =
+      threadStatusField(currentThreadId(), "Cpus_allowed_list");
+
+  onFreshThread(
+      [cpu] {
+        // Lowering priority needs no privileges, so any nice value above the
+        // inherited one is applied.
+        applyThreadPolicy(ThreadPolicy{
+            .niceValue = 19,
+            .affinityMask = uint64_t{1} << cpu,
+        });
+      },
+      [cpu](pid_t tid) {
+        REQUIRE(threadNiceValue(tid) == 19);
+        REQUIRE(threadStatusField(tid, "Cpus_allowed_list") ==
+                std::to_string(cpu));
+      });
+
+  REQUIRE(threadNiceValue(currentThreadId()) == callerNice);
+  REQUIRE(threadStatusField(currentThreadId(), "Cpus_allowed_list") ==
+          callerCpus);
+}
+
+TEST_CASE("an empty policy leaves inherited attributes untouched") {
+  const int callerNice = threadNiceValue(currentThreadId());
+  onFreshThread([] { applyThreadPolicy(ThreadPolicy{}); },
+                [callerNice](pid_t tid) {
+                  REQUIRE(threadNiceValue(tid) == callerNice);
+                });
+}
+
+TEST_CASE("pool workers are named napi-worker-N and reject a policy once "
+          "started") {
+  // Completions are never delivered: only the execute side is observed.
+  auto context =
+      HostContext::create([](std::function<void()> &&) { return true; });
+  hermes_napi_host *host = context->host();
+
+  struct Work {
+    std::string name;
+    std::atomic<bool> done{false};
+  } work;
+  host->post_work(
+      host->data, &work,
+      [](void *data) {
+        auto *w = static_cast<Work *>(data);
+        w->name = threadName(currentThreadId());
+        w->done = true;
+      },
+      [](void *, napi_status) {});
+  while (!work.done.load()) {
+    std::this_thread::yield();
+  }
+
+  REQUIRE(work.name.rfind("napi-worker-", 0) == 0);
+  REQUIRE(!HostContext::setWorkerThreadPolicy(
+      ThreadPolicy{.niceValue = 5, .affinityMask = std::nullopt}));
+}
+
+#endif
@@ -0,0 +1,86 @@
+// Exercises the once-guard of ensureInjectedIntoWeakNodeApi against a stand-in
+// for the generated injectIntoWeakNodeApi, which the tests do not link, and
+// measures what deferring the injection saves at startup.
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <WeakNodeApiInjector.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include <spawn.h>
+#include <sys/wait.h>
+
+namespace {
+std::atomic<int> injections{0};
+} // namespace
+
+namespace callstack::react_native_node_api {
+void injectIntoWeakNodeApi() {
+  // Slow enough for the other threads to race it.
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  injections++;
+}
+} // namespace callstack::react_native_node_api
+
+TEST_CASE("ensureInjectedIntoWeakNodeApi injects once across threads") {
+  using callstack::react_native_node_api::ensureInjectedIntoWeakNodeApi;
+  std::atomic<int> injectedBy{0};
+  std::atomic<int> returnedBeforeInjection{0};
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 8; i++) {
+    threads.emplace_back([&] {
+      if (ensureInjectedIntoWeakNodeApi()) {
+        injectedBy++;
+      }
+      if (injections == 0) {
+        returnedBeforeInjection++;
+      }
+    });
+  }
+  for (std::thread &thread : threads) {
+    thread.join();
+  }
+  CHECK(injections == 1);
+  CHECK(injectedBy == 1);
+  CHECK(returnedBeforeInjection == 0);
+  CHECK_FALSE(ensureInjectedIntoWeakNodeApi());
+  CHECK(injections == 1);
+}
+
+namespace {
+
+// Runs the startup probe to completion, in a process of its own: this one
+// has weak-node-api loaded already.
+int runStartupProbe(const char *mode) {
+  char *const argv[] = {const_cast<char *>(STARTUP_PROBE_PATH),
+                        const_cast<char *>(mode), nullptr};
+  pid_t child = 0;
+  if (posix_spawn(&child, STARTUP_PROBE_PATH, nullptr, nullptr, argv,
+                  nullptr) != 0) {
+    return -1;
+  }
+  int status = 0;
+  if (waitpid(child, &status, 0) != child || !WIFEXITED(status)) {
+    return -1;
+  }
+  return WEXITSTATUS(status);
+}
+
+} // namespace
+
+// Hidden from the default run; `node-api-host-tests "[benchmark]"` runs it.
+// Both include starting a process: their difference is what a launch loading
+// no addon saves.
+TEST_CASE("starting an app", "[.][benchmark]") {
+  BENCHMARK("injecting weak-node-api as the host loads") {
+    REQUIRE(runStartupProbe("inject") == 0);
+  };
+
+  BENCHMARK("deferring the injection to the first addon") {
+    REQUIRE(runStartupProbe("defer") == 0);
+  };
+}
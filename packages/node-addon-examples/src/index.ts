@@ -86,8 +86,15 @@ export const suites: Record<
       require("../tests/buffers/addon.js");
     },
     async: () => require("../tests/async/addon.js") as () => Promise<void>,
+    bind: () => require("../tests/bind/addon.js") as () => void,
+    "host-extensions": () =>
+      require("../tests/host-extensions/addon.js") as () => void,
     "module-register": () =>
       require("../tests/module-register/addon.js") as () => void,
+    "property-keys": () =>
+      require("../tests/property-keys/addon.js") as () => void,
+    "stream-channel": () =>
+      require("../tests/stream-channel/addon.js") as () => Promise<void>,
     "threadsafe-function": () =>
       require("../tests/threadsafe-function/addon.js") as () => Promise<void>,
   },
@@ -0,0 +1,65 @@
+// Exposes the same functions twice, through hand-written callbacks and
+// through callbacks generated by weak_node_api_bind.hpp, so addon.js can
+// compare the two.
+#include <node_api.h>
+#include <weak_node_api_bind.hpp>
+
+#include <cstdint>
+
+#include "../RuntimeNodeApiTestsCommon.h"
+
+static double Lerp(double a, double b, double t) { return a + (b - a) * t; }
+
+static int32_t Clamp(int32_t value, int32_t min, int32_t max) {
+  return value < min ? min : value > max ? max : value;
+}
+
+// The callbacks a C addon would write for them, relying on the status of
+// each conversion for type checks, like the generated ones.
+
+static napi_value LerpHandWritten(napi_env env, napi_callback_info info) {
+  size_t argc = 3;
+  napi_value argv[3];
+  NODE_API_CALL(env, napi_get_cb_info(env, info, &argc, argv, NULL, NULL));
+  double args[3];
+  for (size_t i = 0; i < 3; i++) {
+    NODE_API_CALL(env, napi_get_value_double(env, argv[i], &args[i]));
+  }
+
+  napi_value result;
+  NODE_API_CALL(env,
+      napi_create_double(env, Lerp(args[0], args[1], args[2]), &result));
+  return result;
+}
+
+static napi_value ClampHandWritten(napi_env env, napi_callback_info info) {
+  size_t argc = 3;
+  napi_value argv[3];
+  NODE_API_CALL(env, napi_get_cb_info(env, info, &argc, argv, NULL, NULL));
+  int32_t args[3];
+  for (size_t i = 0; i < 3; i++) {
+    NODE_API_CALL(env, napi_get_value_int32(env, argv[i], &args[i]));
+  }
+
+  napi_value result;
+  NODE_API_CALL(env,
+      napi_create_int32(env, Clamp(args[0], args[1], args[2]), &result));
+  return result;
+}
+
+static napi_value Init(napi_env env, napi_value exports) {
+  napi_property_descriptor properties[] = {
+      DECLARE_NODE_API_PROPERTY("LerpHandWritten", LerpHandWritten),
+      DECLARE_NODE_API_PROPERTY("ClampHandWritten", ClampHandWritten),
+      weak_node_api::method<&Lerp>("LerpBound"),
+      weak_node_api::method<&Clamp>("ClampBound"),
+  };
+
+  NODE_API_CALL(env,
+      napi_define_properties(
+          env, exports, sizeof(properties) / sizeof(properties[0]),
+          properties));
+
+  return exports;
+}
+NAPI_MODULE(NODE_GYP_MODULE_NAME, Init)
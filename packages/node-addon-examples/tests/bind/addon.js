@@ -0,0 +1,35 @@
+// Calls the same native functions many times, through hand-written callbacks
+// and through callbacks generated by weak_node_api_bind.hpp, and logs how
+// long each took.
+const assert = require("assert");
+// cmake-rn emits to {targetSourceDir}/build/{configuration}, and this package's
+// build script pins the configuration.
+const addon = require("./build/RelWithDebInfo/addon.node");
+
+const ITERATIONS = 100_000;
+
+function measure(name, call) {
+  const start = performance.now();
+  let sum = 0;
+  for (let i = 0; i < ITERATIONS; i++) {
+    sum += call(i);
+  }
+  const elapsed = performance.now() - start;
+  console.log(`${name}: ${ITERATIONS} calls in ${elapsed.toFixed(1)} ms`);
+  return sum;
+}
+
+module.exports = () => {
+  assert.strictEqual(
+    measure("hand-written lerp", (i) => addon.LerpHandWritten(0, i, 0.5)),
+    measure("bound lerp", (i) => addon.LerpBound(0, i, 0.5)),
+  );
+  assert.strictEqual(
+    measure("hand-written clamp", (i) => addon.ClampHandWritten(i, 10, 100)),
+    measure("bound clamp", (i) => addon.ClampBound(i, 10, 100)),
+  );
+  assert.throws(() => addon.LerpBound(0, "1", 0.5), {
+    name: "TypeError",
+    message: "Argument 2 must be a number",
+  });
+};
@@ -0,0 +1,117 @@
+// Does the same work twice, once with a Node-API call per value and once
+// with the matching weak-node-api host extension, so addon.js can compare
+// the two: the extensions make one call into the host where Node-API makes
+// one per argument read or property set.
+#include <math.h>
+#include <stdbool.h>
+#include <node_api.h>
+#include <weak_node_api_extensions.h>
+#include "../RuntimeNodeApiTestsCommon.h"
+
+#define POINT_ARGS 6
+
+static double Distance(const double* args) {
+  const double dx = args[3] - args[0];
+  const double dy = args[4] - args[1];
+  const double dz = args[5] - args[2];
+  return sqrt(dx * dx + dy * dy + dz * dz);
+}
+
+// Distance(x1, y1, z1, x2, y2, z2), reading each argument.
+static napi_value DistanceEach(napi_env env, napi_callback_info info) {
+  size_t argc = POINT_ARGS;
+  napi_value argv[POINT_ARGS];
+  NODE_API_CALL(env, napi_get_cb_info(env, info, &argc, argv, NULL, NULL));
+  NODE_API_ASSERT(env, argc == POINT_ARGS, "Expected two points");
+  double args[POINT_ARGS];
+  for (size_t i = 0; i < POINT_ARGS; i++) {
+    NODE_API_CALL(env, napi_get_value_double(env, argv[i], &args[i]));
+  }
+
+  napi_value result;
+  NODE_API_CALL(env, napi_create_double(env, Distance(args), &result));
+  return result;
+}
+
+// Distance(x1, y1, z1, x2, y2, z2), reading every argument at once.
+static napi_value DistanceBulk(napi_env env, napi_callback_info info) {
+  size_t argc = POINT_ARGS;
+  double args[POINT_ARGS];
+  NODE_API_CALL(env,
+      node_api_ext_get_cb_doubles(env, info, &argc, args, NULL));
+  NODE_API_ASSERT(env, argc == POINT_ARGS, "Expected two points");
+
+  napi_value result;
+  NODE_API_CALL(env, napi_create_double(env, Distance(args), &result));
+  return result;
+}
+
+#define BOUNDS_FIELDS 4
+static const char* const kBoundsNames[BOUNDS_FIELDS] = {
+    "left", "top", "right", "bottom"};
+
+// Reads the size argument of Bounds*, returning false with an exception
+// pending if that fails.
+static bool GetBounds(napi_env env, napi_callback_info info, double* bounds) {
+  size_t argc = 1;
+  napi_value argv[1];
+  double size = 0;
+  NODE_API_CALL_BASE(
+      env, napi_get_cb_info(env, info, &argc, argv, NULL, NULL), false);
+  NODE_API_CALL_BASE(env, napi_get_value_double(env, argv[0], &size), false);
+  bounds[0] = -size;
+  bounds[1] = -size;
+  bounds[2] = size;
+  bounds[3] = size;
+  return true;
+}
+
+// Bounds(size): { left, top, right, bottom }, setting each property.
+static napi_value BoundsEach(napi_env env, napi_callback_info info) {
+  double bounds[BOUNDS_FIELDS];
+  if (!GetBounds(env, info, bounds)) {
+    return NULL;
+  }
+
+  napi_value result;
+  NODE_API_CALL(env, napi_create_object(env, &result));
+  for (size_t i = 0; i < BOUNDS_FIELDS; i++) {
+    napi_value value;
+    NODE_API_CALL(env, napi_create_double(env, bounds[i], &value));
+    NODE_API_CALL(env,
+        napi_set_named_property(env, result, kBoundsNames[i], value));
+  }
+  return result;
+}
+
+// Bounds(size): { left, top, right, bottom }, setting every property at once.
+static napi_value BoundsBulk(napi_env env, napi_callback_info info) {
+  double bounds[BOUNDS_FIELDS];
+  if (!GetBounds(env, info, bounds)) {
+    return NULL;
+  }
+
+  napi_value result;
+  NODE_API_CALL(env, napi_create_object(env, &result));
+  NODE_API_CALL(env,
+      node_api_ext_set_named_doubles(
+          env, result, BOUNDS_FIELDS, kBoundsNames, bounds));
+  return result;
+}
+
+static napi_value Init(napi_env env, napi_value exports) {
+  napi_property_descriptor properties[] = {
+      DECLARE_NODE_API_PROPERTY("DistanceEach", DistanceEach),
+      DECLARE_NODE_API_PROPERTY("DistanceBulk", DistanceBulk),
+      DECLARE_NODE_API_PROPERTY("BoundsEach", BoundsEach),
+      DECLARE_NODE_API_PROPERTY("BoundsBulk", BoundsBulk),
+  };
+
+  NODE_API_CALL(env,
+      napi_define_properties(
+          env, exports, sizeof(properties) / sizeof(properties[0]),
+          properties));
+
+  return exports;
+}
+NAPI_MODULE(NODE_GYP_MODULE_NAME, Init)
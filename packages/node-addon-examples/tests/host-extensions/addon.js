@@ -0,0 +1,58 @@
+// Calls native functions many times, doing the same work with a Node-API call
+// per value and with weak-node-api's host extensions, and logs how long each
+// took.
+const assert = require("assert");
+// cmake-rn emits to {targetSourceDir}/build/{configuration}, and this package's
+// build script pins the configuration.
+const addon = require("./build/RelWithDebInfo/addon.node");
+
+const ITERATIONS = 100_000;
+
+function measure(name, call, check) {
+  const start = performance.now();
+  let result;
+  for (let i = 0; i < ITERATIONS; i++) {
+    result = call(i);
+  }
+  const elapsed = performance.now() - start;
+  check(result);
+  console.log(`${name}: ${ITERATIONS} calls in ${elapsed.toFixed(1)} ms`);
+}
+
+function checkDistance(distance) {
+  const size = ITERATIONS - 1;
+  assert.strictEqual(distance, Math.sqrt(3 * size * size));
+}
+
+function checkBounds(bounds) {
+  const size = ITERATIONS - 1;
+  assert.deepStrictEqual(bounds, {
+    left: -size,
+    top: -size,
+    right: size,
+    bottom: size,
+  });
+}
+
+module.exports = () => {
+  measure(
+    "napi_get_value_double per argument",
+    (i) => addon.DistanceEach(0, 0, 0, i, i, i),
+    checkDistance,
+  );
+  measure(
+    "node_api_ext_get_cb_doubles",
+    (i) => addon.DistanceBulk(0, 0, 0, i, i, i),
+    checkDistance,
+  );
+  measure(
+    "napi_set_named_property per field",
+    (i) => addon.BoundsEach(i),
+    checkBounds,
+  );
+  measure(
+    "node_api_ext_set_named_doubles",
+    (i) => addon.BoundsBulk(i),
+    checkBounds,
+  );
+};
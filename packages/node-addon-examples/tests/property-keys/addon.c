@@ -0,0 +1,77 @@
+// Reads the same property repeatedly, by C-string name and by a key created
+// from the name on every read, so addon.js can compare the two: the host
+// interns the names passed to napi_get_named_property once per env.
+#include <node_api.h>
+#include <stdint.h>
+#include "../RuntimeNodeApiTestsCommon.h"
+
+// ReadNamed(object, iterations): sums object.value, read by name.
+static napi_value ReadNamed(napi_env env, napi_callback_info info) {
+  size_t argc = 2;
+  napi_value argv[2];
+  NODE_API_CALL(env, napi_get_cb_info(env, info, &argc, argv, NULL, NULL));
+  NODE_API_ASSERT(env, argc == 2, "Expected object and iterations");
+  uint32_t iterations;
+  NODE_API_CALL(env, napi_get_value_uint32(env, argv[1], &iterations));
+
+  double sum = 0;
+  for (uint32_t i = 0; i < iterations; i++) {
+    napi_handle_scope scope;
+    NODE_API_CALL(env, napi_open_handle_scope(env, &scope));
+    napi_value value;
+    double number;
+    NODE_API_CALL(env, napi_get_named_property(env, argv[0], "value", &value));
+    NODE_API_CALL(env, napi_get_value_double(env, value, &number));
+    sum += number;
+    NODE_API_CALL(env, napi_close_handle_scope(env, scope));
+  }
+
+  napi_value result;
+  NODE_API_CALL(env, napi_create_double(env, sum, &result));
+  return result;
+}
+
+// ReadWithStringKey(object, iterations): sums object.value, read through a
+// string key created for every read, which is what napi_get_named_property
+// costs without interning.
+static napi_value ReadWithStringKey(napi_env env, napi_callback_info info) {
+  size_t argc = 2;
+  napi_value argv[2];
+  NODE_API_CALL(env, napi_get_cb_info(env, info, &argc, argv, NULL, NULL));
+  NODE_API_ASSERT(env, argc == 2, "Expected object and iterations");
+  uint32_t iterations;
+  NODE_API_CALL(env, napi_get_value_uint32(env, argv[1], &iterations));
+
+  double sum = 0;
+  for (uint32_t i = 0; i < iterations; i++) {
+    napi_handle_scope scope;
+    NODE_API_CALL(env, napi_open_handle_scope(env, &scope));
+    napi_value key, value;
+    double number;
+    NODE_API_CALL(env,
+        napi_create_string_utf8(env, "value", NAPI_AUTO_LENGTH, &key));
+    NODE_API_CALL(env, napi_get_property(env, argv[0], key, &value));
+    NODE_API_CALL(env, napi_get_value_double(env, value, &number));
+    sum += number;
+    NODE_API_CALL(env, napi_close_handle_scope(env, scope));
+  }
+
+  napi_value result;
+  NODE_API_CALL(env, napi_create_double(env, sum, &result));
+  return result;
+}
+
+static napi_value Init(napi_env env, napi_value exports) {
+  napi_property_descriptor properties[] = {
+      DECLARE_NODE_API_PROPERTY("ReadNamed", ReadNamed),
+      DECLARE_NODE_API_PROPERTY("ReadWithStringKey", ReadWithStringKey),
+  };
+
+  NODE_API_CALL(env,
+      napi_define_properties(
+          env, exports, sizeof(properties) / sizeof(properties[0]),
+          properties));
+
+  return exports;
+}
+NAPI_MODULE(NODE_GYP_MODULE_NAME, Init)
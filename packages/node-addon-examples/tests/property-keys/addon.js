@@ -0,0 +1,22 @@
+// Reads a property from native code many times, by name (interned by the
+// host) and through a freshly created string key, and logs how long each took.
+const assert = require("assert");
+// cmake-rn emits to {targetSourceDir}/build/{configuration}, and this package's
+// build script pins the configuration.
+const addon = require("./build/RelWithDebInfo/addon.node");
+
+const ITERATIONS = 100_000;
+
+function measure(name, read) {
+  const object = { value: 2 };
+  const start = performance.now();
+  const sum = read(object, ITERATIONS);
+  const elapsed = performance.now() - start;
+  assert.strictEqual(sum, 2 * ITERATIONS);
+  console.log(`${name}: ${ITERATIONS} reads in ${elapsed.toFixed(1)} ms`);
+}
+
+module.exports = () => {
+  measure("napi_get_named_property", addon.ReadNamed);
+  measure("string key per read", addon.ReadWithStringKey);
+};
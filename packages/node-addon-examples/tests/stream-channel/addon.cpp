@@ -0,0 +1,114 @@
+// Streams the same sequence of integers from a producer thread into JS twice:
+// once with a napi_call_threadsafe_function per item, and once through a
+// weak_node_api::StreamChannel, so addon.js can compare the two.
+#include <node_api.h>
+#include <weak_node_api_stream_channel.hpp>
+
+#include <cstdint>
+#include <thread>
+
+#include "../RuntimeNodeApiTestsCommon.h"
+
+// Small enough to have the producer outrun JS and exercise the full-ring
+// path, which real producers (sensors, meters) hit under load too.
+#define CHANNEL_CAPACITY 1024
+
+static uint32_t GetCount(napi_env env, napi_value value) {
+  uint32_t count = 0;
+  NODE_API_CALL_BASE(env, napi_get_value_uint32(env, value, &count), 0);
+  return count;
+}
+
+static void CallWithValue(napi_env env, napi_value callback, void*,
+                          void* data) {
+  if (env == nullptr) {
+    return;
+  }
+  napi_value undefined, value;
+  NODE_API_CALL_RETURN_VOID(env, napi_get_undefined(env, &undefined));
+  NODE_API_CALL_RETURN_VOID(
+      env, napi_create_uint32(
+               env, static_cast<uint32_t>(reinterpret_cast<uintptr_t>(data)),
+               &value));
+  NODE_API_CALL_RETURN_VOID(
+      env, napi_call_function(env, undefined, callback, 1, &value, nullptr));
+}
+
+// RunThreadsafeFunction(count, onValue): calls onValue(i) for i in
+// [0, count), one thread-safe function call per value.
+static napi_value RunThreadsafeFunction(napi_env env, napi_callback_info info) {
+  size_t argc = 2;
+  napi_value argv[2];
+  NODE_API_CALL(env,
+                napi_get_cb_info(env, info, &argc, argv, nullptr, nullptr));
+  NODE_API_ASSERT(env, argc == 2, "Expected count and onValue");
+  const uint32_t count = GetCount(env, argv[0]);
+
+  napi_value name;
+  napi_threadsafe_function tsfn;
+  NODE_API_CALL(env, napi_create_string_utf8(env, "RunThreadsafeFunction",
+                                             NAPI_AUTO_LENGTH, &name));
+  NODE_API_CALL(env, napi_create_threadsafe_function(
+                         env, argv[1], nullptr, name, 0, 1, nullptr, nullptr,
+                         nullptr, CallWithValue, &tsfn));
+
+  // The producer owns the only reference, so it can be left to finish alone.
+  std::thread([tsfn, count] {
+    for (uint32_t i = 0; i < count; i++) {
+      // The value rides in the data pointer, keeping allocation out of the
+      // comparison.
+      napi_call_threadsafe_function(
+          tsfn, reinterpret_cast<void*>(static_cast<uintptr_t>(i)),
+          napi_tsfn_blocking);
+    }
+    napi_release_threadsafe_function(tsfn, napi_tsfn_release);
+  }).detach();
+  return nullptr;
+}
+
+// RunStreamChannel(count, onDrain): writes i for i in [0, count) as uint32
+// records into a StreamChannel, returning the ArrayBuffer onDrain(start, n)
+// reads them from.
+static napi_value RunStreamChannel(napi_env env, napi_callback_info info) {
+  size_t argc = 2;
+  napi_value argv[2];
+  NODE_API_CALL(env,
+                napi_get_cb_info(env, info, &argc, argv, nullptr, nullptr));
+  NODE_API_ASSERT(env, argc == 2, "Expected count and onDrain");
+  const uint32_t count = GetCount(env, argv[0]);
+
+  weak_node_api::StreamChannel* channel;
+  napi_value buffer;
+  NODE_API_CALL(env, weak_node_api::StreamChannel::create(
+                         env, argv[1], sizeof(uint32_t), CHANNEL_CAPACITY,
+                         &channel, &buffer));
+
+  std::thread([channel, count] {
+    for (uint32_t i = 0; i < count;) {
+      if (channel->write(&i, sizeof(i))) {
+        i++;
+      } else {
+        // Full: JS has not drained yet.
+        std::this_thread::yield();
+      }
+    }
+    channel->close();
+  }).detach();
+  return buffer;
+}
+
+static napi_value Init(napi_env env, napi_value exports) {
+  napi_property_descriptor properties[] = {
+      DECLARE_NODE_API_PROPERTY("RunThreadsafeFunction",
+                                RunThreadsafeFunction),
+      DECLARE_NODE_API_PROPERTY("RunStreamChannel", RunStreamChannel),
+  };
+
+  NODE_API_CALL(env,
+      napi_define_properties(
+          env, exports, sizeof(properties) / sizeof(properties[0]),
+          properties));
+
+  return exports;
+}
+NAPI_MODULE(NODE_GYP_MODULE_NAME, Init)
@@ -0,0 +1,54 @@
+// Streams the same values from a native thread via one threadsafe function
+// call per value and via a StreamChannel, asserting both deliver every value
+// in order, and logs how long each took.
+const assert = require("assert");
+// cmake-rn emits to {targetSourceDir}/build/{configuration}, and this package's
+// build script pins the configuration.
+const addon = require("./build/RelWithDebInfo/addon.node");
+
+const COUNT = 100_000;
+
+function viaThreadsafeFunction() {
+  return new Promise((resolve) => {
+    let expected = 0;
+    addon.RunThreadsafeFunction(COUNT, (value) => {
+      assert.strictEqual(value, expected++);
+      if (expected === COUNT) {
+        resolve({ calls: COUNT });
+      }
+    });
+  });
+}
+
+function viaStreamChannel() {
+  return new Promise((resolve) => {
+    let expected = 0;
+    let calls = 0;
+    // Drains only ever run asynchronously, after `records` is assigned.
+    const records = new Uint32Array(
+      addon.RunStreamChannel(COUNT, (start, count) => {
+        calls++;
+        for (let i = 0; i < count; i++) {
+          assert.strictEqual(records[(start + i) % records.length], expected++);
+        }
+        if (expected === COUNT) {
+          resolve({ calls });
+        }
+      }),
+    );
+  });
+}
+
+async function measure(name, run) {
+  const start = performance.now();
+  const { calls } = await run();
+  const elapsed = performance.now() - start;
+  console.log(
+    `${name}: ${COUNT} values in ${elapsed.toFixed(1)} ms over ${calls} JS calls`,
+  );
+}
+
+module.exports = () =>
+  measure("threadsafe function", viaThreadsafeFunction).then(() =>
+    measure("StreamChannel", viaStreamChannel),
+  );
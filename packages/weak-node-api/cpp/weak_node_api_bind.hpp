@@ -0,0 +1,278 @@
+/**
+ * @file weak_node_api_bind.hpp
+ * @brief Node-API callbacks generated at compile time from plain C++
+ * functions.
+ *
+ * A hand-written callback repeats the same steps for every function: call
+ * napi_get_cb_info into an argument array, convert and type check each
+ * argument, status check every call, and convert the result back. Given a
+ * function such as `double add(double a, double b)`, callback<&add> is that
+ * callback: its arity, the conversions and the checks all follow from the
+ * function's signature, so the compiler generates the same code a careful
+ * hand-written callback would, with the arguments on the stack.
+ *
+ * Header-only, built on Node-API alone, so an addon can use it against any
+ * Node-API host. Reports errors as JS exceptions rather than C++ ones, for
+ * addons built without exception support.
+ */
+#pragma once
+
+#include <node_api.h>
+
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace weak_node_api {
+
+/// Converts between JS values and values of type `T`. Specialize it for an
+/// addon's own types: fromValue() for parameters, with `kExpected` naming
+/// the JS type in the error thrown when it fails, and toValue() for results.
+template <typename T> struct Convert;
+
+template <> struct Convert<double> {
+  static constexpr const char *kExpected = "a number";
+  static napi_status fromValue(napi_env env, napi_value value,
+                               double *result) {
+    return napi_get_value_double(env, value, result);
+  }
+  static napi_status toValue(napi_env env, double value, napi_value *result) {
+    return napi_create_double(env, value, result);
+  }
+};
+
+template <> struct Convert<int32_t> {
+  static constexpr const char *kExpected = "a number";
+  static napi_status fromValue(napi_env env, napi_value value,
+                               int32_t *result) {
+    return napi_get_value_int32(env, value, result);
+  }
+  static napi_status toValue(napi_env env, int32_t value,
+                             napi_value *result) {
+    return napi_create_int32(env, value, result);
+  }
+};
+
+template <> struct Convert<uint32_t> {
+  static constexpr const char *kExpected = "a number";
+  static napi_status fromValue(napi_env env, napi_value value,
+                               uint32_t *result) {
+    return napi_get_value_uint32(env, value, result);
+  }
+  static napi_status toValue(napi_env env, uint32_t value,
+                             napi_value *result) {
+    return napi_create_uint32(env, value, result);
+  }
+};
+
+template <> struct Convert<int64_t> {
+  static constexpr const char *kExpected = "a number";
+  static napi_status fromValue(napi_env env, napi_value value,
+                               int64_t *result) {
+    return napi_get_value_int64(env, value, result);
+  }
+  static napi_status toValue(napi_env env, int64_t value,
+                             napi_value *result) {
+    return napi_create_int64(env, value, result);
+  }
+};
+
+template <> struct Convert<bool> {
+  static constexpr const char *kExpected = "a boolean";
+  static napi_status fromValue(napi_env env, napi_value value, bool *result) {
+    return napi_get_value_bool(env, value, result);
+  }
+  static napi_status toValue(napi_env env, bool value, napi_value *result) {
+    return napi_get_boolean(env, value, result);
+  }
+};
+
+template <> struct Convert<std::string> {
+  static constexpr const char *kExpected = "a string";
+  static napi_status fromValue(napi_env env, napi_value value,
+                               std::string *result) {
+    size_t length = 0;
+    napi_status status =
+        napi_get_value_string_utf8(env, value, nullptr, 0, &length);
+    if (status != napi_ok) {
+      return status;
+    }
+    // Room for the terminator napi_get_value_string_utf8 writes
+    result->resize(length + 1);
+    status = napi_get_value_string_utf8(env, value, result->data(),
+                                        length + 1, &length);
+    result->resize(length);
+    return status;
+  }
+  static napi_status toValue(napi_env env, const std::string &value,
+                             napi_value *result) {
+    return napi_create_string_utf8(env, value.data(), value.size(), result);
+  }
+};
+
+/// Passes JS values through unconverted.
+template <> struct Convert<napi_value> {
+  static constexpr const char *kExpected = "a value";
+  static napi_status fromValue(napi_env, napi_value value,
+                               napi_value *result) {
+    *result = value;
+    return napi_ok;
+  }
+  static napi_status toValue(napi_env, napi_value value, napi_value *result) {
+    *result = value;
+    return napi_ok;
+  }
+};
+
+template <typename T>
+concept FromValue = requires(napi_env env, napi_value value, T *result) {
+  { Convert<T>::fromValue(env, value, result) } -> std::same_as<napi_status>;
+  { Convert<T>::kExpected } -> std::convertible_to<const char *>;
+};
+
+template <typename T>
+concept ToValue = requires(napi_env env, const T &value, napi_value *result) {
+  { Convert<T>::toValue(env, value, result) } -> std::same_as<napi_status>;
+};
+
+namespace detail {
+
+template <typename F> struct Signature;
+
+template <typename R, typename... Params> struct Signature<R (*)(Params...)> {
+  using Return = R;
+  using Parameters = std::tuple<std::remove_cvref_t<Params>...>;
+};
+
+template <typename R, typename... Params>
+struct Signature<R (*)(Params...) noexcept> : Signature<R (*)(Params...)> {};
+
+// A leading napi_env parameter receives the env instead of an argument.
+template <typename Parameters> struct Arguments {
+  using Values = Parameters;
+  static constexpr bool kTakesEnv = false;
+};
+
+template <typename... Rest> struct Arguments<std::tuple<napi_env, Rest...>> {
+  using Values = std::tuple<Rest...>;
+  static constexpr bool kTakesEnv = true;
+};
+
+// Throws the error of the last failed call, unless it left an exception
+// pending already.
+inline void throwLastError(napi_env env) {
+  bool pending = false;
+  if (napi_is_exception_pending(env, &pending) != napi_ok || pending) {
+    return;
+  }
+  const napi_extended_error_info *info = nullptr;
+  napi_get_last_error_info(env, &info);
+  napi_throw_error(env, nullptr,
+                   info != nullptr && info->error_message != nullptr
+                       ? info->error_message
+                       : "Node-API call failed");
+}
+
+template <size_t Index, typename T>
+bool unpack(napi_env env, napi_value value, T *result) {
+  if (Convert<T>::fromValue(env, value, result) == napi_ok) [[likely]] {
+    return true;
+  }
+  bool pending = false;
+  if (napi_is_exception_pending(env, &pending) == napi_ok && !pending) {
+    char message[64];
+    std::snprintf(message, sizeof(message), "Argument %zu must be %s",
+                  Index + 1, Convert<T>::kExpected);
+    napi_throw_type_error(env, nullptr, message);
+  }
+  return false;
+}
+
+template <typename Values, size_t... Indices>
+bool unpackAll([[maybe_unused]] napi_env env,
+               [[maybe_unused]] const napi_value *argv,
+               [[maybe_unused]] Values &values,
+               std::index_sequence<Indices...>) {
+  // Stops at the first argument failing to convert
+  return (unpack<Indices>(env, argv[Indices], &std::get<Indices>(values)) &&
+          ...);
+}
+
+} // namespace detail
+
+/// The Node-API callback calling `Fn` with its JS arguments converted to
+/// its parameter types, and converting its result back (undefined for
+/// `void`). `Fn` may take the env as a leading `napi_env` parameter, e.g. to
+/// throw or create values itself.
+///
+/// Missing arguments are passed to Convert as undefined, and extra ones are
+/// ignored. An argument failing to convert throws a TypeError naming it, and
+/// `Fn` is not called.
+template <auto Fn>
+napi_value callback(napi_env env, napi_callback_info info) {
+  using Signature = detail::Signature<decltype(Fn)>;
+  using Arguments = detail::Arguments<typename Signature::Parameters>;
+  using Values = typename Arguments::Values;
+  using Return = typename Signature::Return;
+  constexpr size_t kArity = std::tuple_size_v<Values>;
+  static_assert(
+      []<size_t... Indices>(std::index_sequence<Indices...>) {
+        return (FromValue<std::tuple_element_t<Indices, Values>> && ...);
+      }(std::make_index_sequence<kArity>{}),
+      "Every parameter needs a Convert specialization with fromValue()");
+  static_assert(std::is_void_v<Return> ||
+                    ToValue<std::remove_cvref_t<Return>>,
+                "The result needs a Convert specialization with toValue()");
+
+  // One more than needed keeps the array non-empty
+  std::array<napi_value, kArity + 1> argv;
+  size_t argc = kArity;
+  if (napi_get_cb_info(env, info, &argc, argv.data(), nullptr, nullptr) !=
+      napi_ok) [[unlikely]] {
+    detail::throwLastError(env);
+    return nullptr;
+  }
+  Values values;
+  if (!detail::unpackAll(env, argv.data(), values,
+                         std::make_index_sequence<kArity>{})) {
+    return nullptr;
+  }
+  auto call = [&]() -> decltype(auto) {
+    if constexpr (Arguments::kTakesEnv) {
+      return std::apply(
+          [env](auto &&...args) -> decltype(auto) {
+            return Fn(env, std::move(args)...);
+          },
+          std::move(values));
+    } else {
+      return std::apply(Fn, std::move(values));
+    }
+  };
+  if constexpr (std::is_void_v<Return>) {
+    call();
+    return nullptr;
+  } else {
+    napi_value result = nullptr;
+    if (Convert<std::remove_cvref_t<Return>>::toValue(env, call(), &result) !=
+        napi_ok) [[unlikely]] {
+      detail::throwLastError(env);
+      return nullptr;
+    }
+    return result;
+  }
+}
+
+/// A property descriptor defining `Fn` as a method named `name`, for
+/// napi_define_properties.
+template <auto Fn> constexpr napi_property_descriptor method(const char *name) {
+  return {name,    nullptr, &callback<Fn>, nullptr, nullptr, nullptr,
+          napi_default, nullptr};
+}
+
+} // namespace weak_node_api
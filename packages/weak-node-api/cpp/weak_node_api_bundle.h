@@ -0,0 +1,41 @@
+/**
+ * @file weak_node_api_bundle.h
+ * @brief The table through which a bundle library, linking several Node-API
+ * addons into one shared library, exposes each addon's init function.
+ *
+ * Loading each addon from its own library costs a dlopen, its symbol lookups
+ * and a relocation pass per addon at startup. A bundle pays these once: its
+ * addons are compiled with their registration symbols renamed apart (see
+ * add_node_api_bundle in node-api-bundle.cmake) and listed in a table the
+ * host resolves once the bundle is open.
+ */
+#pragma once
+
+#include <node_api.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** One addon linked into a bundle. */
+typedef struct node_api_bundle_entry {
+  /** The name the addon is required by, i.e. its library name. */
+  const char *name;
+  /** The addon's renamed napi_register_module_v1. */
+  napi_addon_register_func init;
+  /**
+   * The addon's renamed node_api_module_get_api_version_v1, or NULL if it
+   * does not define one.
+   */
+  node_api_addon_get_api_version_func get_api_version;
+} node_api_bundle_entry;
+
+/**
+ * The symbol a bundle exports its table under: an array of
+ * node_api_bundle_entry terminated by an entry with a NULL name.
+ */
+#define NODE_API_BUNDLE_SYMBOL "node_api_bundle_v1"
+
+#ifdef __cplusplus
+}
+#endif
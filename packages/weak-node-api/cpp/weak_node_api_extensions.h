@@ -0,0 +1,60 @@
+/**
+ * @file weak_node_api_extensions.h
+ * @brief Bulk operations for addons built on weak-node-api, each standing for
+ * several Node-API calls.
+ *
+ * Every Node-API call an addon makes goes through a trampoline into the host.
+ * Patterns such as reading a handful of numeric arguments or returning an
+ * object of numeric fields make one such call per value. These functions do
+ * the same work in a single call: a host implementing them (see
+ * NodeApiHostExtensions) runs the loop on its side of the boundary, and
+ * against an older host weak-node-api falls back to the equivalent Node-API
+ * calls, so addons may call them unconditionally.
+ *
+ * They are not part of Node-API: an addon calling them only loads in a host
+ * injecting weak-node-api.
+ */
+#pragma once
+
+#include <node_api.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Reads the arguments of a call as numbers, as napi_get_cb_info followed by
+ * napi_get_value_double on each argument would.
+ *
+ * On input, `*argc` is the capacity of `argv`; on output, it is the number of
+ * arguments the call was made with. `argv` receives the first of them, and
+ * NaN for any it has no argument for. `this_arg` may be NULL.
+ *
+ * Returns napi_number_expected if one of the arguments read is not a number,
+ * in which case `argv` is left partially written.
+ */
+NAPI_EXTERN napi_status NAPI_CDECL
+node_api_ext_get_cb_doubles(napi_env env, napi_callback_info info,
+                            size_t *argc, double *argv, napi_value *this_arg);
+
+/**
+ * Sets `count` properties of `object` to numbers, as napi_create_double
+ * followed by napi_set_named_property for each would: `names[i]` (a
+ * null-terminated UTF-8 string) to `values[i]`.
+ *
+ * Stops at the first failure, returning its status.
+ */
+NAPI_EXTERN napi_status NAPI_CDECL node_api_ext_set_named_doubles(
+    napi_env env, napi_value object, size_t count, const char *const *names,
+    const double *values);
+
+/**
+ * Creates a Float64Array holding a copy of the `length` numbers at `data`,
+ * which may be NULL if `length` is 0.
+ */
+NAPI_EXTERN napi_status NAPI_CDECL node_api_ext_create_float64_array(
+    napi_env env, const double *data, size_t length, napi_value *result);
+
+#ifdef __cplusplus
+}
+#endif
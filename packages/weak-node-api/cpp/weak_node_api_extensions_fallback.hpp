@@ -0,0 +1,172 @@
+/**
+ * @file weak_node_api_extensions_fallback.hpp
+ * @brief The functions of weak_node_api_extensions.h, in terms of Node-API.
+ *
+ * weak_node_api.cpp calls these for the extensions a host does not inject,
+ * e.g. one built against an older weak-node-api. They make the Node-API calls
+ * an addon would have made itself, through the trampolines.
+ *
+ * A host implements the extensions it injects with the same template, given
+ * its own NodeApiCalls: e.g. to call into its runtime directly, or to look
+ * property names up through a cache.
+ */
+#pragma once
+
+#include <node_api.h>
+
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <vector>
+
+namespace weak_node_api {
+
+/**
+ * @brief The Node-API calls the extensions are made of, as an addon makes them.
+ *
+ * A host's replacement derives from it, hiding the calls it makes otherwise.
+ */
+struct NodeApiCalls {
+  static napi_status get_cb_info(napi_env env, napi_callback_info info,
+                                 size_t *argc, napi_value *argv,
+                                 napi_value *this_arg, void **data) {
+    return ::napi_get_cb_info(env, info, argc, argv, this_arg, data);
+  }
+  static napi_status get_value_double(napi_env env, napi_value value,
+                                      double *result) {
+    return ::napi_get_value_double(env, value, result);
+  }
+  static napi_status create_double(napi_env env, double value,
+                                   napi_value *result) {
+    return ::napi_create_double(env, value, result);
+  }
+  static napi_status set_named_property(napi_env env, napi_value object,
+                                        const char *utf8name,
+                                        napi_value value) {
+    return ::napi_set_named_property(env, object, utf8name, value);
+  }
+  static napi_status create_arraybuffer(napi_env env, size_t byte_length,
+                                        void **data, napi_value *result) {
+    return ::napi_create_arraybuffer(env, byte_length, data, result);
+  }
+  static napi_status create_typedarray(napi_env env, napi_typedarray_type type,
+                                       size_t length, napi_value arraybuffer,
+                                       size_t byte_offset,
+                                       napi_value *result) {
+    return ::napi_create_typedarray(env, type, length, arraybuffer,
+                                    byte_offset, result);
+  }
+};
+
+/**
+ * @brief The extensions, making their Node-API calls through `Calls`.
+ */
+template <typename Calls = NodeApiCalls> struct ExtensionsOf {
+  static napi_status node_api_ext_get_cb_doubles(napi_env env,
+                                                 napi_callback_info info,
+                                                 size_t *argc, double *argv,
+                                                 napi_value *this_arg) {
+    if (argc == nullptr || (*argc > 0 && argv == nullptr)) {
+      return napi_invalid_arg;
+    }
+    const size_t capacity = *argc;
+    // Enough for the calls this is meant for, without allocating.
+    napi_value inline_values[8];
+    std::vector<napi_value> heap_values;
+    napi_value *values = inline_values;
+    if (capacity > std::size(inline_values)) {
+      heap_values.resize(capacity);
+      values = heap_values.data();
+    }
+    napi_status status =
+        Calls::get_cb_info(env, info, argc, values, this_arg, nullptr);
+    if (status != napi_ok) {
+      return status;
+    }
+    for (size_t i = 0; i < capacity; i++) {
+      if (i >= *argc) {
+        argv[i] = std::numeric_limits<double>::quiet_NaN();
+        continue;
+      }
+      status = Calls::get_value_double(env, values[i], &argv[i]);
+      if (status != napi_ok) {
+        return status;
+      }
+    }
+    return napi_ok;
+  }
+
+  static napi_status node_api_ext_set_named_doubles(napi_env env,
+                                                    napi_value object,
+                                                    size_t count,
+                                                    const char *const *names,
+                                                    const double *values) {
+    if (count > 0 && (names == nullptr || values == nullptr)) {
+      return napi_invalid_arg;
+    }
+    for (size_t i = 0; i < count; i++) {
+      napi_value value;
+      napi_status status = Calls::create_double(env, values[i], &value);
+      if (status != napi_ok) {
+        return status;
+      }
+      status = Calls::set_named_property(env, object, names[i], value);
+      if (status != napi_ok) {
+        return status;
+      }
+    }
+    return napi_ok;
+  }
+
+  static napi_status node_api_ext_create_float64_array(napi_env env,
+                                                       const double *data,
+                                                       size_t length,
+                                                       napi_value *result) {
+    if (length > 0 && data == nullptr) {
+      return napi_invalid_arg;
+    }
+    void *buffer_data = nullptr;
+    napi_value buffer;
+    napi_status status = Calls::create_arraybuffer(
+        env, length * sizeof(double), &buffer_data, &buffer);
+    if (status != napi_ok) {
+      return status;
+    }
+    if (length > 0) {
+      std::memcpy(buffer_data, data, length * sizeof(double));
+    }
+    return Calls::create_typedarray(env, napi_float64_array, length, buffer, 0,
+                                    result);
+  }
+};
+
+namespace fallback {
+
+inline napi_status node_api_ext_get_cb_doubles(napi_env env,
+                                               napi_callback_info info,
+                                               size_t *argc, double *argv,
+                                               napi_value *this_arg) {
+  return ExtensionsOf<>::node_api_ext_get_cb_doubles(env, info, argc, argv,
+                                                     this_arg);
+}
+
+inline napi_status node_api_ext_set_named_doubles(napi_env env,
+                                                  napi_value object,
+                                                  size_t count,
+                                                  const char *const *names,
+                                                  const double *values) {
+  return ExtensionsOf<>::node_api_ext_set_named_doubles(env, object, count,
+                                                        names, values);
+}
+
+inline napi_status node_api_ext_create_float64_array(napi_env env,
+                                                     const double *data,
+                                                     size_t length,
+                                                     napi_value *result) {
+  return ExtensionsOf<>::node_api_ext_create_float64_array(env, data, length,
+                                                           result);
+}
+
+} // namespace fallback
+
+} // namespace weak_node_api
@@ -0,0 +1,232 @@
+/**
+ * @file weak_node_api_stream_channel.hpp
+ * @brief A lock-free channel streaming fixed-size records from native
+ * producer threads into JavaScript.
+ *
+ * Calling napi_call_threadsafe_function once per item costs a queue push and
+ * a hop onto the JS thread per item, which dominates for high-rate producers
+ * (sensor fusion, audio meters, BLE packets). A StreamChannel instead has
+ * producers write records into a ring buffer that JS sees as an ArrayBuffer,
+ * and coalesces every record written between two drains into a single
+ * call of the JS `onDrain` callback.
+ *
+ * Header-only, built on Node-API alone, so an addon can use it against any
+ * Node-API host.
+ */
+#pragma once
+
+#include <node_api.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+
+namespace weak_node_api {
+
+/// A bounded multi-producer, single-consumer ring of fixed-size records,
+/// consumed on the JS thread.
+///
+/// Producers call write() from any thread, lock-free. The first record
+/// written after a drain schedules one call of `onDrain(start, count)` on the
+/// JS thread, which receives every record committed by then: record `i`
+/// (0 <= i < count) is at byte offset
+/// `((start + i) % capacity) * recordSize` of the ArrayBuffer returned by
+/// create(). Records are handed to JS in the order their writes reserved
+/// them, which for a single producer is the order they were written. Their
+/// slots are released for reuse once `onDrain` returns, so JS must read (or
+/// copy) them before returning.
+///
+/// Lifetime follows the thread-safe function it is built on: once every
+/// producer is done, close() releases it, after which the channel lives on
+/// only as long as JS keeps the ArrayBuffer alive.
+class StreamChannel {
+public:
+  /// Creates a channel of `capacity` records (rounded up to a power of two)
+  /// of `recordSize` bytes each, calling `onDrain` on the JS thread of `env`.
+  /// `arrayBuffer` receives the ring as seen by JS. The channel initially
+  /// has one producer reference, released by close().
+  static napi_status create(napi_env env, napi_value onDrain,
+                            size_t recordSize, size_t capacity,
+                            StreamChannel **result, napi_value *arrayBuffer) {
+    if (env == nullptr || onDrain == nullptr || result == nullptr ||
+        arrayBuffer == nullptr || recordSize == 0 || capacity == 0) {
+      return napi_invalid_arg;
+    }
+    // Once the ArrayBuffer exists, its finalizer owns the channel.
+    auto *raw = new StreamChannel(recordSize, capacity);
+    napi_status status = napi_create_external_arraybuffer(
+        env, raw->storage_.get(), raw->capacity_ * raw->recordSize_,
+        &StreamChannel::finalizeArrayBuffer, raw, arrayBuffer);
+    if (status != napi_ok) {
+      delete raw;
+      return status;
+    }
+    // Producers may write until the thread-safe function is finalized, so
+    // the ring must stay alive at least that long, whatever JS does with it.
+    status = napi_create_reference(env, *arrayBuffer, 1, &raw->bufferRef_);
+    if (status != napi_ok) {
+      return status;
+    }
+    napi_value resourceName = nullptr;
+    status = napi_create_string_utf8(env, "StreamChannel", NAPI_AUTO_LENGTH,
+                                     &resourceName);
+    if (status == napi_ok) {
+      status = napi_create_threadsafe_function(
+          env, onDrain, nullptr, resourceName, 0, 1, raw,
+          &StreamChannel::finalizeThreadsafeFunction, raw,
+          &StreamChannel::drain, &raw->tsfn_);
+    }
+    if (status != napi_ok) {
+      // No producer will ever write: leave the ring to the garbage collector.
+      napi_delete_reference(env, raw->bufferRef_);
+      return status;
+    }
+    *result = raw;
+    return napi_ok;
+  }
+
+  size_t recordSize() const { return recordSize_; }
+  size_t capacity() const { return capacity_; }
+
+  /// Reserves the next record, lets `fill(void *record)` write up to
+  /// recordSize() bytes into it and commits it. Lock-free and callable from
+  /// any thread. Returns false, dropping the record, when the ring is full
+  /// (JS has not drained it quickly enough) or the channel was closed.
+  template <typename Fill> bool write(Fill &&fill) {
+    if (closed_.load(std::memory_order_relaxed)) {
+      return false;
+    }
+    size_t position = writePosition_.load(std::memory_order_relaxed);
+    for (;;) {
+      const size_t sequence =
+          sequences_[position & mask_].load(std::memory_order_acquire);
+      const auto difference = static_cast<intptr_t>(sequence) -
+                              static_cast<intptr_t>(position);
+      if (difference == 0) {
+        if (writePosition_.compare_exchange_weak(position, position + 1,
+                                                 std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (difference < 0) {
+        // The slot still holds a record from the previous lap.
+        return false;
+      } else {
+        position = writePosition_.load(std::memory_order_relaxed);
+      }
+    }
+    fill(static_cast<void *>(storage_.get() +
+                             (position & mask_) * recordSize_));
+    sequences_[position & mask_].store(position + 1, std::memory_order_release);
+    // Only the first record since the last drain pays for a JS-thread hop.
+    if (!drainPending_.exchange(true, std::memory_order_acq_rel)) {
+      napi_call_threadsafe_function(tsfn_, nullptr, napi_tsfn_nonblocking);
+    }
+    return true;
+  }
+
+  /// Copies `size` bytes (at most recordSize()) into the next record.
+  bool write(const void *data, size_t size) {
+    if (size > recordSize_) {
+      return false;
+    }
+    return write([data, size](void *record) { memcpy(record, data, size); });
+  }
+
+  /// Called once every producer is done: records written before still reach
+  /// JS, later writes fail. Callable from any thread.
+  napi_status close() {
+    if (closed_.exchange(true)) {
+      return napi_ok;
+    }
+    return napi_release_threadsafe_function(tsfn_, napi_tsfn_release);
+  }
+
+  StreamChannel(const StreamChannel &) = delete;
+  StreamChannel &operator=(const StreamChannel &) = delete;
+
+private:
+  static size_t roundUpToPowerOfTwo(size_t value) {
+    size_t result = 1;
+    while (result < value) {
+      result <<= 1;
+    }
+    return result;
+  }
+
+  StreamChannel(size_t recordSize, size_t capacity)
+      : recordSize_(recordSize), capacity_(roundUpToPowerOfTwo(capacity)),
+        mask_(capacity_ - 1),
+        storage_(new std::byte[capacity_ * recordSize_]()),
+        sequences_(new std::atomic<size_t>[capacity_]) {
+    for (size_t i = 0; i < capacity_; i++) {
+      sequences_[i].store(i, std::memory_order_relaxed);
+    }
+  }
+
+  // Runs on the JS thread, once per coalesced notification.
+  static void drain(napi_env env, napi_value onDrain, void *context, void *) {
+    auto *self = static_cast<StreamChannel *>(context);
+    // Cleared before scanning: a record committed after this point schedules
+    // another drain, and one committed before is visible to the scan, as its
+    // producer's exchange is ordered before this one.
+    self->drainPending_.exchange(false, std::memory_order_acq_rel);
+    const size_t start = self->readPosition_;
+    size_t count = 0;
+    while (count < self->capacity_ &&
+           self->sequences_[(start + count) & self->mask_].load(
+               std::memory_order_acquire) == start + count + 1) {
+      count++;
+    }
+    if (count == 0) {
+      return;
+    }
+    // A null env means the thread-safe function is being torn down: the
+    // records are released without reaching JS.
+    if (env != nullptr && onDrain != nullptr) {
+      napi_value argv[2] = {};
+      napi_value undefined = nullptr;
+      if (napi_create_double(env, static_cast<double>(start & self->mask_),
+                             &argv[0]) == napi_ok &&
+          napi_create_double(env, static_cast<double>(count), &argv[1]) ==
+              napi_ok &&
+          napi_get_undefined(env, &undefined) == napi_ok) {
+        napi_call_function(env, undefined, onDrain, 2, argv, nullptr);
+      }
+    }
+    for (size_t i = 0; i < count; i++) {
+      self->sequences_[(start + i) & self->mask_].store(
+          start + i + self->capacity_, std::memory_order_release);
+    }
+    self->readPosition_ = start + count;
+  }
+
+  static void finalizeThreadsafeFunction(napi_env env, void *data, void *) {
+    auto *self = static_cast<StreamChannel *>(data);
+    // No producer can write anymore: hand the ring's lifetime over to JS.
+    napi_delete_reference(env, self->bufferRef_);
+    self->bufferRef_ = nullptr;
+  }
+
+  static void finalizeArrayBuffer(napi_env, void *, void *hint) {
+    delete static_cast<StreamChannel *>(hint);
+  }
+
+  const size_t recordSize_;
+  const size_t capacity_;
+  const size_t mask_;
+  std::unique_ptr<std::byte[]> storage_;
+  // Per slot: equal to the position a producer may claim it at, then that
+  // position + 1 once committed, then position + capacity once drained.
+  std::unique_ptr<std::atomic<size_t>[]> sequences_;
+  alignas(64) std::atomic<size_t> writePosition_{0};
+  // Only touched on the JS thread.
+  alignas(64) size_t readPosition_ = 0;
+  std::atomic<bool> drainPending_{false};
+  std::atomic<bool> closed_{false};
+  napi_threadsafe_function tsfn_ = nullptr;
+  napi_ref bufferRef_ = nullptr;
+};
+
+} // namespace weak_node_api
@@ -0,0 +1,70 @@
+# add_node_api_bundle(<bundle> ADDONS <target>... [NAMES <name>...])
+#
+# Links the Node-API addons built by the given STATIC or OBJECT library
+# targets into a single shared library, <bundle>, so that loading them costs
+# one dlopen instead of one per addon (see cpp/weak_node_api_bundle.h).
+#
+# Each addon is compiled with its napi_register_module_v1 and
+# node_api_module_get_api_version_v1 renamed apart, which works for addons
+# registering through NAPI_MODULE, NAPI_MODULE_INIT or node-addon-api's
+# NODE_API_MODULE, but not through the deprecated napi_module_register. The
+# bundle lists the addons under the names they are required by: NAMES, in
+# the order of ADDONS, or else the target names.
+function(add_node_api_bundle BUNDLE)
+  cmake_parse_arguments(PARSE_ARGV 1 ARG "" "" "ADDONS;NAMES")
+  if(NOT ARG_ADDONS)
+    message(FATAL_ERROR "add_node_api_bundle(${BUNDLE}) needs ADDONS")
+  endif()
+  if(ARG_NAMES)
+    list(LENGTH ARG_ADDONS ADDON_COUNT)
+    list(LENGTH ARG_NAMES NAME_COUNT)
+    if(NOT ADDON_COUNT EQUAL NAME_COUNT)
+      message(FATAL_ERROR "add_node_api_bundle(${BUNDLE}) needs one name per addon")
+    endif()
+  else()
+    set(ARG_NAMES ${ARG_ADDONS})
+  endif()
+
+  set(DECLARATIONS "")
+  set(ENTRIES "")
+  foreach(ADDON NAME IN ZIP_LISTS ARG_ADDONS ARG_NAMES)
+    get_target_property(ADDON_TYPE ${ADDON} TYPE)
+    if(NOT ADDON_TYPE MATCHES "^(STATIC_LIBRARY|OBJECT_LIBRARY)$")
+      message(FATAL_ERROR "Bundled addon ${ADDON} must be a STATIC or OBJECT library, not ${ADDON_TYPE}")
+    endif()
+    string(MAKE_C_IDENTIFIER "${ADDON}" ID)
+    set(INIT napi_register_module_v1_${ID})
+    set(GET_API_VERSION node_api_module_get_api_version_v1_${ID})
+    # The macros of node_api.h paste these names together, and the pasted
+    # token is still subject to macro replacement.
+    target_compile_definitions(${ADDON} PRIVATE
+      napi_register_module_v1=${INIT}
+      node_api_module_get_api_version_v1=${GET_API_VERSION}
+    )
+    set_target_properties(${ADDON} PROPERTIES POSITION_INDEPENDENT_CODE ON)
+    string(APPEND DECLARATIONS
+      "napi_value ${INIT}(napi_env env, napi_value exports);\n"
+      "__attribute__((weak)) int32_t ${GET_API_VERSION}(void);\n"
+    )
+    string(APPEND ENTRIES "    {\"${NAME}\", ${INIT}, ${GET_API_VERSION}},\n")
+  endforeach()
+
+  set(TABLE_SOURCE "${CMAKE_CURRENT_BINARY_DIR}/${BUNDLE}_node_api_bundle.cpp")
+  file(CONFIGURE OUTPUT "${TABLE_SOURCE}" @ONLY CONTENT [[
+// Generated by add_node_api_bundle: the addons linked into @BUNDLE@.
+#include <weak_node_api_bundle.h>
+
+extern "C" {
+
+@DECLARATIONS@
+__attribute__((visibility("default"))) extern const node_api_bundle_entry
+    node_api_bundle_v1[] = {
+@ENTRIES@    {nullptr, nullptr, nullptr},
+};
+
+}
+]])
+
+  add_library(${BUNDLE} SHARED "${TABLE_SOURCE}")
+  target_link_libraries(${BUNDLE} PRIVATE weak-node-api ${ARG_ADDONS})
+endfunction()
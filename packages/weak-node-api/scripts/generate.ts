@@ -7,9 +7,12 @@ import {
   FunctionDecl,
   getNodeApiFunctions,
 } from "../src/node-api-functions.js";
+import { HOST_TABLE_FILE_NAME } from "../src/imports.js";
+import { getHostExtensionFunctions } from "../src/host-extensions.js";
 
 import * as weakNodeApiGenerator from "./generators/weak-node-api.js";
 import * as hostGenerator from "./generators/NodeApiHost.js";
+import * as hostExtensionsGenerator from "./generators/NodeApiHostExtensions.js";
 
 export const OUTPUT_PATH = path.join(import.meta.dirname, "../generated");
 
@@ -57,6 +60,7 @@ async function run() {
   await fs.promises.mkdir(OUTPUT_PATH, { recursive: true });
 
   const functions = getNodeApiFunctions();
+  const extensions = getHostExtensionFunctions();
   await generateFile({
     functions,
     fileName: "NodeApiHost.hpp",
@@ -67,6 +71,16 @@ async function run() {
       This header provides a struct of Node-API functions implemented by a host to inject its implementations.
     `,
   });
+  await generateFile({
+    functions: extensions,
+    fileName: "NodeApiHostExtensions.hpp",
+    generator: hostExtensionsGenerator.generateHeader,
+    headingComment: `
+      @brief NodeApiHostExtensions struct.
+     
+      This header provides a versioned struct of bulk operations (see weak_node_api_extensions.h) a host may implement and inject next to its NodeApiHost.
+    `,
+  });
   await generateFile({
     functions,
     fileName: "weak_node_api.hpp",
@@ -80,13 +94,25 @@ async function run() {
   await generateFile({
     functions,
     fileName: "weak_node_api.cpp",
-    generator: weakNodeApiGenerator.generateSource,
+    generator: (functions) =>
+      weakNodeApiGenerator.generateSource(functions, extensions),
     headingComment: `
       @brief Weak Node-API host injection implementation.
      
       Provides the implementation for deferring Node-API function calls from addons into a Node-API host.
     `,
   });
+  // The table layout, for reporting on the functions addons import without
+  // parsing the headers again (see src/imports.ts)
+  await fs.promises.writeFile(
+    path.join(OUTPUT_PATH, HOST_TABLE_FILE_NAME),
+    JSON.stringify(
+      functions.map(({ name, version }) => ({ name, version })),
+      null,
+      2,
+    ),
+    "utf-8",
+  );
 }
 
 run().catch((err) => {
@@ -1,4 +1,5 @@
 import type { FunctionDecl } from "../../src/node-api-functions.js";
+import { generateVersionSlices } from "./shared.js";
 
 export function generateFunctionDecl({
   returnType,
@@ -24,9 +25,17 @@ export function generateHeader(functions: FunctionDecl[]) {
     #define WEAK_NODE_API_UNREACHABLE __assume(0)
     #endif
     
+    // The Node-API version the table is sliced at. A weak-node-api built
+    // with an older version (to serve addons importing nothing newer) only
+    // holds and forwards the functions up to it, and, the table being ordered
+    // by version, still reads its slots from a newer host's table.
+    #ifndef WEAK_NODE_API_VERSION
+    #define WEAK_NODE_API_VERSION ${Math.max(...functions.map(({ version }) => version))}
+    #endif
+
     // Generate the struct of function pointers
     struct NodeApiHost {
-      ${functions.map(generateFunctionDecl).join("\n")}
+      ${generateVersionSlices(functions, generateFunctionDecl)}
     };
   `;
 }
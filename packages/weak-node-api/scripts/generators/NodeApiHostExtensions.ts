@@ -0,0 +1,47 @@
+import type { FunctionDecl } from "../../src/node-api-functions.js";
+import { generateFunctionDecl } from "./NodeApiHost.js";
+
+/**
+ * Generates code per extension, grouped by the extensions table version
+ * introducing them (which must be ordered by it).
+ */
+export function generateExtensionVersions(
+  functions: FunctionDecl[],
+  generate: (version: number, slice: FunctionDecl[]) => string,
+) {
+  const versions = [...new Set(functions.map(({ version }) => version))];
+  return versions
+    .map((version) =>
+      generate(
+        version,
+        functions.filter((fn) => fn.version === version),
+      ),
+    )
+    .join("\n");
+}
+
+export function generateHeader(functions: FunctionDecl[]) {
+  const version = Math.max(...functions.map(({ version }) => version));
+  return `
+    #pragma once
+
+    #include <node_api.h>
+
+    #include <stdint.h>
+
+    // The version of the table this header declares. A host sets it as the
+    // table's version, which tells weak-node-api how many of its fields the
+    // host's (possibly older or newer) table has.
+    #define NODE_API_HOST_EXTENSIONS_VERSION ${version}
+
+    // Generate the struct of function pointers
+    struct NodeApiHostExtensions {
+      uint32_t version;
+      ${generateExtensionVersions(
+        functions,
+        (version, slice) =>
+          `// Extensions v${version}\n${slice.map(generateFunctionDecl).join("\n")}`,
+      )}
+    };
+  `;
+}
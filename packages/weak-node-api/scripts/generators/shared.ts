@@ -26,3 +26,26 @@ export function generateFunction({
     ;
   `;
 }
+
+/**
+ * Generates code per function, grouped by the Node-API version introducing
+ * the functions (which must be ordered by it), with every group after the
+ * first compiled only if WEAK_NODE_API_VERSION includes its version.
+ */
+export function generateVersionSlices(
+  functions: FunctionDecl[],
+  generate: (fn: FunctionDecl) => string,
+) {
+  const versions = [...new Set(functions.map(({ version }) => version))];
+  return versions
+    .map((version, index) => {
+      const slice = functions
+        .filter((fn) => fn.version === version)
+        .map(generate)
+        .join("\n");
+      return index === 0
+        ? `// Node-API v${version}\n${slice}`
+        : `#if WEAK_NODE_API_VERSION >= ${version}\n// Node-API v${version}\n${slice}\n#endif`;
+    })
+    .join("\n");
+}
@@ -1,5 +1,6 @@
 import type { FunctionDecl } from "../../src/node-api-functions.js";
-import { generateFunction } from "./shared.js";
+import { generateFunction, generateVersionSlices } from "./shared.js";
+import { generateExtensionVersions } from "./NodeApiHostExtensions.js";
 
 export function generateHeader() {
   return `
@@ -10,9 +11,53 @@ export function generateHeader() {
     #include <stdlib.h> // abort()
     
     #include "NodeApiHost.hpp"
+    #include "NodeApiHostExtensions.hpp"
     
     typedef void(*InjectHostFunction)(const NodeApiHost&);
     extern "C" void inject_weak_node_api_host(const NodeApiHost& host);
+
+    // Optional, and injected after the host: a host looks it up with dlsym(),
+    // as an older weak-node-api does not define it.
+    typedef void(*InjectHostExtensionsFunction)(const NodeApiHostExtensions&);
+    extern "C" void inject_weak_node_api_host_extensions(
+      const NodeApiHostExtensions& extensions);
+
+    // The weak-node-api library, as passed to dlopen()
+    #if !defined(WEAK_NODE_API_LIBRARY_NAME)
+    #if defined(__APPLE__)
+    #define WEAK_NODE_API_LIBRARY_NAME "@rpath/weak-node-api.framework/weak-node-api"
+    #else
+    #define WEAK_NODE_API_LIBRARY_NAME "libweak-node-api.so"
+    #endif
+    #endif
+
+    // What the host injected into the weak-node-api library, for addons
+    // linking weak-node-api statically to copy.
+    typedef const NodeApiHost*(*InjectedHostFunction)();
+    typedef const NodeApiHostExtensions*(*InjectedHostExtensionsFunction)();
+    #define WEAK_NODE_API_INJECTED_HOST_SYMBOL "weak_node_api_injected_host"
+    #define WEAK_NODE_API_INJECTED_HOST_EXTENSIONS_SYMBOL "weak_node_api_injected_host_extensions"
+    extern "C" const NodeApiHost* weak_node_api_injected_host();
+    extern "C" const NodeApiHostExtensions* weak_node_api_injected_host_extensions();
+
+    // Linked statically (the weak-node-api-static target), every addon holds
+    // its own copy of the host (and of its extensions). The first Node-API
+    // call finding it empty copies what the host injected into the
+    // weak-node-api library, which a host loads and injects before any
+    // addon, so an addon may call Node-API from its static initializers
+    // (e.g. napi_module_register). A host without that library injects
+    // through these symbols instead, exported by the addon's library and
+    // looked up with dlsym().
+    #define WEAK_NODE_API_STATIC_INJECT_SYMBOL "inject_weak_node_api_host_static"
+    #define WEAK_NODE_API_STATIC_INJECT_EXTENSIONS_SYMBOL "inject_weak_node_api_host_extensions_static"
+
+    #if defined(WEAK_NODE_API_STATIC)
+    extern "C" __attribute__((visibility("default")))
+    void inject_weak_node_api_host_static(const NodeApiHost& host);
+    extern "C" __attribute__((visibility("default")))
+    void inject_weak_node_api_host_extensions_static(
+      const NodeApiHostExtensions& extensions);
+    #endif
   `;
 }
 
@@ -22,9 +67,12 @@ function generateFunctionImpl(fn: FunctionDecl) {
     ...fn,
     extern: true,
     body: `
-        if (g_host.${name} == nullptr) {
-          fprintf(stderr, "Node-API function '${name}' called before it was injected!\\n");
-          abort();
+        if (g_host.${name} == nullptr) [[unlikely]] {
+          copy_injected_host();
+          if (g_host.${name} == nullptr) {
+            fprintf(stderr, "Node-API function '${name}' called before it was injected!\\n");
+            abort();
+          }
         }
         ${returnType === "void" ? "" : "return "} g_host.${name}(
           ${argumentTypes.map((_, index) => `arg${index}`).join(", ")}
@@ -33,9 +81,51 @@ function generateFunctionImpl(fn: FunctionDecl) {
   });
 }
 
-export function generateSource(functions: FunctionDecl[]) {
+function generateExtensionImpl(fn: FunctionDecl) {
+  const { name, argumentTypes } = fn;
+  const args = argumentTypes.map((_, index) => `arg${index}`).join(", ");
+  return generateFunction({
+    ...fn,
+    extern: true,
+    body: `
+        if (g_host_extensions.${name} == nullptr) {
+          // Not injected by the host: make the Node-API calls it stands for
+          return weak_node_api::fallback::${name}(${args});
+        }
+        return g_host_extensions.${name}(${args});
+      `,
+  });
+}
+
+/**
+ * Copies the extensions of each version the host's table has, leaving the
+ * newer ones null: the host's table, built against an older header, ends
+ * before their fields.
+ */
+function generateExtensionsCopy(extensions: FunctionDecl[]) {
+  return generateExtensionVersions(
+    extensions,
+    (version, slice) => `
+      if (extensions.version >= ${version}) {
+        ${slice.map(({ name }) => `g_host_extensions.${name} = extensions.${name};`).join("\n")}
+      }
+    `,
+  );
+}
+
+export function generateSource(
+  functions: FunctionDecl[],
+  extensions: FunctionDecl[],
+) {
   return `
     #include "weak_node_api.hpp"
+    #include "weak_node_api_extensions.h"
+    #include "weak_node_api_extensions_fallback.hpp"
+
+    #if defined(WEAK_NODE_API_STATIC)
+    #include <dlfcn.h>
+    #include <mutex>
+    #endif
 
     /**
      * @brief Global instance of the injected Node-API host.
@@ -48,8 +138,70 @@ export function generateSource(functions: FunctionDecl[]) {
     void inject_weak_node_api_host(const NodeApiHost& host) {
       g_host = host;
     };
+
+    /**
+     * @brief The bulk operations the host injected, if any.
+     *
+     * Null fields are served by the fallbacks of weak_node_api_extensions_fallback.hpp.
+     */
+    NodeApiHostExtensions g_host_extensions;
+    void inject_weak_node_api_host_extensions(const NodeApiHostExtensions& extensions) {
+      g_host_extensions = {};
+      g_host_extensions.version = extensions.version;
+      ${generateExtensionsCopy(extensions)}
+    }
+
+    #if defined(WEAK_NODE_API_STATIC)
+    void inject_weak_node_api_host_static(const NodeApiHost& host) {
+      g_host = host;
+    }
+    void inject_weak_node_api_host_extensions_static(const NodeApiHostExtensions& extensions) {
+      inject_weak_node_api_host_extensions(extensions);
+    }
+
+    /**
+     * @brief Copies the host injected into the weak-node-api library, if it is loaded.
+     *
+     * Called by the first Node-API call finding g_host empty, which may be made by
+     * the addon's static initializers, before its host could inject into it.
+     */
+    static void copy_injected_host() {
+      static std::once_flag copied;
+      std::call_once(copied, [] {
+        void* library = dlopen(WEAK_NODE_API_LIBRARY_NAME, RTLD_NOW | RTLD_NOLOAD);
+        if (library == nullptr) {
+          return;
+        }
+        auto host = reinterpret_cast<InjectedHostFunction>(
+          dlsym(library, WEAK_NODE_API_INJECTED_HOST_SYMBOL));
+        auto extensions = reinterpret_cast<InjectedHostExtensionsFunction>(
+          dlsym(library, WEAK_NODE_API_INJECTED_HOST_EXTENSIONS_SYMBOL));
+        if (host != nullptr) {
+          g_host = *host();
+        }
+        if (extensions != nullptr && g_host_extensions.version == 0) {
+          inject_weak_node_api_host_extensions(*extensions());
+        }
+        // Loaded by the host, the library outlives the addon
+        dlclose(library);
+      });
+    }
+    #else
+    const NodeApiHost* weak_node_api_injected_host() {
+      return &g_host;
+    }
+    const NodeApiHostExtensions* weak_node_api_injected_host_extensions() {
+      return &g_host_extensions;
+    }
+
+    // The library itself is what the host injects into
+    static void copy_injected_host() {}
+    #endif
     
     // Generate function calling into the host
-    ${functions.map(generateFunctionImpl).join("\n")}
+    ${generateVersionSlices(functions, generateFunctionImpl)}
+
+    // Generate the extensions, calling into the host or falling back
+    ${extensions.map(generateExtensionImpl).join("\n")}
   `;
 }
@@ -0,0 +1,53 @@
+import type { FunctionDecl } from "./node-api-functions.js";
+
+/**
+ * Bulk operations a host may implement on top of its Node-API, injected next
+ * to NodeApiHost as NodeApiHostExtensions (see cpp/weak_node_api_extensions.h
+ * for what each one does). Each saves an addon the trampoline hop of every
+ * Node-API call it stands for.
+ *
+ * Unlike Node-API functions, their `version` is the version of the
+ * extensions table introducing them: append new ones with the next version,
+ * never reorder or remove one, so that the table of an older host is a
+ * prefix of the table of a newer one.
+ */
+export function getHostExtensionFunctions(): FunctionDecl[] {
+  return [
+    {
+      name: "node_api_ext_get_cb_doubles",
+      version: 1,
+      returnType: "napi_status",
+      noReturn: false,
+      argumentTypes: [
+        "napi_env",
+        "napi_callback_info",
+        "size_t*",
+        "double*",
+        "napi_value*",
+      ],
+      fallbackReturnStatement: "return napi_status::napi_generic_failure;",
+    },
+    {
+      name: "node_api_ext_set_named_doubles",
+      version: 1,
+      returnType: "napi_status",
+      noReturn: false,
+      argumentTypes: [
+        "napi_env",
+        "napi_value",
+        "size_t",
+        "const char* const*",
+        "const double*",
+      ],
+      fallbackReturnStatement: "return napi_status::napi_generic_failure;",
+    },
+    {
+      name: "node_api_ext_create_float64_array",
+      version: 1,
+      returnType: "napi_status",
+      noReturn: false,
+      argumentTypes: ["napi_env", "const double*", "size_t", "napi_value*"],
+      fallbackReturnStatement: "return napi_status::napi_generic_failure;",
+    },
+  ];
+}
@@ -0,0 +1,122 @@
+import assert from "node:assert/strict";
+import fs from "node:fs";
+import os from "node:os";
+import path from "node:path";
+import { describe, it } from "node:test";
+
+import {
+  findLibraries,
+  formatExportsList,
+  getImportsReport,
+  getLibraryFormat,
+  parseUndefinedSymbols,
+} from "./imports.js";
+
+// In host table order, i.e. by version
+const FUNCTIONS = [
+  { name: "napi_create_object", version: 1 },
+  { name: "napi_get_undefined", version: 1 },
+  { name: "napi_add_env_cleanup_hook", version: 3 },
+  { name: "napi_create_bigint_int64", version: 6 },
+  { name: "node_api_symbol_for", version: 9 },
+];
+
+describe("parseUndefinedSymbols", () => {
+  it("parses GNU and LLVM nm output for ELF libraries", () => {
+    const output = [
+      "                 w __cxa_finalize",
+      "                 U napi_create_object",
+      "                 U napi_get_undefined@VERS_1",
+      "                 U strlen",
+    ].join("\n");
+    assert.deepEqual(parseUndefinedSymbols(output, "elf"), [
+      "napi_create_object",
+      "napi_get_undefined",
+      "strlen",
+    ]);
+  });
+
+  it("strips Mach-O underscores and universal binary headers", () => {
+    const output = [
+      "",
+      "addon (for architecture arm64):",
+      "_napi_create_object",
+      "dyld_stub_binder",
+      "",
+      "addon (for architecture x86_64):",
+      "_napi_create_object",
+    ].join("\n");
+    assert.deepEqual(parseUndefinedSymbols(output, "mach-o"), [
+      "napi_create_object",
+      "dyld_stub_binder",
+    ]);
+  });
+});
+
+describe("getImportsReport", () => {
+  it("lists the imported functions in table order, with their importers", () => {
+    const report = getImportsReport(
+      {
+        "a.so": ["napi_get_undefined", "napi_add_env_cleanup_hook", "strlen"],
+        "b.so": ["napi_create_object", "napi_get_undefined"],
+      },
+      FUNCTIONS,
+    );
+    assert.deepEqual(report.functions, [
+      { name: "napi_create_object", version: 1, importedBy: ["b.so"] },
+      { name: "napi_get_undefined", version: 1, importedBy: ["a.so", "b.so"] },
+      { name: "napi_add_env_cleanup_hook", version: 3, importedBy: ["a.so"] },
+    ]);
+    assert.deepEqual(report.libraries, ["a.so", "b.so"]);
+  });
+
+  it("slices the table at the newest version imported", () => {
+    const report = getImportsReport(
+      { "a.so": ["napi_add_env_cleanup_hook"] },
+      FUNCTIONS,
+    );
+    assert.equal(report.version, 3);
+    assert.equal(report.tableSize, 3);
+    assert.equal(report.fullTableSize, 5);
+  });
+
+  it("needs version 1 when nothing is imported", () => {
+    const report = getImportsReport({ "a.so": ["strlen"] }, FUNCTIONS);
+    assert.equal(report.version, 1);
+    assert.deepEqual(report.functions, []);
+  });
+});
+
+describe("formatExportsList", () => {
+  it("lists one function per line", () => {
+    const report = getImportsReport(
+      { "a.so": ["node_api_symbol_for", "napi_create_object"] },
+      FUNCTIONS,
+    );
+    assert.equal(
+      formatExportsList(report),
+      "napi_create_object\nnode_api_symbol_for\n",
+    );
+  });
+});
+
+describe("findLibraries", () => {
+  it("finds ELF and Mach-O binaries, skipping symlinks and other files", () => {
+    const root = fs.mkdtempSync(path.join(os.tmpdir(), "weak-node-api-"));
+    const elf = path.join(root, "addon.android.node", "arm64-v8a", "a.so");
+    const framework = path.join(root, "addon.apple.node", "b.framework");
+    const macho = path.join(framework, "Versions", "A", "b");
+    fs.mkdirSync(path.dirname(elf), { recursive: true });
+    fs.mkdirSync(path.dirname(macho), { recursive: true });
+    fs.writeFileSync(elf, Buffer.from("7f454c4602010100", "hex"));
+    fs.writeFileSync(macho, Buffer.from("cffaedfe0c000001", "hex"));
+    fs.symlinkSync("Versions/A/b", path.join(framework, "b"));
+    fs.writeFileSync(path.join(framework, "Info.plist"), "<plist/>");
+
+    assert.equal(getLibraryFormat(elf), "elf");
+    assert.equal(getLibraryFormat(macho), "mach-o");
+    assert.deepEqual(findLibraries(root), [elf, macho]);
+    assert.deepEqual(findLibraries(elf), [elf]);
+    fs.rmSync(root, { recursive: true });
+  });
+});
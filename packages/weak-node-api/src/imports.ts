@@ -0,0 +1,175 @@
+import fs from "node:fs";
+import path from "node:path";
+import cp from "node:child_process";
+
+import type { FunctionDecl } from "./node-api-functions.js";
+import { weakNodeApiPath } from "./weak-node-api.js";
+
+/** The functions of the host table, in order, written by the generator. */
+export const HOST_TABLE_FILE_NAME = "node-api-functions.json";
+
+export type HostTableFunction = Pick<FunctionDecl, "name" | "version">;
+
+export type LibraryFormat = "elf" | "mach-o";
+
+export type ImportedFunction = {
+  name: string;
+  /** The Node-API version introducing the function. */
+  version: number;
+  /** The libraries importing the function. */
+  importedBy: string[];
+};
+
+export type ImportsReport = {
+  libraries: string[];
+  /** The Node-API functions the libraries import, in host table order. */
+  functions: ImportedFunction[];
+  /**
+   * The oldest Node-API version serving every library: the version to build
+   * a minimal weak-node-api with (WEAK_NODE_API_VERSION).
+   */
+  version: number;
+  /** The slots in a host table sliced at `version`. */
+  tableSize: number;
+  /** The slots in the full host table. */
+  fullTableSize: number;
+};
+
+const MACH_O_MAGICS = new Set([
+  0xfeedface, 0xcefaedfe, 0xfeedfacf, 0xcffaedfe,
+  // Universal ("fat") binaries
+  0xcafebabe, 0xbebafeca,
+]);
+
+/**
+ * The format of the library at `libraryPath`, or null if it is neither an
+ * ELF nor a Mach-O binary.
+ */
+export function getLibraryFormat(libraryPath: string): LibraryFormat | null {
+  const magic = Buffer.alloc(4);
+  const fd = fs.openSync(libraryPath, "r");
+  try {
+    if (fs.readSync(fd, magic, 0, 4, 0) < 4) {
+      return null;
+    }
+  } finally {
+    fs.closeSync(fd);
+  }
+  if (magic.toString("latin1") === "\x7fELF") {
+    return "elf";
+  } else if (MACH_O_MAGICS.has(magic.readUInt32BE(0))) {
+    return "mach-o";
+  } else {
+    return null;
+  }
+}
+
+/**
+ * Finds the libraries in `inputPath`: the path itself if it is one, or every
+ * library below it, e.g. in an .android.node or .apple.node directory.
+ */
+export function findLibraries(inputPath: string): string[] {
+  if (!fs.statSync(inputPath).isDirectory()) {
+    return getLibraryFormat(inputPath) ? [inputPath] : [];
+  }
+  return fs
+    .readdirSync(inputPath, { recursive: true, encoding: "utf8" })
+    .map((entry) => path.join(inputPath, entry))
+    .filter((entry) => {
+      // Skipping the symlinks frameworks point at their binary with
+      const stat = fs.lstatSync(entry);
+      return stat.isFile() && getLibraryFormat(entry) !== null;
+    })
+    .sort();
+}
+
+/**
+ * Parses the output of `nm -u`, listing the undefined symbols of a library.
+ */
+export function parseUndefinedSymbols(
+  output: string,
+  format: LibraryFormat,
+): string[] {
+  const symbols = new Set<string>();
+  for (const line of output.split("\n")) {
+    // Skips the "(for architecture …)" headers of universal binaries
+    const match = line.match(/^\s*(?:U\s+)?([A-Za-z_$][\w$.@]*)\s*$/);
+    if (!match?.[1]) {
+      continue;
+    }
+    // ELF symbols may carry a version ("napi_create_object@VERS_1")
+    const [symbol = ""] = match[1].split("@");
+    // Mach-O prefixes C symbols with an underscore
+    symbols.add(format === "mach-o" ? symbol.replace(/^_/, "") : symbol);
+  }
+  return [...symbols];
+}
+
+/**
+ * The undefined symbols of the library at `libraryPath`, read with `nm` (or
+ * the tool named by the NM environment variable, e.g. the NDK's llvm-nm).
+ */
+export function readUndefinedSymbols(libraryPath: string): string[] {
+  const format = getLibraryFormat(libraryPath);
+  if (!format) {
+    throw new Error(`Not an ELF or Mach-O library: ${libraryPath}`);
+  }
+  const output = cp.execFileSync(
+    process.env.NM ?? "nm",
+    [...(format === "elf" ? ["-D"] : []), "-u", libraryPath],
+    { encoding: "utf8", maxBuffer: 1024 * 1024 * 10 },
+  );
+  return parseUndefinedSymbols(output, format);
+}
+
+/**
+ * The functions of the host table weak-node-api was generated with.
+ */
+export function readHostTableFunctions(): HostTableFunction[] {
+  const tablePath = path.join(
+    weakNodeApiPath,
+    "generated",
+    HOST_TABLE_FILE_NAME,
+  );
+  return JSON.parse(fs.readFileSync(tablePath, "utf8")) as HostTableFunction[];
+}
+
+/**
+ * Reports which of `functions` (in host table order) the libraries import,
+ * given their undefined symbols.
+ */
+export function getImportsReport(
+  undefinedSymbols: Record<string, string[]>,
+  functions: HostTableFunction[],
+): ImportsReport {
+  const importedBy = new Map<string, string[]>();
+  for (const [library, symbols] of Object.entries(undefinedSymbols)) {
+    for (const symbol of symbols) {
+      const libraries = importedBy.get(symbol) ?? [];
+      libraries.push(library);
+      importedBy.set(symbol, libraries);
+    }
+  }
+  const imported = functions
+    .filter(({ name }) => importedBy.has(name))
+    .map(({ name, version }) => ({
+      name,
+      version,
+      importedBy: importedBy.get(name) ?? [],
+    }));
+  const version = Math.max(1, ...imported.map(({ version }) => version));
+  return {
+    libraries: Object.keys(undefinedSymbols),
+    functions: imported,
+    version,
+    tableSize: functions.filter((fn) => fn.version <= version).length,
+    fullTableSize: functions.length,
+  };
+}
+
+/**
+ * The file to pass a minimal weak-node-api build as WEAK_NODE_API_EXPORTS.
+ */
+export function formatExportsList({ functions }: ImportsReport) {
+  return functions.map(({ name }) => `${name}\n`).join("");
+}
@@ -1,2 +1,4 @@
 export * from "./weak-node-api.js";
 export * from "./node-api-functions.js";
+export * from "./imports.js";
+export * from "./host-extensions.js";
@@ -78,12 +78,36 @@ export function getNodeApiHeaderAST(version: NodeApiVersion) {
 
 export type FunctionDecl = {
   name: string;
+  /** The Node-API version introducing the function. */
+  version: number;
   returnType: string;
   noReturn: boolean;
   argumentTypes: string[];
   fallbackReturnStatement: string;
 };
 
+/**
+ * The Node-API version whose symbols first include `name`.
+ */
+function getIntroducingVersion(name: string, upTo: NodeApiVersion) {
+  const last = Number(upTo.replace(/^v/, ""));
+  for (let version = 1; version <= last; version++) {
+    const symbols = nodeApiHeaders.symbols[`v${version}` as NodeApiVersion];
+    if (
+      symbols.js_native_api_symbols.includes(name) ||
+      symbols.node_api_symbols.includes(name)
+    ) {
+      return version;
+    }
+  }
+  throw new Error(`Symbol '${name}' is not part of Node API ${upTo}`);
+}
+
+/**
+ * The functions of Node-API `version`, ordered by the version introducing
+ * them (and by declaration within a version), so that a NodeApiHost table
+ * sliced at an older version is a prefix of the table of a newer one.
+ */
 export function getNodeApiFunctions(version: NodeApiVersion = "v10") {
   const root = getNodeApiHeaderAST(version);
   assert.equal(root.kind, "TranslationUnitDecl");
@@ -130,6 +154,7 @@ export function getNodeApiFunctions(version: NodeApiVersion = "v10") {
 
       nodeApiFunctions.push({
         name,
+        version: getIntroducingVersion(name, version),
         returnType,
         noReturn: node.type.qualType.includes("__attribute__((noreturn))"),
         argumentTypes: argumentTypes
@@ -150,5 +175,6 @@ export function getNodeApiFunctions(version: NodeApiVersion = "v10") {
     }
   }
 
-  return nodeApiFunctions;
+  // Array.prototype.sort is stable, keeping the declaration order per version
+  return nodeApiFunctions.sort((a, b) => a.version - b.version);
 }
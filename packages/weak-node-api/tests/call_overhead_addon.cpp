@@ -0,0 +1,14 @@
+// The loop test_call_overhead.cpp times, built once per way of linking
+// weak-node-api into an addon (see tests/CMakeLists.txt), each exporting it
+// under its own CALL_OVERHEAD_ENTRY name.
+#include <node_api.h>
+
+extern "C" __attribute__((visibility("default"))) int
+CALL_OVERHEAD_ENTRY(napi_env env, int count) {
+  int succeeded = 0;
+  napi_value value = nullptr;
+  for (int i = 0; i < count; i++) {
+    succeeded += napi_get_undefined(env, &value) == napi_ok;
+  }
+  return succeeded;
+}
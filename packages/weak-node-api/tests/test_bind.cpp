@@ -0,0 +1,231 @@
+// Exercises the callbacks of weak_node_api_bind.hpp against injected fakes of
+// Node-API: a JS value is modeled as a FakeValue, and the callback info as
+// the array of a call's arguments.
+#include <catch2/catch_test_macros.hpp>
+#include <weak_node_api.hpp>
+#include <weak_node_api_bind.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <deque>
+#include <string>
+#include <variant>
+#include <vector>
+
+namespace {
+
+using FakeValue = std::variant<std::monostate, double, bool, std::string>;
+
+struct FakeJs {
+  std::deque<FakeValue> values;
+  std::string thrown;
+  bool typeError = false;
+  int calls = 0;
+
+  static FakeJs &instance() {
+    static FakeJs js;
+    return js;
+  }
+
+  static napi_value make(FakeValue value) {
+    auto &values = instance().values;
+    values.push_back(std::move(value));
+    return reinterpret_cast<napi_value>(&values.back());
+  }
+
+  static const FakeValue &of(napi_value value) {
+    return *reinterpret_cast<FakeValue *>(value);
+  }
+};
+
+napi_value undefined() {
+  static FakeValue value;
+  return reinterpret_cast<napi_value>(&value);
+}
+
+void injectFakeJs() {
+  FakeJs::instance() = FakeJs{};
+  inject_weak_node_api_host(NodeApiHost{
+      .napi_get_last_error_info =
+          [](node_api_basic_env,
+             const napi_extended_error_info **result) -> napi_status {
+        static napi_extended_error_info info{"fake failure", nullptr, 0,
+                                             napi_generic_failure};
+        *result = &info;
+        return napi_ok;
+      },
+      .napi_get_boolean = [](napi_env, bool value,
+                             napi_value *result) -> napi_status {
+        *result = FakeJs::make(value);
+        return napi_ok;
+      },
+      .napi_create_double = [](napi_env, double value,
+                               napi_value *result) -> napi_status {
+        *result = FakeJs::make(value);
+        return napi_ok;
+      },
+      .napi_create_int32 = [](napi_env, int32_t value,
+                              napi_value *result) -> napi_status {
+        *result = FakeJs::make(static_cast<double>(value));
+        return napi_ok;
+      },
+      .napi_create_string_utf8 = [](napi_env, const char *str, size_t length,
+                                    napi_value *result) -> napi_status {
+        *result = FakeJs::make(std::string(str, length));
+        return napi_ok;
+      },
+      .napi_get_value_double = [](napi_env, napi_value value,
+                                  double *result) -> napi_status {
+        const auto *number = std::get_if<double>(&FakeJs::of(value));
+        if (number == nullptr) {
+          return napi_number_expected;
+        }
+        *result = *number;
+        return napi_ok;
+      },
+      .napi_get_value_int32 = [](napi_env, napi_value value,
+                                 int32_t *result) -> napi_status {
+        const auto *number = std::get_if<double>(&FakeJs::of(value));
+        if (number == nullptr) {
+          return napi_number_expected;
+        }
+        *result = static_cast<int32_t>(*number);
+        return napi_ok;
+      },
+      .napi_get_value_bool = [](napi_env, napi_value value,
+                                bool *result) -> napi_status {
+        const auto *boolean = std::get_if<bool>(&FakeJs::of(value));
+        if (boolean == nullptr) {
+          return napi_boolean_expected;
+        }
+        *result = *boolean;
+        return napi_ok;
+      },
+      .napi_get_value_string_utf8 = [](napi_env, napi_value value, char *buf,
+                                       size_t bufsize,
+                                       size_t *result) -> napi_status {
+        const auto *string = std::get_if<std::string>(&FakeJs::of(value));
+        if (string == nullptr) {
+          return napi_string_expected;
+        }
+        if (buf == nullptr) {
+          *result = string->size();
+          return napi_ok;
+        }
+        const size_t copied = std::min(string->size(), bufsize - 1);
+        std::memcpy(buf, string->data(), copied);
+        buf[copied] = '\0';
+        *result = copied;
+        return napi_ok;
+      },
+      .napi_get_cb_info = [](napi_env, napi_callback_info info, size_t *argc,
+                             napi_value *argv, napi_value *,
+                             void **) -> napi_status {
+        const auto &args = *reinterpret_cast<std::vector<napi_value> *>(info);
+        for (size_t i = 0; i < *argc; i++) {
+          argv[i] = i < args.size() ? args[i] : undefined();
+        }
+        *argc = args.size();
+        return napi_ok;
+      },
+      .napi_throw_error = [](napi_env, const char *,
+                             const char *msg) -> napi_status {
+        FakeJs::instance().thrown = msg;
+        return napi_ok;
+      },
+      .napi_throw_type_error = [](napi_env, const char *,
+                                  const char *msg) -> napi_status {
+        FakeJs::instance().thrown = msg;
+        FakeJs::instance().typeError = true;
+        return napi_ok;
+      },
+      .napi_is_exception_pending = [](napi_env,
+                                      bool *result) -> napi_status {
+        *result = !FakeJs::instance().thrown.empty();
+        return napi_ok;
+      },
+  });
+}
+
+template <auto Fn> napi_value call(std::vector<napi_value> args) {
+  auto *info = reinterpret_cast<napi_callback_info>(&args);
+  return weak_node_api::callback<Fn>(nullptr, info);
+}
+
+double add(double a, double b) { return a + b; }
+
+std::string greet(const std::string &name, int32_t times) {
+  std::string result;
+  for (int32_t i = 0; i < times; i++) {
+    result += "hi " + name + "!";
+  }
+  return result;
+}
+
+void count() { FakeJs::instance().calls++; }
+
+bool fails(napi_env env, bool fail) {
+  if (fail) {
+    napi_throw_error(env, nullptr, "failed on request");
+  }
+  return !fail;
+}
+
+} // namespace
+
+TEST_CASE("callback converts arguments and results") {
+  injectFakeJs();
+
+  SECTION("numbers") {
+    napi_value result =
+        call<&add>({FakeJs::make(1.5), FakeJs::make(2.25)});
+    CHECK(std::get<double>(FakeJs::of(result)) == 3.75);
+  }
+
+  SECTION("strings") {
+    napi_value result =
+        call<&greet>({FakeJs::make(std::string("you")), FakeJs::make(2.0)});
+    CHECK(std::get<std::string>(FakeJs::of(result)) == "hi you!hi you!");
+  }
+
+  SECTION("no arguments and no result") {
+    CHECK(call<&count>({}) == nullptr);
+    CHECK(FakeJs::instance().calls == 1);
+  }
+
+  SECTION("the env, and exceptions thrown by the function") {
+    napi_value result = call<&fails>({FakeJs::make(false)});
+    CHECK(std::get<bool>(FakeJs::of(result)));
+    call<&fails>({FakeJs::make(true)});
+    CHECK(FakeJs::instance().thrown == "failed on request");
+    CHECK_FALSE(FakeJs::instance().typeError);
+  }
+
+  SECTION("extra arguments are ignored") {
+    napi_value result = call<&add>(
+        {FakeJs::make(1.0), FakeJs::make(2.0), FakeJs::make(true)});
+    CHECK(std::get<double>(FakeJs::of(result)) == 3.0);
+  }
+}
+
+TEST_CASE("callback throws a TypeError for a mismatched argument") {
+  injectFakeJs();
+
+  SECTION("of the wrong type") {
+    CHECK(call<&add>({FakeJs::make(1.0), FakeJs::make(true)}) == nullptr);
+    CHECK(FakeJs::instance().typeError);
+    CHECK(FakeJs::instance().thrown == "Argument 2 must be a number");
+  }
+
+  SECTION("missing") {
+    CHECK(call<&greet>({FakeJs::make(std::string("you"))}) == nullptr);
+    CHECK(FakeJs::instance().thrown == "Argument 2 must be a number");
+  }
+}
+
+TEST_CASE("method describes a bound function") {
+  constexpr napi_property_descriptor descriptor =
+      weak_node_api::method<&add>("add");
+  STATIC_REQUIRE(descriptor.method == &weak_node_api::callback<&add>);
+  CHECK(std::string(descriptor.utf8name) == "add");
+}
@@ -0,0 +1,88 @@
+// Compares the cost of a Node-API call made by an addon linking weak-node-api
+// as a shared library with one linking the weak-node-api-static variant,
+// both built from call_overhead_addon.cpp and calling a host function that
+// does nothing. The static one is injected through the symbol it exports.
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <weak_node_api.hpp>
+
+#include <dlfcn.h>
+
+namespace {
+
+using CallLoop = int (*)(napi_env, int);
+
+constexpr int kCalls = 1000;
+
+int calls = 0;
+
+napi_status getUndefined(napi_env, napi_value *result) {
+  calls++;
+  *result = nullptr;
+  return napi_ok;
+}
+
+const NodeApiHost host{.napi_get_undefined = getUndefined};
+
+struct Addon {
+  void *library;
+  CallLoop loop;
+};
+
+Addon openAddon(const char *path, const char *entry) {
+  void *library = dlopen(path, RTLD_NOW | RTLD_LOCAL);
+  REQUIRE(library != nullptr);
+  auto loop = reinterpret_cast<CallLoop>(dlsym(library, entry));
+  REQUIRE(loop != nullptr);
+  return {library, loop};
+}
+
+Addon sharedAddon() {
+  inject_weak_node_api_host(host);
+  return openAddon(CALL_OVERHEAD_SHARED_PATH, "call_overhead_shared");
+}
+
+Addon staticAddon() {
+  Addon addon = openAddon(CALL_OVERHEAD_STATIC_PATH, "call_overhead_static");
+  auto inject = reinterpret_cast<InjectHostFunction>(
+      dlsym(addon.library, WEAK_NODE_API_STATIC_INJECT_SYMBOL));
+  REQUIRE(inject != nullptr);
+  inject(host);
+  return addon;
+}
+
+} // namespace
+
+TEST_CASE("an addon linking weak-node-api statically calls the host "
+          "injected into it") {
+  Addon addon = staticAddon();
+  calls = 0;
+  CHECK(addon.loop(nullptr, 10) == 10);
+  CHECK(calls == 10);
+  // The trampolines are the addon's own, and hidden.
+  CHECK(dlsym(addon.library, "napi_get_undefined") == nullptr);
+}
+
+// Hidden from the default run; `weak-node-api-tests "[benchmark]"` runs it.
+TEST_CASE("Node-API call overhead", "[.][benchmark]") {
+  const Addon shared = sharedAddon();
+  const Addon statik = staticAddon();
+
+  BENCHMARK("calling the host directly") {
+    napi_status (*volatile function)(napi_env, napi_value *) = getUndefined;
+    int succeeded = 0;
+    napi_value value = nullptr;
+    for (int i = 0; i < kCalls; i++) {
+      succeeded += function(nullptr, &value) == napi_ok;
+    }
+    return succeeded;
+  };
+
+  BENCHMARK("through the shared library") {
+    return shared.loop(nullptr, kCalls);
+  };
+
+  BENCHMARK("through the static variant") {
+    return statik.loop(nullptr, kCalls);
+  };
+}
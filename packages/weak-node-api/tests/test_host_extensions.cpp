@@ -0,0 +1,167 @@
+#include <catch2/catch_test_macros.hpp>
+#include <weak_node_api.hpp>
+#include <weak_node_api_extensions.h>
+
+#include <cmath>
+#include <cstdint>
+#include <map>
+#include <string>
+
+namespace {
+
+// Values are indices into the arguments, offset by one to keep them non-null.
+napi_value fakeValue(uintptr_t value) {
+  return reinterpret_cast<napi_value>(value);
+}
+
+const double kArguments[] = {1.5, 2.5, 3.5};
+const uintptr_t kNotANumber = 0xbad;
+bool passNotANumber = false;
+
+std::map<std::string, double> namedDoubles;
+double arrayBuffer[4];
+
+NodeApiHost fakeHost() {
+  return NodeApiHost{
+      .napi_create_double = [](napi_env, double value,
+                               napi_value *result) -> napi_status {
+        static double created;
+        created = value;
+        *result = reinterpret_cast<napi_value>(&created);
+        return napi_ok;
+      },
+      .napi_get_value_double = [](napi_env, napi_value value,
+                                  double *result) -> napi_status {
+        const auto index = reinterpret_cast<uintptr_t>(value);
+        if (index == kNotANumber) {
+          return napi_number_expected;
+        }
+        *result = kArguments[index - 1];
+        return napi_ok;
+      },
+      .napi_set_named_property = [](napi_env, napi_value, const char *name,
+                                    napi_value value) -> napi_status {
+        namedDoubles[name] = *reinterpret_cast<double *>(value);
+        return napi_ok;
+      },
+      .napi_get_cb_info = [](napi_env, napi_callback_info, size_t *argc,
+                             napi_value *argv, napi_value *,
+                             void **) -> napi_status {
+        for (size_t i = 0; i < *argc && i < std::size(kArguments); i++) {
+          argv[i] = fakeValue(passNotANumber && i == 1 ? kNotANumber : i + 1);
+        }
+        *argc = std::size(kArguments);
+        return napi_ok;
+      },
+      .napi_create_arraybuffer = [](napi_env, size_t byte_length, void **data,
+                                    napi_value *result) -> napi_status {
+        REQUIRE(byte_length <= sizeof(arrayBuffer));
+        *data = arrayBuffer;
+        *result = fakeValue(0x1);
+        return napi_ok;
+      },
+      .napi_create_typedarray = [](napi_env, napi_typedarray_type type,
+                                   size_t length, napi_value arraybuffer,
+                                   size_t byte_offset,
+                                   napi_value *result) -> napi_status {
+        REQUIRE(type == napi_float64_array);
+        REQUIRE(length == 2);
+        REQUIRE(arraybuffer == fakeValue(0x1));
+        REQUIRE(byte_offset == 0);
+        *result = fakeValue(0x2);
+        return napi_ok;
+      },
+  };
+}
+
+} // namespace
+
+TEST_CASE("host extensions fall back to Node-API calls") {
+  inject_weak_node_api_host(fakeHost());
+  inject_weak_node_api_host_extensions(NodeApiHostExtensions{});
+
+  SECTION("node_api_ext_get_cb_doubles") {
+    passNotANumber = false;
+    double argv[4];
+    size_t argc = std::size(argv);
+    REQUIRE(node_api_ext_get_cb_doubles({}, {}, &argc, argv, nullptr) ==
+            napi_ok);
+    CHECK(argc == 3);
+    CHECK(argv[0] == 1.5);
+    CHECK(argv[1] == 2.5);
+    CHECK(argv[2] == 3.5);
+    CHECK(std::isnan(argv[3]));
+
+    argc = 2;
+    REQUIRE(node_api_ext_get_cb_doubles({}, {}, &argc, argv, nullptr) ==
+            napi_ok);
+    CHECK(argc == 3);
+
+    passNotANumber = true;
+    argc = std::size(argv);
+    CHECK(node_api_ext_get_cb_doubles({}, {}, &argc, argv, nullptr) ==
+          napi_number_expected);
+    passNotANumber = false;
+  }
+
+  SECTION("node_api_ext_set_named_doubles") {
+    namedDoubles.clear();
+    const char *const names[] = {"x", "y"};
+    const double values[] = {4.0, -2.0};
+    REQUIRE(node_api_ext_set_named_doubles({}, fakeValue(0x1), 2, names,
+                                           values) == napi_ok);
+    CHECK(namedDoubles == std::map<std::string, double>{{"x", 4.0},
+                                                        {"y", -2.0}});
+  }
+
+  SECTION("node_api_ext_create_float64_array") {
+    const double data[] = {0.25, 0.5};
+    napi_value result;
+    REQUIRE(node_api_ext_create_float64_array({}, data, 2, &result) ==
+            napi_ok);
+    CHECK(result == fakeValue(0x2));
+    CHECK(arrayBuffer[0] == 0.25);
+    CHECK(arrayBuffer[1] == 0.5);
+  }
+}
+
+TEST_CASE("inject_weak_node_api_host_extensions") {
+  inject_weak_node_api_host(fakeHost());
+  static bool called = false;
+  auto get_cb_doubles = [](napi_env, napi_callback_info, size_t *argc,
+                           double *, napi_value *) -> napi_status {
+    called = true;
+    *argc = 0;
+    return napi_ok;
+  };
+
+  SECTION("propagates calls to the host") {
+    called = false;
+    inject_weak_node_api_host_extensions(NodeApiHostExtensions{
+        .version = NODE_API_HOST_EXTENSIONS_VERSION,
+        .node_api_ext_get_cb_doubles = get_cb_doubles,
+    });
+    double argv[1];
+    size_t argc = 1;
+    REQUIRE(node_api_ext_get_cb_doubles({}, {}, &argc, argv, nullptr) ==
+            napi_ok);
+    CHECK(called);
+    CHECK(argc == 0);
+  }
+
+  SECTION("ignores the fields of versions newer than the host's table") {
+    called = false;
+    inject_weak_node_api_host_extensions(NodeApiHostExtensions{
+        .version = 0,
+        .node_api_ext_get_cb_doubles = get_cb_doubles,
+    });
+    double argv[1];
+    size_t argc = 1;
+    REQUIRE(node_api_ext_get_cb_doubles({}, {}, &argc, argv, nullptr) ==
+            napi_ok);
+    CHECK_FALSE(called);
+    CHECK(argc == 3);
+  }
+
+  inject_weak_node_api_host_extensions(NodeApiHostExtensions{});
+}
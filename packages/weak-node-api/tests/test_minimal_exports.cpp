@@ -0,0 +1,48 @@
+// Exercises a minimal weak-node-api (see tests/CMakeLists.txt), exporting
+// only napi_get_undefined, with an addon linking weak-node-api-static, which
+// must still find the host injected into it. Built without linking the full
+// weak-node-api, which the addon would find instead.
+#include <catch2/catch_test_macros.hpp>
+#include <weak_node_api.hpp>
+
+#include <dlfcn.h>
+
+namespace {
+
+using CallLoop = int (*)(napi_env, int);
+
+int calls = 0;
+
+napi_status getUndefined(napi_env, napi_value *result) {
+  calls++;
+  *result = nullptr;
+  return napi_ok;
+}
+
+} // namespace
+
+TEST_CASE("a minimal weak-node-api serves addons linking weak-node-api-static") {
+  void *library = dlopen(WEAK_NODE_API_MINIMAL_PATH, RTLD_NOW | RTLD_LOCAL);
+  REQUIRE(library != nullptr);
+  // Only the listed functions are exported, along with the injection points.
+  CHECK(dlsym(library, "napi_get_undefined") != nullptr);
+  CHECK(dlsym(library, "napi_get_null") == nullptr);
+  CHECK(dlsym(library, WEAK_NODE_API_INJECTED_HOST_SYMBOL) != nullptr);
+  CHECK(dlsym(library, WEAK_NODE_API_INJECTED_HOST_EXTENSIONS_SYMBOL) !=
+        nullptr);
+
+  auto inject = reinterpret_cast<InjectHostFunction>(
+      dlsym(library, "inject_weak_node_api_host"));
+  REQUIRE(inject != nullptr);
+  inject(NodeApiHost{.napi_get_undefined = getUndefined});
+
+  void *addon = dlopen(CALL_OVERHEAD_STATIC_PATH, RTLD_NOW | RTLD_LOCAL);
+  REQUIRE(addon != nullptr);
+  auto loop =
+      reinterpret_cast<CallLoop>(dlsym(addon, "call_overhead_static"));
+  REQUIRE(loop != nullptr);
+  CHECK(loop(nullptr, 10) == 10);
+  CHECK(calls == 10);
+  dlclose(addon);
+  dlclose(library);
+}
@@ -0,0 +1,275 @@
+// Exercises StreamChannel against an injected fake host: the thread-safe
+// function is modeled by a counter of pending calls, which the tests drain
+// on a thread of their choosing to stand in for the JS thread.
+#include <catch2/catch_test_macros.hpp>
+#include <weak_node_api.hpp>
+#include <weak_node_api_stream_channel.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using weak_node_api::StreamChannel;
+
+namespace {
+
+// The state behind the fake Node-API functions, which (being injected as
+// plain function pointers) cannot capture anything.
+struct FakeRuntime {
+  std::byte *buffer = nullptr;
+  napi_finalize bufferFinalizer = nullptr;
+  void *bufferHint = nullptr;
+  int liveReferences = 0;
+  napi_threadsafe_function_call_js callJs = nullptr;
+  void *tsfnContext = nullptr;
+  napi_finalize tsfnFinalizer = nullptr;
+  void *tsfnFinalizeData = nullptr;
+  std::atomic<int> pendingCalls{0};
+  std::atomic<bool> released{false};
+  std::deque<double> numbers;
+  // What JS does with each onDrain(start, count) call.
+  std::function<void(size_t start, size_t count)> onDrain;
+
+  static FakeRuntime &instance() {
+    static FakeRuntime runtime;
+    return runtime;
+  }
+
+  // Runs every queued thread-safe function call, as the JS thread would.
+  // Returns how many ran.
+  int runPendingCalls() {
+    int calls = 0;
+    while (pendingCalls.load() > 0) {
+      pendingCalls--;
+      calls++;
+      callJs(reinterpret_cast<napi_env>(this), reinterpret_cast<napi_value>(1),
+             tsfnContext, nullptr);
+    }
+    return calls;
+  }
+};
+
+void injectFakeRuntime() {
+  auto &runtime = FakeRuntime::instance();
+  runtime.~FakeRuntime();
+  new (&runtime) FakeRuntime();
+  inject_weak_node_api_host(NodeApiHost{
+      .napi_get_undefined = [](napi_env, napi_value *result) -> napi_status {
+        *result = nullptr;
+        return napi_ok;
+      },
+      .napi_create_double = [](napi_env, double value,
+                               napi_value *result) -> napi_status {
+        auto &numbers = FakeRuntime::instance().numbers;
+        numbers.push_back(value);
+        *result = reinterpret_cast<napi_value>(&numbers.back());
+        return napi_ok;
+      },
+      .napi_create_string_utf8 = [](napi_env, const char *, size_t,
+                                    napi_value *result) -> napi_status {
+        *result = reinterpret_cast<napi_value>(2);
+        return napi_ok;
+      },
+      .napi_call_function = [](napi_env, napi_value, napi_value, size_t argc,
+                               const napi_value *argv,
+                               napi_value *) -> napi_status {
+        REQUIRE(argc == 2);
+        const double start = *reinterpret_cast<double *>(argv[0]);
+        const double count = *reinterpret_cast<double *>(argv[1]);
+        FakeRuntime::instance().onDrain(static_cast<size_t>(start),
+                                        static_cast<size_t>(count));
+        return napi_ok;
+      },
+      .napi_create_reference = [](napi_env, napi_value, uint32_t,
+                                  napi_ref *result) -> napi_status {
+        FakeRuntime::instance().liveReferences++;
+        *result = reinterpret_cast<napi_ref>(3);
+        return napi_ok;
+      },
+      .napi_delete_reference = [](napi_env, napi_ref) -> napi_status {
+        FakeRuntime::instance().liveReferences--;
+        return napi_ok;
+      },
+      .napi_create_external_arraybuffer =
+          [](napi_env, void *data, size_t, napi_finalize finalize_cb,
+             void *finalize_hint, napi_value *result) -> napi_status {
+        auto &runtime = FakeRuntime::instance();
+        runtime.buffer = static_cast<std::byte *>(data);
+        runtime.bufferFinalizer = finalize_cb;
+        runtime.bufferHint = finalize_hint;
+        *result = reinterpret_cast<napi_value>(4);
+        return napi_ok;
+      },
+      .napi_create_threadsafe_function =
+          [](napi_env, napi_value, napi_value, napi_value, size_t, size_t,
+             void *thread_finalize_data, napi_finalize thread_finalize_cb,
+             void *context, napi_threadsafe_function_call_js call_js_cb,
+             napi_threadsafe_function *result) -> napi_status {
+        auto &runtime = FakeRuntime::instance();
+        runtime.callJs = call_js_cb;
+        runtime.tsfnContext = context;
+        runtime.tsfnFinalizer = thread_finalize_cb;
+        runtime.tsfnFinalizeData = thread_finalize_data;
+        *result = reinterpret_cast<napi_threadsafe_function>(5);
+        return napi_ok;
+      },
+      .napi_call_threadsafe_function =
+          [](napi_threadsafe_function, void *,
+             napi_threadsafe_function_call_mode) -> napi_status {
+        FakeRuntime::instance().pendingCalls++;
+        return napi_ok;
+      },
+      .napi_release_threadsafe_function =
+          [](napi_threadsafe_function,
+             napi_threadsafe_function_release_mode) -> napi_status {
+        FakeRuntime::instance().released = true;
+        return napi_ok;
+      },
+  });
+}
+
+StreamChannel *createChannel(size_t recordSize, size_t capacity) {
+  StreamChannel *channel = nullptr;
+  napi_value buffer = nullptr;
+  REQUIRE(StreamChannel::create(reinterpret_cast<napi_env>(1),
+                                reinterpret_cast<napi_value>(1), recordSize,
+                                capacity, &channel, &buffer) == napi_ok);
+  return channel;
+}
+
+uint32_t readRecord(size_t slot) {
+  uint32_t value = 0;
+  memcpy(&value, FakeRuntime::instance().buffer + slot * sizeof(value),
+         sizeof(value));
+  return value;
+}
+
+} // namespace
+
+TEST_CASE("StreamChannel coalesces writes into one drain per notification") {
+  injectFakeRuntime();
+  auto &runtime = FakeRuntime::instance();
+  StreamChannel *channel = createChannel(sizeof(uint32_t), 16);
+
+  std::vector<uint32_t> received;
+  runtime.onDrain = [&](size_t start, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+      received.push_back(readRecord((start + i) % 16));
+    }
+  };
+
+  for (uint32_t i = 0; i < 10; i++) {
+    REQUIRE(channel->write(&i, sizeof(i)));
+  }
+  // Ten records, one JS-thread hop.
+  REQUIRE(runtime.pendingCalls.load() == 1);
+  REQUIRE(runtime.runPendingCalls() == 1);
+  REQUIRE(received == std::vector<uint32_t>{0, 1, 2, 3, 4, 5, 6, 7, 8, 9});
+
+  // A drain re-arms the notification.
+  for (uint32_t i = 10; i < 20; i++) {
+    REQUIRE(channel->write(&i, sizeof(i)));
+  }
+  REQUIRE(runtime.runPendingCalls() == 1);
+  REQUIRE(received.size() == 20);
+  REQUIRE(received.back() == 19);
+}
+
+TEST_CASE("StreamChannel rejects writes while full and accepts them again "
+          "once drained") {
+  injectFakeRuntime();
+  auto &runtime = FakeRuntime::instance();
+  // Rounded up to a power of two.
+  StreamChannel *channel = createChannel(sizeof(uint32_t), 3);
+  REQUIRE(channel->capacity() == 4);
+
+  size_t drained = 0;
+  runtime.onDrain = [&](size_t, size_t count) { drained += count; };
+
+  for (uint32_t i = 0; i < 4; i++) {
+    REQUIRE(channel->write(&i, sizeof(i)));
+  }
+  const uint32_t overflow = 4;
+  REQUIRE(!channel->write(&overflow, sizeof(overflow)));
+  // Records larger than the record size are rejected outright.
+  const uint64_t tooLarge = 0;
+  REQUIRE(!channel->write(&tooLarge, sizeof(tooLarge)));
+
+  runtime.runPendingCalls();
+  REQUIRE(drained == 4);
+  REQUIRE(channel->write(&overflow, sizeof(overflow)));
+}
+
+TEST_CASE("StreamChannel delivers every record from concurrent producers, "
+          "in per-producer order") {
+  injectFakeRuntime();
+  auto &runtime = FakeRuntime::instance();
+  constexpr size_t kCapacity = 64;
+  constexpr uint32_t kProducers = 4;
+  constexpr uint32_t kRecordsPerProducer = 20000;
+  StreamChannel *channel = createChannel(sizeof(uint32_t), kCapacity);
+
+  std::vector<uint32_t> nextExpected(kProducers, 0);
+  size_t received = 0;
+  bool ordered = true;
+  runtime.onDrain = [&](size_t start, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+      const uint32_t record = readRecord((start + i) % kCapacity);
+      const uint32_t producer = record >> 24;
+      const uint32_t sequence = record & 0xffffff;
+      ordered = ordered && sequence == nextExpected[producer];
+      nextExpected[producer] = sequence + 1;
+    }
+    received += count;
+  };
+
+  std::vector<std::thread> producers;
+  for (uint32_t producer = 0; producer < kProducers; producer++) {
+    producers.emplace_back([channel, producer] {
+      for (uint32_t sequence = 0; sequence < kRecordsPerProducer;) {
+        const uint32_t record = producer << 24 | sequence;
+        if (channel->write(&record, sizeof(record))) {
+          sequence++;
+        } else {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+  // This thread is the JS thread.
+  while (received < kProducers * kRecordsPerProducer) {
+    if (runtime.runPendingCalls() == 0) {
+      std::this_thread::yield();
+    }
+  }
+  for (auto &producer : producers) {
+    producer.join();
+  }
+  REQUIRE(ordered);
+  REQUIRE(received == kProducers * kRecordsPerProducer);
+}
+
+TEST_CASE("StreamChannel hands the ring to the ArrayBuffer once closed") {
+  injectFakeRuntime();
+  auto &runtime = FakeRuntime::instance();
+  StreamChannel *channel = createChannel(sizeof(uint32_t), 4);
+  // The ring is kept alive for producers, whatever JS does with the buffer.
+  REQUIRE(runtime.liveReferences == 1);
+
+  REQUIRE(channel->close() == napi_ok);
+  REQUIRE(runtime.released.load());
+  const uint32_t record = 1;
+  REQUIRE(!channel->write(&record, sizeof(record)));
+
+  runtime.tsfnFinalizer(reinterpret_cast<napi_env>(1),
+                        runtime.tsfnFinalizeData, nullptr);
+  REQUIRE(runtime.liveReferences == 0);
+  // Collecting the ArrayBuffer frees the channel.
+  runtime.bufferFinalizer(reinterpret_cast<napi_env>(1), runtime.buffer,
+                          runtime.bufferHint);
+}
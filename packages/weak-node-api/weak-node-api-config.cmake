@@ -2,7 +2,7 @@
 # Get the current file directory
 get_filename_component(WEAK_NODE_API_CMAKE_DIR "${CMAKE_CURRENT_LIST_FILE}" DIRECTORY)
 
-if(NOT DEFINED WEAK_NODE_API_LIB)
+if(NOT DEFINED WEAK_NODE_API_LIB AND NOT WEAK_NODE_API_STATIC)
     # Auto-detect library path for Android NDK builds
     if(ANDROID)
         # Define the library path pattern for Android
@@ -27,13 +27,23 @@ if(NOT DEFINED WEAK_NODE_API_LIB)
 endif()
 
 if(NOT DEFINED WEAK_NODE_API_INC)
-    set(WEAK_NODE_API_INC "${WEAK_NODE_API_CMAKE_DIR}/include;${WEAK_NODE_API_CMAKE_DIR}/generated")
+    set(WEAK_NODE_API_INC "${WEAK_NODE_API_CMAKE_DIR}/include;${WEAK_NODE_API_CMAKE_DIR}/generated;${WEAK_NODE_API_CMAKE_DIR}/cpp")
     message(STATUS "Using weak-node-api include directories: ${WEAK_NODE_API_INC}")
 endif()
 
-add_library(weak-node-api SHARED IMPORTED)
+include("${WEAK_NODE_API_CMAKE_DIR}/weak-node-api-static.cmake")
 
-set_target_properties(weak-node-api PROPERTIES
-    IMPORTED_LOCATION "${WEAK_NODE_API_LIB}"
-    INTERFACE_INCLUDE_DIRECTORIES "${WEAK_NODE_API_INC}"
-)
+if(WEAK_NODE_API_STATIC)
+    # Link every addon against the static variant (cmake-rn --weak-node-api-static)
+    target_include_directories(weak-node-api-static INTERFACE ${WEAK_NODE_API_INC})
+    add_library(weak-node-api ALIAS weak-node-api-static)
+else()
+    add_library(weak-node-api SHARED IMPORTED)
+
+    set_target_properties(weak-node-api PROPERTIES
+        IMPORTED_LOCATION "${WEAK_NODE_API_LIB}"
+        INTERFACE_INCLUDE_DIRECTORIES "${WEAK_NODE_API_INC}"
+    )
+endif()
+
+include("${WEAK_NODE_API_CMAKE_DIR}/node-api-bundle.cmake")
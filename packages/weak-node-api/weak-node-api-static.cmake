@@ -0,0 +1,59 @@
+# The weak-node-api-static target: weak-node-api's trampolines as a static
+# library, for an addon to link into its own shared library instead of
+# calling into libweak-node-api across a library boundary.
+#
+# Linked against the shared library, every Node-API call an addon makes goes
+# through a PLT stub into the trampoline, which calls the host through its
+# injected function table. Linked statically, the trampolines are hidden
+# symbols of the addon itself: calls to them are direct, and with
+# CMAKE_INTERPROCEDURAL_OPTIMIZATION enabled the addon's link inlines them,
+# leaving the one indirect call into the host.
+#
+# Each addon then holds its own copy of the table, which its first Node-API
+# call copies from the weak-node-api library the host injected into, even
+# when made from the addon's static initializers (see
+# WEAK_NODE_API_INJECTED_HOST_SYMBOL in weak_node_api.hpp).
+if(TARGET weak-node-api-static)
+  return()
+endif()
+
+add_library(weak-node-api-static STATIC EXCLUDE_FROM_ALL
+  "${CMAKE_CURRENT_LIST_DIR}/generated/weak_node_api.cpp"
+)
+
+target_include_directories(weak-node-api-static
+  PUBLIC
+    "${CMAKE_CURRENT_LIST_DIR}/generated"
+    "${CMAKE_CURRENT_LIST_DIR}/include"
+    "${CMAKE_CURRENT_LIST_DIR}/cpp"
+)
+
+set_target_properties(weak-node-api-static PROPERTIES
+  POSITION_INDEPENDENT_CODE ON
+  CXX_VISIBILITY_PRESET hidden
+  VISIBILITY_INLINES_HIDDEN ON
+)
+
+# node_api.h declares every function with default visibility, which would
+# keep the trampolines exported (and interposable) from the addon: declaring
+# them hidden, for the addon too, lets its calls bind to them directly.
+target_compile_definitions(weak-node-api-static
+  PUBLIC
+    WEAK_NODE_API_STATIC
+    "NAPI_EXTERN=__attribute__((visibility(\"hidden\")))"
+  PRIVATE
+    NAPI_VERSION=10
+)
+
+if(DEFINED WEAK_NODE_API_VERSION)
+  # Sliced like the shared library (see CMakeLists.txt)
+  target_compile_definitions(weak-node-api-static
+    PRIVATE WEAK_NODE_API_VERSION=${WEAK_NODE_API_VERSION}
+  )
+endif()
+
+# Finding the weak-node-api library uses dlopen()
+target_link_libraries(weak-node-api-static PUBLIC ${CMAKE_DL_LIBS})
+
+# C++20 is needed to use designated initializers
+target_compile_features(weak-node-api-static PRIVATE cxx_std_20)